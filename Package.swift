@@ -38,6 +38,24 @@ let package = Package(
             dependencies: ["TerminalUI"]
         ),
 
+        // Render path micro-benchmark
+        .executableTarget(
+            name: "RenderBenchmark",
+            dependencies: ["Cnotcurses"]
+        ),
+
+        // Heap allocation counters for benchmarks
+        .target(
+            name: "CAllocationCounter",
+            publicHeadersPath: "include"
+        ),
+
+        // Frame pipeline benchmarks on a headless terminal
+        .executableTarget(
+            name: "Benchmarks",
+            dependencies: ["TerminalUI", "NotcursesSwift", "CAllocationCounter"]
+        ),
+
         // Tests
         .testTarget(
             name: "NotcursesSwiftTests",
@@ -0,0 +1,142 @@
+import Foundation
+import NotcursesSwift
+import TerminalUI
+
+/// Per-frame measurements of one benchmark, stored without allocating
+/// while frames are being recorded.
+final class FrameRecorder {
+    private(set) var build: [Int64]
+    private(set) var layout: [Int64]
+    private(set) var draw: [Int64]
+    private(set) var flush: [Int64]
+    private(set) var total: [Int64]
+    private(set) var allocations: [Int64]
+    private(set) var allocatedBytes: [Int64]
+    private(set) var bytesEmitted: [Int64]
+
+    init(frames: Int) {
+        func reserved() -> [Int64] {
+            var samples: [Int64] = []
+            samples.reserveCapacity(frames)
+            return samples
+        }
+        build = reserved()
+        layout = reserved()
+        draw = reserved()
+        flush = reserved()
+        total = reserved()
+        allocations = reserved()
+        allocatedBytes = reserved()
+        bytesEmitted = reserved()
+    }
+
+    func record(_ timings: FrameTimings, allocations: Int64, allocatedBytes: Int64, bytesEmitted: Int64) {
+        build.append(timings.build.nanoseconds)
+        layout.append(timings.layout.nanoseconds)
+        draw.append(timings.draw.nanoseconds)
+        flush.append(timings.flush.nanoseconds)
+        total.append(timings.total.nanoseconds)
+        self.allocations.append(allocations)
+        self.allocatedBytes.append(allocatedBytes)
+        self.bytesEmitted.append(bytesEmitted)
+    }
+}
+
+/// Percentiles of one per-frame measurement.
+struct Distribution: Encodable {
+    let p50: Int64
+    let p99: Int64
+    let max: Int64
+    let mean: Double
+
+    init(_ samples: [Int64]) {
+        let sorted = samples.sorted()
+        // Nearest-rank percentile
+        func percentile(_ p: Double) -> Int64 {
+            guard !sorted.isEmpty else { return 0 }
+            let rank = Int((p * Double(sorted.count)).rounded(.up))
+            return sorted[min(Swift.max(rank, 1), sorted.count) - 1]
+        }
+        p50 = percentile(0.50)
+        p99 = percentile(0.99)
+        max = sorted.last ?? 0
+        mean = sorted.isEmpty ? 0 : Double(sorted.reduce(0, +)) / Double(sorted.count)
+    }
+}
+
+/// The result of one benchmark, printed as a single JSON line.
+struct Report: Encodable {
+    struct Stages: Encodable {
+        let build: Distribution
+        let layout: Distribution
+        let draw: Distribution
+        let flush: Distribution
+        let total: Distribution
+    }
+
+    let benchmark: String
+    let configuration: String
+    /// Color encoding of the output: 16, 256 or rgb.
+    let colors: String
+    /// Threads building and laying out the view tree.
+    let threads: Int
+    let rows: Int
+    let cols: Int
+    let frames: Int
+    /// Stage latencies in nanoseconds.
+    let stagesNs: Stages
+    /// Heap allocations per frame; omitted where they cannot be counted.
+    let allocations: Distribution?
+    let allocatedBytes: Distribution?
+    /// Bytes written to the terminal per frame.
+    let bytesEmitted: Distribution
+    /// Drawing groups copied from their raster, and drawn into it, over
+    /// the whole run.
+    let drawingGroupHits: Int
+    let drawingGroupMisses: Int
+
+    init(_ benchmark: Benchmark, colors: ColorSupport, threads: Int, recorder: FrameRecorder,
+         countsAllocations: Bool, drawingGroups: DrawingGroupMetrics) {
+        self.benchmark = benchmark.name
+        #if DEBUG
+        configuration = "debug"
+        #else
+        configuration = "release"
+        #endif
+        switch colors {
+        case .ansi16: self.colors = "16"
+        case .palette256: self.colors = "256"
+        case .trueColor: self.colors = "rgb"
+        }
+        self.threads = threads
+        rows = benchmark.rows
+        cols = benchmark.cols
+        frames = recorder.total.count
+        stagesNs = Stages(build: Distribution(recorder.build),
+                          layout: Distribution(recorder.layout),
+                          draw: Distribution(recorder.draw),
+                          flush: Distribution(recorder.flush),
+                          total: Distribution(recorder.total))
+        allocations = countsAllocations ? Distribution(recorder.allocations) : nil
+        allocatedBytes = countsAllocations ? Distribution(recorder.allocatedBytes) : nil
+        bytesEmitted = Distribution(recorder.bytesEmitted)
+        drawingGroupHits = drawingGroups.hits
+        drawingGroupMisses = drawingGroups.misses
+    }
+
+    /// The report as one line of JSON with snake_case keys.
+    func jsonLine() -> String {
+        let encoder = JSONEncoder()
+        encoder.keyEncodingStrategy = .convertToSnakeCase
+        encoder.outputFormatting = [.sortedKeys]
+        guard let data = try? encoder.encode(self) else { return "{}" }
+        return String(decoding: data, as: UTF8.self)
+    }
+}
+
+extension Duration {
+    var nanoseconds: Int64 {
+        let (seconds, attoseconds) = components
+        return seconds * 1_000_000_000 + attoseconds / 1_000_000_000
+    }
+}
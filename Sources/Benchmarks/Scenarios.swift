@@ -0,0 +1,349 @@
+import Foundation
+import NotcursesSwift
+import TerminalUI
+
+/// A synthetic view run on a headless terminal, with a way to give every
+/// frame new work.
+struct Benchmark {
+    let name: String
+    let rows: Int
+    let cols: Int
+    /// Run the view until the application stops.
+    let run: (Application, Terminal) -> Void
+    /// Invalidate something before frame `frame`.
+    let advance: (_ frame: Int, Terminal) -> Void
+
+    init<V: View>(_ name: String, rows: Int = 50, cols: Int = 160, view: V,
+                  advance: @escaping (_ frame: Int, Terminal) -> Void) {
+        self.name = name
+        self.rows = rows
+        self.cols = cols
+        self.run = { application, terminal in application.run(view, on: terminal) }
+        self.advance = advance
+    }
+
+    /// Every benchmark, each with fresh state.
+    static func all() -> [Benchmark] {
+        [wideHStack(), deepVStack(), longList(), stateChurn(), monitor(), drawingGroup()]
+    }
+}
+
+// MARK: - State handles
+
+/// Collects the `@State` bindings of views as they are built, so a benchmark
+/// can change state from outside the view tree.
+final class StateHandles {
+    // Locked, as bodies may be evaluated on several threads
+    private let lock = NSLock()
+    private var bindings: [Binding<Int>?]
+
+    init(count: Int) {
+        bindings = Array(repeating: nil, count: count)
+    }
+
+    func register(_ binding: Binding<Int>, at index: Int) {
+        lock.withLock { bindings[index] = binding }
+    }
+
+    /// Increment the state at `index`, which invalidates its view.
+    func bump(_ index: Int) {
+        let binding = lock.withLock { bindings[index] }
+        binding?.wrappedValue += 1
+    }
+}
+
+/// A leaf whose text shows its own state.
+struct Ticker: View {
+    let index: Int
+    let handles: StateHandles
+    @State var value = 0
+
+    var body: some View {
+        let _ = handles.register($value, at: index)
+        Text("\(index % 100):\(value % 10)")
+    }
+}
+
+// MARK: - Wide HStack
+
+// 256 text leaves in nested horizontal stacks. The tick changes every
+// leaf, so each frame evaluates, lays out and draws all of them.
+
+struct Octet: View {
+    let base: Int
+    let tick: Int
+
+    var body: some View {
+        HStack(spacing: 0) {
+            Text("\((base + tick) % 10)")
+            Text("\((base + 1 + tick) % 10)")
+            Text("\((base + 2 + tick) % 10)")
+            Text("\((base + 3 + tick) % 10)")
+            Text("\((base + 4 + tick) % 10)")
+            Text("\((base + 5 + tick) % 10)")
+            Text("\((base + 6 + tick) % 10)")
+            Text("\((base + 7 + tick) % 10)")
+        }
+    }
+}
+
+struct Band: View {
+    let base: Int
+    let tick: Int
+
+    var body: some View {
+        HStack(spacing: 0) {
+            Octet(base: base, tick: tick)
+            Octet(base: base + 8, tick: tick)
+            Octet(base: base + 16, tick: tick)
+            Octet(base: base + 24, tick: tick)
+            Octet(base: base + 32, tick: tick)
+            Octet(base: base + 40, tick: tick)
+            Octet(base: base + 48, tick: tick)
+            Octet(base: base + 56, tick: tick)
+        }
+    }
+}
+
+struct WideHStack: View {
+    let handles: StateHandles
+    @State var tick = 0
+
+    var body: some View {
+        let _ = handles.register($tick, at: 0)
+        HStack(spacing: 0) {
+            Band(base: 0, tick: tick)
+            Band(base: 64, tick: tick)
+            Band(base: 128, tick: tick)
+            Band(base: 192, tick: tick)
+        }
+    }
+}
+
+func wideHStack() -> Benchmark {
+    let handles = StateHandles(count: 1)
+    return Benchmark("wide-hstack", rows: 10, cols: 256, view: WideHStack(handles: handles)) { _, _ in
+        handles.bump(0)
+    }
+}
+
+// MARK: - Deep VStack
+
+// 200 nested stacks with a ticker at the bottom; each frame changes only
+// the ticker, so the frame cost is one path through a deep tree.
+
+struct Nest: View {
+    let depth: Int
+    let handles: StateHandles
+
+    var body: some View {
+        VStack(alignment: .leading, spacing: 0) {
+            Text("level \(depth)")
+            if depth > 0 {
+                // Type-erased to break the recursion in the body type
+                AnyView(Nest(depth: depth - 1, handles: handles))
+            } else {
+                Ticker(index: 0, handles: handles)
+            }
+        }
+    }
+}
+
+func deepVStack() -> Benchmark {
+    let handles = StateHandles(count: 1)
+    return Benchmark("deep-vstack", view: Nest(depth: 200, handles: handles)) { _, _ in
+        handles.bump(0)
+    }
+}
+
+// MARK: - Long list
+
+// A 10k-row list paged down one screen per frame, back to the top at the end.
+
+struct LongList: View {
+    let rows: [Int]
+
+    var body: some View {
+        List(rows) { row in
+            HStack(spacing: 2) {
+                Text("\(row)")
+                Text("request-\(row * 17)")
+                Text("GET /api/items/\(row * 31)")
+                Text("200")
+            }
+        }
+    }
+}
+
+func longList() -> Benchmark {
+    let rows = 50
+    let pages = (10_000 + rows - 1) / rows
+    return Benchmark("list-10k", rows: rows, view: LongList(rows: Array(0..<10_000))) { frame, terminal in
+        terminal.inject(frame % pages == 0 ? .home : .pageDown)
+    }
+}
+
+// MARK: - State churn
+
+// 200 tickers, 50 of which change state before every frame.
+
+struct TickerRow: View {
+    let base: Int
+    let handles: StateHandles
+
+    var body: some View {
+        HStack(spacing: 1) {
+            Ticker(index: base, handles: handles)
+            Ticker(index: base + 1, handles: handles)
+            Ticker(index: base + 2, handles: handles)
+            Ticker(index: base + 3, handles: handles)
+            Ticker(index: base + 4, handles: handles)
+            Ticker(index: base + 5, handles: handles)
+            Ticker(index: base + 6, handles: handles)
+            Ticker(index: base + 7, handles: handles)
+        }
+    }
+}
+
+struct TickerBlock: View {
+    let base: Int
+    let handles: StateHandles
+
+    var body: some View {
+        VStack(alignment: .leading, spacing: 0) {
+            TickerRow(base: base, handles: handles)
+            TickerRow(base: base + 8, handles: handles)
+            TickerRow(base: base + 16, handles: handles)
+            TickerRow(base: base + 24, handles: handles)
+            TickerRow(base: base + 32, handles: handles)
+        }
+    }
+}
+
+struct TickerGrid: View {
+    let handles: StateHandles
+
+    var body: some View {
+        VStack(alignment: .leading, spacing: 0) {
+            TickerBlock(base: 0, handles: handles)
+            TickerBlock(base: 40, handles: handles)
+            TickerBlock(base: 80, handles: handles)
+            TickerBlock(base: 120, handles: handles)
+            TickerBlock(base: 160, handles: handles)
+        }
+    }
+}
+
+func stateChurn() -> Benchmark {
+    let tickers = 200
+    let handles = StateHandles(count: tickers)
+    // Fixed-seed LCG, so every run changes the same tickers
+    var seed: UInt64 = 0x2545F4914F6CDD1D
+    return Benchmark("state-churn", rows: 30, cols: 80, view: TickerGrid(handles: handles)) { _, _ in
+        for _ in 0..<50 {
+            seed = seed &* 6364136223846793005 &+ 1442695040888963407
+            handles.bump(Int(seed >> 33) % tickers)
+        }
+    }
+}
+
+// MARK: - Monitor
+
+// A monitoring screen of 16,807 gauges in stacks seven wide and five deep,
+// some 60,000 views in all. Every gauge shows the tick, so each frame
+// evaluates and measures the whole tree; run it with --threads to see how
+// build and layout scale.
+
+struct Gauges: View {
+    let level: Int
+    let base: Int
+    let tick: Int
+
+    var body: some View {
+        if level == 0 {
+            Text("\((base + tick) % 1000)")
+        } else {
+            GaugeStack(level: level, base: base, tick: tick)
+        }
+    }
+}
+
+struct GaugeStack: View {
+    let level: Int
+    let base: Int
+    let tick: Int
+
+    var body: some View {
+        if level.isMultiple(of: 2) {
+            VStack(alignment: .leading, spacing: 0) { gauges }
+        } else {
+            HStack(spacing: 1) { gauges }
+        }
+    }
+
+    @ViewBuilder private var gauges: some View {
+        AnyView(Gauges(level: level - 1, base: base * 7, tick: tick))
+        AnyView(Gauges(level: level - 1, base: base * 7 + 1, tick: tick))
+        AnyView(Gauges(level: level - 1, base: base * 7 + 2, tick: tick))
+        AnyView(Gauges(level: level - 1, base: base * 7 + 3, tick: tick))
+        AnyView(Gauges(level: level - 1, base: base * 7 + 4, tick: tick))
+        AnyView(Gauges(level: level - 1, base: base * 7 + 5, tick: tick))
+        AnyView(Gauges(level: level - 1, base: base * 7 + 6, tick: tick))
+    }
+}
+
+struct Monitor: View {
+    let handles: StateHandles
+    @State var tick = 0
+
+    var body: some View {
+        let _ = handles.register($tick, at: 0)
+        Gauges(level: 5, base: 0, tick: tick)
+    }
+}
+
+func monitor() -> Benchmark {
+    let handles = StateHandles(count: 1)
+    return Benchmark("monitor", view: Monitor(handles: handles)) { _, _ in
+        handles.bump(0)
+    }
+}
+
+// MARK: - Drawing group
+
+// A ticker above 512 text leaves that never change, drawn through a
+// drawing group. Each frame changes only the ticker, so the leaves are
+// copied from the group's raster instead of being drawn.
+
+struct Table: View {
+    var body: some View {
+        VStack(alignment: .leading, spacing: 0) {
+            Band(base: 0, tick: 0)
+            Band(base: 64, tick: 0)
+            Band(base: 128, tick: 0)
+            Band(base: 192, tick: 0)
+            Band(base: 256, tick: 0)
+            Band(base: 320, tick: 0)
+            Band(base: 384, tick: 0)
+            Band(base: 448, tick: 0)
+        }
+    }
+}
+
+struct GroupedTable: View {
+    let handles: StateHandles
+
+    var body: some View {
+        VStack(alignment: .leading, spacing: 0) {
+            Ticker(index: 0, handles: handles)
+            Table().drawingGroup()
+        }
+    }
+}
+
+func drawingGroup() -> Benchmark {
+    let handles = StateHandles(count: 1)
+    return Benchmark("drawing-group", rows: 10, cols: 64, view: GroupedTable(handles: handles)) { _, _ in
+        handles.bump(0)
+    }
+}
@@ -0,0 +1,109 @@
+// Frame pipeline benchmarks.
+//
+//   swift run -c release Benchmarks [--frames N] [--warmup N] [--colors 16|256|rgb]
+//                                   [--threads N,...] [name ...]
+//
+// Runs synthetic view trees on a headless terminal, invalidating state
+// before every frame, and prints one JSON object per benchmark with the
+// p50/p99/max/mean of each per-frame measurement:
+//
+//   stages_ns        build, layout, draw, flush (diff and escape encoding)
+//                    and total, as reported by Application.onFrame
+//   allocations      heap allocations per frame (glibc only)
+//   allocated_bytes  bytes requested by those allocations
+//   bytes_emitted    bytes written to the terminal per frame
+//
+// --colors encodes output for a terminal with that many colors, as
+// detected from TERM and COLORTERM on a real one; the default is rgb.
+// --threads runs every benchmark once per thread count, building and
+// laying out large subtrees on that many threads; the default is 1.
+//
+// Benchmarks:
+//
+//   wide-hstack  256 text leaves in horizontal stacks, all changed per frame
+//   deep-vstack  200 nested stacks, one leaf changed per frame
+//   list-10k     a 10,000-row list paged down one screen per frame
+//   state-churn  200 leaves with @State, 50 of them changed per frame
+//   monitor      16,807 gauges in nested stacks, all changed per frame
+
+import CAllocationCounter
+import Foundation
+import NotcursesSwift
+import TerminalUI
+
+var frames = 500
+var warmup = 20
+var colorSupport = ColorSupport.trueColor
+var threadCounts = [1]
+var selected: [String] = []
+
+var arguments = CommandLine.arguments.dropFirst()
+while let argument = arguments.popFirst() {
+    switch argument {
+    case "--frames":
+        frames = arguments.popFirst().flatMap { Int($0) } ?? frames
+    case "--warmup":
+        warmup = arguments.popFirst().flatMap { Int($0) } ?? warmup
+    case "--colors":
+        switch arguments.popFirst() {
+        case "16": colorSupport = .ansi16
+        case "256": colorSupport = .palette256
+        default: colorSupport = .trueColor
+        }
+    case "--threads":
+        let counts = arguments.popFirst()?.split(separator: ",").compactMap { Int($0) } ?? []
+        threadCounts = counts.isEmpty ? threadCounts : counts.map { max(1, $0) }
+    default:
+        selected.append(argument)
+    }
+}
+
+let countsAllocations = allocation_counter_available()
+
+func measure(_ benchmark: Benchmark, threads: Int) throws -> Report {
+    let terminal = try Terminal(headlessRows: benchmark.rows, cols: benchmark.cols)
+    terminal.colorSupport = colorSupport
+    // Uncapped, so each invalidation renders at once
+    let application = Application(maximumFramesPerSecond: 0, threads: threads)
+    let recorder = FrameRecorder(frames: frames)
+    var frame = 0
+    var allocationsBefore = allocation_count()
+    var bytesBefore = allocation_bytes()
+
+    // Allocations are counted from the end of one frame callback to the end
+    // of the next, which covers the invalidation and the whole frame
+    application.onFrame = { [unowned application] timings in
+        let allocations = Int64(allocation_count() - allocationsBefore)
+        let allocatedBytes = Int64(allocation_bytes() - bytesBefore)
+        let emitted = Int64(terminal.resetStatistics().bytesWritten)
+        terminal.discardOutput()
+
+        if frame >= warmup {
+            recorder.record(timings, allocations: allocations,
+                            allocatedBytes: allocatedBytes, bytesEmitted: emitted)
+        }
+        frame += 1
+        if frame == warmup + frames {
+            application.stop()
+        } else {
+            benchmark.advance(frame, terminal)
+        }
+
+        allocationsBefore = allocation_count()
+        bytesBefore = allocation_bytes()
+    }
+    benchmark.run(application, terminal)
+    return Report(benchmark, colors: colorSupport, threads: threads, recorder: recorder,
+                  countsAllocations: countsAllocations, drawingGroups: application.drawingGroupMetrics)
+}
+
+for threads in threadCounts {
+    for benchmark in Benchmark.all() where selected.isEmpty || selected.contains(benchmark.name) {
+        do {
+            print(try measure(benchmark, threads: threads).jsonLine())
+        } catch {
+            FileHandle.standardError.write(Data("\(benchmark.name): \(error)\n".utf8))
+            exit(1)
+        }
+    }
+}
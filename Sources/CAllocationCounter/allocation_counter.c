@@ -0,0 +1,80 @@
+#include "allocation_counter.h"
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+static _Atomic uint64_t allocations;
+static _Atomic uint64_t bytes;
+
+static inline void count(size_t size) {
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&bytes, size, memory_order_relaxed);
+}
+
+uint64_t allocation_count(void) {
+    return atomic_load_explicit(&allocations, memory_order_relaxed);
+}
+
+uint64_t allocation_bytes(void) {
+    return atomic_load_explicit(&bytes, memory_order_relaxed);
+}
+
+#if defined(__GLIBC__)
+
+// ---------------------------------------------------------------------------
+// The executable's definitions take precedence over libc's for every caller
+// in the process; each forwards to glibc's own implementation.
+// ---------------------------------------------------------------------------
+
+#include <errno.h>
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void* __libc_memalign(size_t alignment, size_t size);
+
+bool allocation_counter_available(void) {
+    return true;
+}
+
+void* malloc(size_t size) {
+    count(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t n, size_t size) {
+    count(n * size);
+    return __libc_calloc(n, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    count(size);
+    return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    count(size);
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    count(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) {
+    if (alignment < sizeof(void*) || (alignment & (alignment - 1))) return EINVAL;
+    count(size);
+    void* ptr = __libc_memalign(alignment, size);
+    if (!ptr && size) return ENOMEM;
+    *out = ptr;
+    return 0;
+}
+
+#else
+
+bool allocation_counter_available(void) {
+    return false;
+}
+
+#endif
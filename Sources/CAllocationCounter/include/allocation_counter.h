@@ -0,0 +1,31 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+// Process-wide heap allocation counters for benchmarks.
+//
+// Linked into an executable on glibc, this target wraps malloc, calloc,
+// realloc and the aligned allocators to count every call and the bytes
+// requested, including allocations made by the Swift runtime.  Elsewhere
+// the counters are unavailable and stay at zero.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Whether allocations are being counted on this platform.
+bool allocation_counter_available(void);
+
+// Allocations made since the process started.
+uint64_t allocation_count(void);
+
+// Bytes requested by those allocations.
+uint64_t allocation_bytes(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ALLOCATION_COUNTER_H
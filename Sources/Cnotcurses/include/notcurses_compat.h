@@ -13,6 +13,7 @@
 // ---------------------------------------------------------------------------
 struct notcurses;
 struct ncplane;
+struct ncmpsc;
 
 // ---------------------------------------------------------------------------
 // Transparent structs — fully defined so Swift can construct them.
@@ -29,13 +30,56 @@ typedef struct ncplane_options {
     unsigned cols;
 } ncplane_options;
 
+typedef struct ncstats {
+    uint64_t renders;         // Frames rendered
+    uint64_t full_repaints;   // Frames that repainted every cell
+    uint64_t cells_diffed;    // Cells compared against the last frame
+    uint64_t cells_emitted;   // Cells written to the terminal
+    uint64_t bytes_written;   // Bytes written to the terminal
+    uint64_t scrolls;         // Frames that moved rows with a scroll region
+    uint64_t frames_dropped;  // Renders skipped while the terminal lagged
+    uint64_t stall_ns;        // Time output waited for the terminal, ns
+} ncstats;
+
+// Color encodings a terminal understands, from fewest colors to most
+typedef enum {
+    NCCOLORS_16,    // SGR 30-37 and 90-97: the ANSI colors
+    NCCOLORS_256,   // SGR 38;5;n: the xterm palette
+    NCCOLORS_RGB,   // SGR 38;2;r;g;b: 24-bit color
+} nccolors_e;
+
+// One run of styled text for ncplane_putspans()
+typedef struct ncspan {
+    int y;              // Plane row and column of the first cell
+    int x;
+    uint32_t fg;        // 0x00RRGGBB, or NCSPAN_DEFAULT_RGB for the
+    uint32_t bg;        // terminal's default color
+    uint32_t styles;    // NCSTYLE_* bits
+    const char* utf8;   // The text, not NUL-terminated
+    size_t len;
+} ncspan;
+
+typedef enum {
+    NCTYPE_UNKNOWN,
+    NCTYPE_PRESS,
+    NCTYPE_REPEAT,
+    NCTYPE_RELEASE,
+} ncintype_e;
+
 typedef struct ncinput {
     uint32_t id;
-    int y;
-    int x;
+    int y;          // Mouse events: cell row and column of the pointer,
+    int x;          // from 0; -1 for other events
     bool shift;
     bool ctrl;
     bool alt;
+    ncintype_e evtype;
+    // NCKEY_PASTE: the pasted text, not NUL-terminated.  Valid until the
+    // next notcurses_get() or notcurses_getvec().  pastetruncated is set
+    // when the text did not all fit and only its start is given.
+    const char* paste;
+    size_t pastelen;
+    bool pastetruncated;
 } ncinput;
 
 // ---------------------------------------------------------------------------
@@ -44,6 +88,13 @@ typedef struct ncinput {
 #define NCOPTION_NO_ALTERNATE_SCREEN  0x0040ull
 #define NCOPTION_SUPPRESS_BANNERS     0x0020ull
 
+// Mouse events for notcurses_mice_enable() (match real notcurses values)
+#define NCMICE_NO_EVENTS     0x0u
+#define NCMICE_MOVE_EVENT    0x1u   // Motion with no button held
+#define NCMICE_BUTTON_EVENT  0x2u   // Presses, releases and the wheel
+#define NCMICE_DRAG_EVENT    0x4u   // Motion with a button held
+#define NCMICE_ALL_EVENTS    0x7u
+
 // ---------------------------------------------------------------------------
 // Style flags (match real notcurses values)
 // ---------------------------------------------------------------------------
@@ -52,6 +103,9 @@ typedef struct ncinput {
 #define NCSTYLE_UNDERLINE  0x0008u
 #define NCSTYLE_STRUCK     0x0200u
 
+// ncspan color meaning the terminal's default
+#define NCSPAN_DEFAULT_RGB 0xFFFFFFFFu
+
 // ---------------------------------------------------------------------------
 // Key constants (supplementary private use area, matching notcurses)
 // ---------------------------------------------------------------------------
@@ -68,9 +122,19 @@ typedef struct ncinput {
 #define NCKEY_PGUP      0x10000au
 #define NCKEY_HOME      0x10000bu
 #define NCKEY_END       0x10000cu
+#define NCKEY_MOTION    0x100064u   // Pointer moved; any held button is lost
+#define NCKEY_BUTTON1   0x100065u   // Mouse buttons 1 through 11
+#define NCKEY_BUTTON2   0x100066u
+#define NCKEY_BUTTON3   0x100067u
+#define NCKEY_BUTTON4   0x100068u
+#define NCKEY_BUTTON5   0x100069u
+#define NCKEY_BUTTON11  0x10006fu
+#define NCKEY_SCROLL_UP   NCKEY_BUTTON4
+#define NCKEY_SCROLL_DOWN NCKEY_BUTTON5
 #define NCKEY_ENTER     0x100079u
 #define NCKEY_ESC       0x100082u
 #define NCKEY_TAB       0x100083u
+#define NCKEY_PASTE     0x100084u   // Bracketed paste; text in ncinput
 
 // ---------------------------------------------------------------------------
 // Shim functions — expose NCKEY_* constants to Swift
@@ -92,6 +156,10 @@ static inline uint32_t nckey_end(void)       { return NCKEY_END; }
 static inline uint32_t nckey_enter(void)     { return NCKEY_ENTER; }
 static inline uint32_t nckey_esc(void)       { return NCKEY_ESC; }
 static inline uint32_t nckey_tab(void)       { return NCKEY_TAB; }
+static inline uint32_t nckey_paste(void)     { return NCKEY_PASTE; }
+static inline uint32_t nckey_motion(void)    { return NCKEY_MOTION; }
+static inline uint32_t nckey_button1(void)   { return NCKEY_BUTTON1; }
+static inline uint32_t nckey_button11(void)  { return NCKEY_BUTTON11; }
 
 // ---------------------------------------------------------------------------
 // Function prototypes
@@ -101,26 +169,157 @@ static inline uint32_t nckey_tab(void)       { return NCKEY_TAB; }
 struct notcurses* notcurses_init(const notcurses_options* opts, FILE* fp);
 int notcurses_stop(struct notcurses* nc);
 int notcurses_render(struct notcurses* nc);
+int notcurses_refresh(struct notcurses* nc);
 struct ncplane* notcurses_stdplane(struct notcurses* nc);
 struct ncplane* notcurses_stddim_yx(struct notcurses* nc,
                                      unsigned* rows, unsigned* cols);
 
-// Input
+// Headless contexts render into memory instead of a terminal.  They have
+// a fixed size, leave termios and signals alone, and read the input queued
+// with notcurses_inject() as if it came from a terminal.
+struct notcurses* notcurses_init_headless(const notcurses_options* opts,
+                                          unsigned rows, unsigned cols);
+// Bytes rendered since the output was last cleared, or NULL for a
+// terminal context.  The pointer is valid only until the next render,
+// which may run on the render thread at any time; use
+// notcurses_output_take() when one may be running.
+const char* notcurses_output(struct notcurses* nc, size_t* len);
+// Detach the bytes rendered since the output was last taken or cleared,
+// leaving it empty, in one step with respect to the render thread.  The
+// caller frees them with free().  NULL with *len 0 when nothing was
+// rendered, or for a terminal context.
+char* notcurses_output_take(struct notcurses* nc, size_t* len);
+void notcurses_output_clear(struct notcurses* nc);
+// Queue raw input bytes, such as "\033[A" for the up arrow.  Returns the
+// number of bytes queued, which is short once the queue is full, or -1
+// for a terminal context.
+int notcurses_inject(struct notcurses* nc, const char* bytes, size_t len);
+
+// Colors.  A terminal context starts with the encoding its environment
+// supports and a headless one with NCCOLORS_RGB.  With fewer colors,
+// every RGB color is written as the nearest palette entry.
+nccolors_e notcurses_colors(const struct notcurses* nc);
+int notcurses_set_colors(struct notcurses* nc, nccolors_e colors);
+// The encoding claimed by the values of TERM and COLORTERM, either of
+// which may be NULL.
+nccolors_e notcurses_detect_colors(const char* term, const char* colorterm);
+
+// Output never blocks.  Bytes the terminal does not take at once are kept
+// and sent as it catches up; a render while any are left is dropped, and
+// the latest state goes out once they are gone, from notcurses_render()
+// or while notcurses_get() waits.  Headless contexts can model a slow
+// link: the sink then takes at most limit bytes until it is cleared
+// (0, the default, means no limit).
+void notcurses_set_output_limit(struct notcurses* nc, size_t limit);
+// At most limit bytes are kept for a terminal that lags.  Output beyond
+// that is lost, and the next render repaints every cell (0, the default,
+// means no limit).
+void notcurses_set_pending_limit(struct notcurses* nc, size_t limit);
+// Bytes waiting for the terminal to take them.
+size_t notcurses_output_pending(const struct notcurses* nc);
+
+// Full repaints of large frames are encoded in horizontal bands on up to
+// threads threads, the calling one included, and written with a single
+// writev().  Each band starts with a cursor move and an SGR reset, so the
+// bytes differ from a single-threaded encoding but not what they show.
+// 1, the default, encodes on the calling thread.  Returns -1 if the
+// threads could not be started, leaving one.
+int notcurses_set_encode_threads(struct notcurses* nc, unsigned threads);
+unsigned notcurses_encode_threads(const struct notcurses* nc);
+
+// Pipelined rendering.  notcurses_render() then copies the composited
+// frame and returns; a render thread diffs, encodes and writes it while
+// the caller builds the next.  A frame the thread has not started on is
+// replaced by the next one, which counts it as dropped.  Calls that read
+// or change output state (statistics, colors, encode threads, headless
+// output) first wait for the frames rendered so far.  Off by default;
+// turning it off writes the last frame and stops the thread.
+int notcurses_set_pipelined(struct notcurses* nc, bool pipelined);
+bool notcurses_pipelined(const struct notcurses* nc);
+
+// Mouse reporting, off until enabled.  Reports use the SGR encoding and
+// arrive as NCKEY_BUTTON* and NCKEY_MOTION input.  Any reporting takes
+// over the terminal's own text selection; NCMICE_MOVE_EVENT also reports
+// every pointer move, so ask for it only when hover matters.  Headless
+// contexts only record the mask.  notcurses_stop() turns reporting off.
+int notcurses_mice_enable(struct notcurses* nc, unsigned eventmask);
+unsigned notcurses_mice_enabled(const struct notcurses* nc);
+static inline int notcurses_mice_disable(struct notcurses* nc) {
+    return notcurses_mice_enable(nc, NCMICE_NO_EVENTS);
+}
+
+// Statistics
+void notcurses_stats(struct notcurses* nc, ncstats* stats);
+void notcurses_stats_reset(struct notcurses* nc, ncstats* stats);
+
+// Wake a thread blocked in notcurses_get(), which then returns 0 as on a
+// timeout.  Safe to call from any thread.
+int notcurses_wake(struct notcurses* nc);
+
+// Input.  Everything the terminal has sent is read at once and decoded
+// into a queue; notcurses_get() returns the next event, waiting up to ts
+// (forever if NULL) when none is queued, and 0 on timeout.
 uint32_t notcurses_get(struct notcurses* nc,
                        const struct timespec* ts, ncinput* ni);
+// Up to vcount queued events, waiting as notcurses_get() does when none
+// is.  Returns how many were stored in ni, 0 on timeout or -1 on error.
+int notcurses_getvec(struct notcurses* nc, const struct timespec* ts,
+                     ncinput* ni, int vcount);
+// How long a lone ESC waits for the rest of an escape sequence before it
+// is taken as the Escape key; 50 ms by default.
+void notcurses_set_escape_delay(struct notcurses* nc, unsigned ms);
+unsigned notcurses_escape_delay(const struct notcurses* nc);
+// At most limit bytes of pasted text are held for the pastes queued (0,
+// the default, means no limit).  A paste that does not fit is cut short.
+void notcurses_set_paste_limit(struct notcurses* nc, size_t limit);
+
+// Lock-free multi-producer, single-consumer queue of opaque pointers.
+// Items must be non-NULL.  Any thread may push; only one thread at a time
+// may pop.
+struct ncmpsc* ncmpsc_create(void);
+void ncmpsc_destroy(struct ncmpsc* q);      // Items still queued are dropped
+int ncmpsc_push(struct ncmpsc* q, void* item);
+void* ncmpsc_pop(struct ncmpsc* q);         // NULL when empty
 
 // Plane operations
 struct ncplane* ncplane_create(struct ncplane* parent,
                                const ncplane_options* opts);
 int ncplane_destroy(struct ncplane* n);
 int ncplane_putstr(struct ncplane* n, const char* s);
+int ncplane_putnstr(struct ncplane* n, size_t len, const char* s);
+// Write every span, clipped to the end of its row, in order.  The cursor
+// and drawing state are unchanged.  Returns the columns written.
+int ncplane_putspans(struct ncplane* n, const ncspan* spans, size_t count);
+int ncplane_fill(struct ncplane* n, int y, int x, unsigned rows, unsigned cols,
+                 const char* egc);
 int ncplane_cursor_move_yx(struct ncplane* n, int y, int x);
 int ncplane_set_fg_rgb(struct ncplane* n, unsigned channel);
 int ncplane_set_bg_rgb(struct ncplane* n, unsigned channel);
 void ncplane_set_styles(struct ncplane* n, unsigned styles);
 void ncplane_off_styles(struct ncplane* n, unsigned styles);
 void ncplane_erase(struct ncplane* n);
+int ncplane_scrollup(struct ncplane* n, int r);
 void ncplane_dim_yx(const struct ncplane* n,
                     unsigned* rows, unsigned* cols);
 
+// Offscreen planes belong to n's context but are never composited; they
+// cannot be moved or restacked.  ncplane_blit() copies all of src onto dst
+// at (y, x), clipped to dst, one row at a time.  The copy is opaque: cells
+// src never wrote blank those beneath.  Returns 0, or -1 on bad arguments.
+struct ncplane* ncplane_create_offscreen(const struct ncplane* n,
+                                         unsigned rows, unsigned cols);
+int ncplane_blit(const struct ncplane* src, struct ncplane* dst, int y, int x);
+
+// Plane position and z-order.  Planes are composited bottom to top,
+// offset from and clipped to their parent; unwritten cells are
+// transparent.
+int ncplane_move_yx(struct ncplane* n, int y, int x);
+void ncplane_yx(const struct ncplane* n, int* y, int* x);
+void ncplane_move_top(struct ncplane* n);
+void ncplane_move_bottom(struct ncplane* n);
+int ncplane_move_above(struct ncplane* n, struct ncplane* target);
+int ncplane_move_below(struct ncplane* n, struct ncplane* target);
+struct ncplane* ncplane_above(struct ncplane* n);
+struct ncplane* ncplane_below(struct ncplane* n);
+
 #endif /* NOTCURSES_COMPAT_H */
@@ -7,11 +7,13 @@
 void nc_plane_init_cells(struct ncplane* n) {
     size_t count = (size_t)n->rows * n->cols;
     n->cells = calloc(count, sizeof(nc_cell));
+    nc_egcpool_clear(&n->pool);
 }
 
 void nc_plane_free_cells(struct ncplane* n) {
     free(n->cells);
     n->cells = NULL;
+    nc_egcpool_free(&n->pool);
 }
 
 // ---------------------------------------------------------------------------
@@ -30,102 +32,504 @@ void nc_get_terminal_size(unsigned* rows, unsigned* cols) {
 }
 
 // ---------------------------------------------------------------------------
-// Render a plane to ANSI output
+// Damage tracking — compare cells by what they look like on screen
 // ---------------------------------------------------------------------------
 
-// Rough upper bound per cell: SGR reset(4) + bold(4) + italic(4) + underline(4)
-// + struck(4) + fg(20) + bg(20) + char(4) = ~64 bytes.  Round up to 80.
-#define BYTES_PER_CELL 80
+static inline bool cell_written(const nc_cell* c) {
+    return c->flags & NC_CELL_WRITTEN;
+}
+
+static inline uint32_t cell_fg(const nc_cell* c) {
+    return cell_written(c) ? c->fg : NC_DEFAULT_RGB;
+}
+
+static inline uint32_t cell_bg(const nc_cell* c) {
+    return cell_written(c) ? c->bg : NC_DEFAULT_RGB;
+}
+
+static inline uint32_t cell_styles(const nc_cell* c) {
+    return cell_written(c) ? c->styles : 0;
+}
+
+// Unwritten and empty cells are presented as a blank.
+static inline const char* cell_glyph(const nc_cell* c, const nc_egcpool* pool,
+                                     size_t* len) {
+    if (cell_written(c) && c->gcluster[0] != '\0') {
+        return nc_cell_egc(c, pool, len);
+    }
+    *len = 1;
+    return " ";
+}
+
+static bool cells_match(const nc_cell* a, const nc_egcpool* apool,
+                        const nc_cell* b, const nc_egcpool* bpool) {
+    // Identical inline cells, the common case, need no decoding
+    if (memcmp(a, b, sizeof(nc_cell)) == 0 &&
+        (unsigned char)a->gcluster[0] != NC_EGC_POOLED) {
+        return true;
+    }
+    if (cell_fg(a) != cell_fg(b) || cell_bg(a) != cell_bg(b) ||
+        cell_styles(a) != cell_styles(b)) {
+        return false;
+    }
+    size_t alen, blen;
+    const char* ag = cell_glyph(a, apool, &alen);
+    const char* bg = cell_glyph(b, bpool, &blen);
+    return alen == blen && memcmp(ag, bg, alen) == 0;
+}
 
-void nc_render_plane(struct notcurses* nc, struct ncplane* n) {
-    FILE* fp = nc->fp;
-    const unsigned rows = n->rows;
-    const unsigned cols = n->cols;
+// ---------------------------------------------------------------------------
+// Compositing — flatten the z-ordered planes into one frame
+// ---------------------------------------------------------------------------
 
-    // Allocate render buffer
-    size_t buf_cap = (size_t)rows * cols * BYTES_PER_CELL + 256;
-    char* buf = malloc(buf_cap);
-    if (!buf) return;
-    size_t pos = 0;
+// Absolute origin of a plane on the screen.
+static void plane_origin(const struct ncplane* n, int* y, int* x) {
+    *y = 0;
+    *x = 0;
+    for (const struct ncplane* p = n; p; p = p->parent) {
+        *y += p->y;
+        *x += p->x;
+    }
+}
 
-    // Helper: append formatted text to buffer
-    #define EMIT(...) do { \
-        pos += (size_t)snprintf(buf + pos, buf_cap - pos, __VA_ARGS__); \
-    } while (0)
+// Visible screen rectangle [top, bottom) x [left, right) of a plane after
+// clipping to every ancestor.  Returns false if nothing is visible.
+static bool plane_clip(const struct ncplane* n, unsigned rows, unsigned cols,
+                       int* top, int* left, int* bottom, int* right) {
+    *top    = 0;
+    *left   = 0;
+    *bottom = (int)rows;
+    *right  = (int)cols;
+    for (const struct ncplane* p = n; p; p = p->parent) {
+        int y, x;
+        plane_origin(p, &y, &x);
+        if (y > *top)  *top  = y;
+        if (x > *left) *left = x;
+        if (y + (int)p->rows < *bottom) *bottom = y + (int)p->rows;
+        if (x + (int)p->cols < *right)  *right  = x + (int)p->cols;
+    }
+    return *top < *bottom && *left < *right;
+}
 
-    EMIT("\033[?25l");   // Hide cursor
-    EMIT("\033[H");      // Home cursor
+// Paint planes bottom to top; unwritten cells are transparent.  With only
+// the standard plane there is nothing to composite and its cells are used
+// directly.  *pool receives the pool the returned cells refer to.
+const nc_cell* nc_composite(struct notcurses* nc, const nc_egcpool** pool) {
+    struct ncplane* std = nc->stdplane;
+    if (nc->bottom == std && nc->top == std) {
+        *pool = &std->pool;
+        return std->cells;
+    }
+    *pool = &nc->framepool;
 
-    uint32_t cur_fg     = 0xFFFFFFFF;  // Sentinel: not set
-    uint32_t cur_bg     = 0xFFFFFFFF;
-    uint32_t cur_styles = 0xFFFFFFFF;
+    const unsigned rows = std->rows;
+    const unsigned cols = std->cols;
+    const size_t count = (size_t)rows * cols;
+    if (nc->framerows != rows || nc->framecols != cols) {
+        free(nc->frame);
+        nc->frame = malloc(count * sizeof(nc_cell));
+        nc->framerows = nc->frame ? rows : 0;
+        nc->framecols = nc->frame ? cols : 0;
+        if (!nc->frame) return NULL;
+    }
+    memset(nc->frame, 0, count * sizeof(nc_cell));
+    nc_egcpool_clear(&nc->framepool);
 
+    for (const struct ncplane* p = nc->bottom; p; p = p->above) {
+        int top, left, bottom, right;
+        if (!plane_clip(p, rows, cols, &top, &left, &bottom, &right)) continue;
+        int oy, ox;
+        plane_origin(p, &oy, &ox);
+        for (int y = top; y < bottom; y++) {
+            const nc_cell* src = &p->cells[(size_t)(y - oy) * p->cols];
+            nc_cell* dst = &nc->frame[(size_t)y * cols];
+            for (int x = left; x < right; x++) {
+                const nc_cell* cell = &src[x - ox];
+                if (cell_written(cell)) {
+                    nc_cell_copy(&dst[x], &nc->framepool, cell, &p->pool);
+                }
+            }
+        }
+    }
+    return nc->frame;
+}
+
+// ---------------------------------------------------------------------------
+// Scroll detection — find rows that moved vertically since the last frame
+//
+// Rows are compared by a hash of what they present.  A run of rows whose
+// hashes equal those of the last frame shifted by k rows can be moved on
+// the terminal with a scroll region instead of being repainted.  The cell
+// diff that follows compares real cells, so a hash collision only costs
+// bytes, never correctness.  Scroll regions span whole rows; content that
+// moves beside something static is repainted as usual.
+// ---------------------------------------------------------------------------
+
+// Least number of repainted rows a scroll has to save
+#define NC_SCROLL_MIN_ROWS 3
+
+static uint64_t row_hash(const nc_cell* row, const nc_egcpool* pool,
+                         unsigned cols) {
+    const uint64_t prime = 0x100000001b3ull;
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (unsigned c = 0; c < cols; c++) {
+        const nc_cell* cell = &row[c];
+        h = (h ^ cell_fg(cell)) * prime;
+        h = (h ^ cell_bg(cell)) * prime;
+        h = (h ^ cell_styles(cell)) * prime;
+        size_t len;
+        const char* g = cell_glyph(cell, pool, &len);
+        for (size_t i = 0; i < len; i++) {
+            h = (h ^ (unsigned char)g[i]) * prime;
+        }
+    }
+    return h;
+}
+
+// Rows [top, bottom) of the new frame equal rows [top + shift, bottom +
+// shift) of the last one.
+typedef struct nc_scroll {
+    int top;
+    int bottom;
+    int shift;
+} nc_scroll;
+
+// Find the shift that saves the most repainted rows.
+static bool find_scroll(const uint64_t* now, const uint64_t* before,
+                        unsigned rows, nc_scroll* best) {
+    unsigned changed = 0;
     for (unsigned r = 0; r < rows; r++) {
-        for (unsigned c = 0; c < cols; c++) {
-            nc_cell* cell = &n->cells[r * cols + c];
-
-            // --- Styles ---
-            uint32_t want_styles = cell->written ? cell->styles : 0;
-            if (want_styles != cur_styles) {
-                EMIT("\033[0m");
-                cur_fg = 0xFFFFFFFF;
-                cur_bg = 0xFFFFFFFF;
-                cur_styles = want_styles;
-                if (cur_styles & NCSTYLE_BOLD)      EMIT("\033[1m");
-                if (cur_styles & NCSTYLE_ITALIC)    EMIT("\033[3m");
-                if (cur_styles & NCSTYLE_UNDERLINE) EMIT("\033[4m");
-                if (cur_styles & NCSTYLE_STRUCK)    EMIT("\033[9m");
+        if (now[r] != before[r]) changed++;
+    }
+    if (changed < NC_SCROLL_MIN_ROWS) return false;
+
+    int saved_best = NC_SCROLL_MIN_ROWS - 1;
+    const int maxshift = (int)rows / 2;
+    for (int k = -maxshift; k <= maxshift; k++) {
+        if (k == 0) continue;
+        const int lo = k < 0 ? -k : 0;
+        const int hi = k > 0 ? (int)rows - k : (int)rows;
+        int start = lo;
+        int saved = 0;
+        for (int r = lo; r <= hi; r++) {
+            if (r < hi && now[r] == before[r + k]) {
+                if (now[r] != before[r]) saved++;
+                continue;
+            }
+            if (saved > saved_best) {
+                saved_best = saved;
+                best->top = start;
+                best->bottom = r;
+                best->shift = k;
             }
+            start = r + 1;
+            saved = 0;
+        }
+    }
+    return saved_best >= NC_SCROLL_MIN_ROWS;
+}
 
-            // --- Foreground ---
-            if (cell->written && cell->fg_set) {
-                if (cell->fg_rgb != cur_fg) {
-                    cur_fg = cell->fg_rgb;
-                    EMIT("\033[38;2;%u;%u;%um",
-                         (cur_fg >> 16) & 0xFF,
-                         (cur_fg >> 8) & 0xFF,
-                         cur_fg & 0xFF);
-                }
-            } else if (cur_fg != 0xFFFFFFFF) {
-                EMIT("\033[39m");   // Default FG
-                cur_fg = 0xFFFFFFFF;
+// Apply a scroll to the front buffer the way the terminal applies it:
+// the moved rows shift and the rows they leave behind become blank.
+static void scroll_lastframe(nc_cell* last, unsigned cols, const nc_scroll* s) {
+    const size_t rowbytes = cols * sizeof(nc_cell);
+    const int count = s->bottom - s->top;
+    memmove(&last[(size_t)s->top * cols],
+            &last[(size_t)(s->top + s->shift) * cols], count * rowbytes);
+    const int exposed = s->shift > 0 ? s->bottom : s->top + s->shift;
+    const int n = s->shift > 0 ? s->shift : -s->shift;
+    memset(&last[(size_t)exposed * cols], 0, n * rowbytes);
+}
+
+// A frame is one synchronized update (DEC mode 2026): terminals that
+// support it show the whole frame at once instead of drawing it as it
+// arrives, and others ignore the mode.  The cursor is hidden while the
+// frame draws and attributes are reset after it.
+#define NC_FRAME_BEGIN "\033[?2026h\033[?25l"
+#define NC_FRAME_END   "\033[0m\033[?25h\033[?2026l"
+
+// ---------------------------------------------------------------------------
+// Encode rows of the composited frame to ANSI output
+//
+// Only cells that differ from the last presented frame are written; the
+// cursor jumps between damaged runs.  In a full repaint every cell is.
+// ---------------------------------------------------------------------------
+
+// A frame being encoded and the frame it is diffed against
+typedef struct nc_frame_src {
+    const nc_cell*     frame;
+    const nc_egcpool*  pool;
+    const nc_cell*     last;       // Unused in a full repaint
+    const nc_egcpool*  lastpool;
+    const nc_palette*  palette;
+    uint64_t*          hashes;     // Row hashes to fill in, or NULL
+    unsigned           cols;
+    bool               full;
+} nc_frame_src;
+
+// Encoder state carried from row to row
+typedef struct nc_encoder {
+    nc_outbuf* out;
+    nc_pen     pen;
+    int        cur_y;     // Terminal cursor; cur_x == cols means a wrap is
+    int        cur_x;     // pending after the last column, -1 unknown
+    uint64_t   emitted;   // Cells written
+    bool       began;     // NC_FRAME_BEGIN has been written
+} nc_encoder;
+
+// Encode rows [top, bottom).  Returns false if the output cannot grow.
+static bool encode_rows(const nc_frame_src* src, nc_encoder* e,
+                        unsigned top, unsigned bottom) {
+    const nc_cell* frame = src->frame;
+    const nc_egcpool* pool = src->pool;
+    const unsigned cols = src->cols;
+    nc_outbuf* out = e->out;
+    int cur_y = e->cur_y;
+    int cur_x = e->cur_x;
+    uint64_t emitted = e->emitted;
+    bool began = e->began;
+
+    for (unsigned r = top; r < bottom; r++) {
+        // Room for a fully damaged row plus the frame prologue/epilogue
+        if (!nc_out_reserve(out, (size_t)cols * NC_CELL_MAX_BYTES + 64)) {
+            return false;
+        }
+        char* p = out->data + out->len;
+
+        for (unsigned c = 0; c < cols; c++) {
+            const size_t idx = (size_t)r * cols + c;
+            const nc_cell* cell = &frame[idx];
+
+            if (!src->full && cells_match(cell, pool, &src->last[idx], src->lastpool)) continue;
+
+            if (!began) {
+                p = nc_encode_lit(p, NC_FRAME_BEGIN, sizeof(NC_FRAME_BEGIN) - 1);
+                began = true;
             }
+            emitted++;
 
-            // --- Background ---
-            if (cell->written && cell->bg_set) {
-                if (cell->bg_rgb != cur_bg) {
-                    cur_bg = cell->bg_rgb;
-                    EMIT("\033[48;2;%u;%u;%um",
-                         (cur_bg >> 16) & 0xFF,
-                         (cur_bg >> 8) & 0xFF,
-                         cur_bg & 0xFF);
+            // --- Cursor ---
+            if (cur_y != (int)r || cur_x != (int)c) {
+                if (c == 0 && cur_y == (int)r - 1 && cur_x == (int)cols) {
+                    p = nc_encode_lit(p, "\r\n", 2);   // Continue on next row
+                } else if (cur_y == (int)r && cur_x >= 0 &&
+                           cur_x < (int)c && cur_x < (int)cols) {
+                    p = nc_encode_cuf(p, c - (unsigned)cur_x);
+                } else {
+                    p = nc_encode_cup(p, r, c);
                 }
-            } else if (cur_bg != 0xFFFFFFFF) {
-                EMIT("\033[49m");   // Default BG
-                cur_bg = 0xFFFFFFFF;
             }
 
+            // --- Styles and colors ---
+            p = nc_encode_sgr(p, &e->pen, cell_styles(cell),
+                              nc_palette_color(src->palette, cell_fg(cell)),
+                              nc_palette_color(src->palette, cell_bg(cell)));
+
             // --- Character ---
-            if (cell->written && cell->gcluster[0] != '\0') {
-                // Copy gcluster bytes directly
-                for (int i = 0; cell->gcluster[i] && i < 7; i++) {
-                    if (pos < buf_cap - 1) buf[pos++] = cell->gcluster[i];
+            size_t len;
+            const char* glyph = cell_glyph(cell, pool, &len);
+            p = nc_encode_lit(p, glyph, len);
+
+            cur_y = (int)r;
+            cur_x = (int)c + 1;
+        }
+        out->len = (size_t)(p - out->data);
+    }
+
+    e->cur_y = cur_y;
+    e->cur_x = cur_x;
+    e->emitted = emitted;
+    e->began = began;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Band encoding — a full repaint of a large frame is cut into horizontal
+// bands encoded on the encoding threads.  Each band starts from an
+// unknown cursor and pen, so its first cell is positioned and its SGR
+// begins with a reset; the bands then join up as one frame.
+// ---------------------------------------------------------------------------
+
+// Least number of cells worth a band of their own
+#define NC_BAND_MIN_CELLS 4096
+
+typedef struct nc_band_job {
+    const nc_frame_src* src;
+    nc_band*            bands;
+    unsigned            rows;
+    unsigned            count;
+} nc_band_job;
+
+static void encode_band(void* arg, unsigned index) {
+    const nc_band_job* job = arg;
+    const nc_frame_src* src = job->src;
+    nc_band* band = &job->bands[index];
+    const unsigned top    = (unsigned)((uint64_t)job->rows * index / job->count);
+    const unsigned bottom = (unsigned)((uint64_t)job->rows * (index + 1) / job->count);
+
+    if (src->hashes) {
+        for (unsigned r = top; r < bottom; r++) {
+            src->hashes[r] = row_hash(&src->frame[(size_t)r * src->cols], src->pool, src->cols);
+        }
+    }
+    band->out.len = 0;
+    nc_encoder e = { .out = &band->out, .cur_y = -1, .cur_x = -1, .began = index > 0 };
+    nc_pen_invalidate(&e.pen);
+    band->ok = encode_rows(src, &e, top, bottom);
+    band->emitted = e.emitted;
+}
+
+// How many bands to cut a full repaint into; 1 encodes it serially.
+static unsigned band_count(const struct notcurses* nc, unsigned rows, unsigned cols) {
+    size_t n = (size_t)rows * cols / NC_BAND_MIN_CELLS;
+    if (n > nc->nbands) n = nc->nbands;
+    if (n > rows) n = rows;
+    return n > 1 ? (unsigned)n : 1;
+}
+
+// Encode a full repaint in bands and write them out with one writev().
+// Returns false if a band's output could not grow.
+static bool render_bands(struct notcurses* nc, const nc_frame_src* src,
+                         unsigned rows, unsigned count,
+                         uint64_t* emitted, size_t* written) {
+    nc_band_job job = { .src = src, .bands = nc->bands, .rows = rows, .count = count };
+    nc_workers_run(nc->encoders, count, encode_band, &job);
+
+    struct iovec iov[NC_ENCODE_THREADS_MAX];
+    *emitted = 0;
+    *written = 0;
+    for (unsigned i = 0; i < count; i++) {
+        nc_band* band = &nc->bands[i];
+        if (!band->ok) return false;
+        if (i == count - 1) {
+            if (!nc_out_reserve(&band->out, sizeof(NC_FRAME_END))) return false;
+            char* p = band->out.data + band->out.len;
+            p = nc_encode_lit(p, NC_FRAME_END, sizeof(NC_FRAME_END) - 1);
+            band->out.len = (size_t)(p - band->out.data);
+        }
+        iov[i].iov_base = band->out.data;
+        iov[i].iov_len  = band->out.len;
+        *emitted += band->emitted;
+        *written += band->out.len;
+    }
+    nc_write_outv(nc, iov, (int)count);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Render a composited frame
+//
+// The first frame, a resize, or notcurses_refresh() repaints everything;
+// other frames are diffed against the last presented one.
+// ---------------------------------------------------------------------------
+
+void nc_render_frame(struct notcurses* nc) {
+    const nc_egcpool* pool;
+    const nc_cell* frame = nc_composite(nc, &pool);
+    if (!frame) return;
+    nc_present(nc, frame, pool, nc->stdplane->rows, nc->stdplane->cols);
+}
+
+// Diff, encode and write a composited frame of rows x cols cells.
+void nc_present(struct notcurses* nc, const nc_cell* frame,
+                const nc_egcpool* pool, unsigned rows, unsigned cols) {
+    const size_t count = (size_t)rows * cols;
+
+    // Decide between a diff against the front buffer and a full repaint
+    bool full = nc->repaint || !nc->lastframe ||
+                nc->lastrows != rows || nc->lastcols != cols;
+    // Cleared before writing, so a write that loses bytes can ask again
+    nc->repaint = false;
+    if (nc->lastrows != rows || nc->lastcols != cols) {
+        free(nc->lastframe);
+        free(nc->framehash);
+        free(nc->lasthash);
+        nc->lastframe = malloc(count * sizeof(nc_cell));
+        nc->framehash = malloc(rows * sizeof(uint64_t));
+        nc->lasthash  = malloc(rows * sizeof(uint64_t));
+        if (!nc->framehash || !nc->lasthash) {
+            free(nc->lastframe);
+            nc->lastframe = NULL;
+        }
+        nc->lastrows  = nc->lastframe ? rows : 0;
+        nc->lastcols  = nc->lastframe ? cols : 0;
+    }
+    nc_cell* last = nc->lastframe;
+
+    nc_frame_src src = {
+        .frame = frame, .pool = pool, .last = last, .lastpool = &nc->lastpool,
+        .palette = &nc->palette, .hashes = last ? nc->framehash : NULL,
+        .cols = cols, .full = full,
+    };
+    uint64_t emitted = 0;
+    size_t written = 0;
+
+    const unsigned bands = full ? band_count(nc, rows, cols) : 1;
+    if (bands > 1) {
+        if (!render_bands(nc, &src, rows, bands, &emitted, &written)) {
+            nc->repaint = true;
+            return;
+        }
+    } else {
+        nc_outbuf* out = &nc->out;
+        out->len = 0;
+        nc_encoder e = { .out = out, .cur_y = -1, .cur_x = -1 };
+        nc_pen_invalidate(&e.pen);
+
+        // Move rows that shifted since the last frame with a scroll region,
+        // then diff against the front buffer as the terminal now shows it
+        if (last) {
+            for (unsigned r = 0; r < rows; r++) {
+                nc->framehash[r] = row_hash(&frame[(size_t)r * cols], pool, cols);
+            }
+            nc_scroll scroll;
+            if (!full && find_scroll(nc->framehash, nc->lasthash, rows, &scroll)) {
+                if (!nc_out_reserve(out, 64)) {
+                    nc->repaint = true;
+                    return;
                 }
-            } else {
-                if (pos < buf_cap - 1) buf[pos++] = ' ';
+                char* p = out->data;
+                p = nc_encode_lit(p, NC_FRAME_BEGIN, sizeof(NC_FRAME_BEGIN) - 1);
+                const int top = scroll.shift > 0 ? scroll.top : scroll.top + scroll.shift;
+                const int bottom = scroll.shift > 0 ? scroll.bottom + scroll.shift : scroll.bottom;
+                p = nc_encode_scroll(p, &e.pen, (unsigned)top, (unsigned)bottom, scroll.shift);
+                out->len = (size_t)(p - out->data);
+                scroll_lastframe(last, cols, &scroll);
+                e.began = true;
+                nc->stats.scrolls++;
             }
         }
-        // Newline between rows (except after the last row)
-        if (r < rows - 1) {
-            EMIT("\r\n");
+
+        if (!encode_rows(&src, &e, 0, rows)) {
+            nc->repaint = true;
+            return;
+        }
+        if (e.began) {
+            char* p = out->data + out->len;
+            p = nc_encode_lit(p, NC_FRAME_END, sizeof(NC_FRAME_END) - 1);
+            out->len = (size_t)(p - out->data);
+            nc_write_out(nc, out->data, out->len);
         }
+        emitted = e.emitted;
+        written = out->len;
     }
 
-    EMIT("\033[0m");     // Reset all attributes
-    EMIT("\033[?25h");   // Show cursor
-    #undef EMIT
+    // The presented frame becomes the baseline for the next diff, unless
+    // some of it never reached the terminal
+    if (nc->lastframe && !nc->repaint) {
+        if (nc_egcpool_copy(&nc->lastpool, pool)) {
+            memcpy(nc->lastframe, frame, count * sizeof(nc_cell));
+            uint64_t* hashes = nc->lasthash;
+            nc->lasthash  = nc->framehash;
+            nc->framehash = hashes;
+        } else {
+            nc->repaint = true;   // Without its clusters it is no baseline
+        }
+    }
 
-    fwrite(buf, 1, pos, fp);
-    fflush(fp);
-    free(buf);
+    nc->stats.renders++;
+    if (full) nc->stats.full_repaints++;
+    else      nc->stats.cells_diffed += count;
+    nc->stats.cells_emitted += emitted;
+    nc->stats.bytes_written += written;
 }
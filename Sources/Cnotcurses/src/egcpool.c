@@ -0,0 +1,166 @@
+#include "internal.h"
+
+// ---------------------------------------------------------------------------
+// Grapheme pool
+// ---------------------------------------------------------------------------
+
+// Offsets are stored in 24 bits
+#define NC_EGCPOOL_MAX (1u << 24)
+
+void nc_egcpool_clear(nc_egcpool* pool) {
+    pool->len = 0;
+}
+
+void nc_egcpool_free(nc_egcpool* pool) {
+    free(pool->data);
+    pool->data = NULL;
+    pool->len  = 0;
+    pool->cap  = 0;
+}
+
+static bool egcpool_reserve(nc_egcpool* pool, size_t extra) {
+    if (pool->cap - pool->len >= extra) return true;
+    if (pool->len + extra > NC_EGCPOOL_MAX) return false;
+    size_t cap = pool->cap ? pool->cap : 256;
+    while (cap - pool->len < extra) cap *= 2;
+    if (cap > NC_EGCPOOL_MAX) cap = NC_EGCPOOL_MAX;
+    char* data = realloc(pool->data, cap);
+    if (!data) return false;
+    pool->data = data;
+    pool->cap  = cap;
+    return true;
+}
+
+// Make dst hold the same clusters at the same offsets as src.
+bool nc_egcpool_copy(nc_egcpool* dst, const nc_egcpool* src) {
+    dst->len = 0;
+    if (!egcpool_reserve(dst, src->len)) return false;
+    if (src->len) memcpy(dst->data, src->data, src->len);
+    dst->len = src->len;
+    return true;
+}
+
+// Append a cluster and return its offset, or -1 when the pool is full.
+static long egcpool_stash(nc_egcpool* pool, const char* egc, size_t len) {
+    if (!egcpool_reserve(pool, len + 1)) return -1;
+    size_t off = pool->len;
+    memcpy(pool->data + off, egc, len);
+    pool->data[off + len] = '\0';
+    pool->len += len + 1;
+    return (long)off;
+}
+
+// ---------------------------------------------------------------------------
+// Cells
+// ---------------------------------------------------------------------------
+
+// Store a cluster in a cell, inline when it fits.  Clusters longer than
+// NC_EGC_MAX are cut at a codepoint boundary.  Returns false if the pool
+// is full; the cell then shows U+FFFD, as it does for a stray 0xFF byte,
+// which would read as the pool marker.
+bool nc_cell_set_egc(nc_cell* c, nc_egcpool* pool, const char* egc, size_t len) {
+    if (len > 0 && (unsigned char)egc[0] == NC_EGC_POOLED) {
+        egc = "\xEF\xBF\xBD";
+        len = 3;
+    }
+    if (len <= NC_EGC_INLINE) {
+        memset(c->gcluster, 0, NC_EGC_INLINE);
+        memcpy(c->gcluster, egc, len);
+        return true;
+    }
+    if (len > NC_EGC_MAX) {
+        len = NC_EGC_MAX;
+        while (len > 0 && ((unsigned char)egc[len] & 0xC0) == 0x80) len--;
+    }
+    long off = egcpool_stash(pool, egc, len);
+    if (off < 0) {
+        memcpy(c->gcluster, "\xEF\xBF\xBD", 4);   // U+FFFD and NUL
+        return false;
+    }
+    c->gcluster[0] = (char)NC_EGC_POOLED;
+    c->gcluster[1] = (char)(off & 0xFF);
+    c->gcluster[2] = (char)((off >> 8) & 0xFF);
+    c->gcluster[3] = (char)((off >> 16) & 0xFF);
+    return true;
+}
+
+// Copy a cell between buffers, moving a pooled cluster into dstpool.
+bool nc_cell_copy(nc_cell* dst, nc_egcpool* dstpool,
+                  const nc_cell* src, const nc_egcpool* srcpool) {
+    *dst = *src;
+    if ((unsigned char)src->gcluster[0] != NC_EGC_POOLED) return true;
+    size_t len;
+    const char* egc = nc_cell_egc(src, srcpool, &len);
+    return nc_cell_set_egc(dst, dstpool, egc, len);
+}
+
+// ---------------------------------------------------------------------------
+// Grapheme segmentation
+//
+// A cluster is a codepoint plus whatever attaches to it: combining marks,
+// variation selectors, emoji modifiers and tags, anything joined by ZWJ,
+// and the second of a pair of regional indicators.  This covers accented
+// text and emoji sequences without carrying the Unicode property tables.
+// ---------------------------------------------------------------------------
+
+// Decode one codepoint from the avail bytes at s; returns its length in
+// bytes, 0 at the end of the string or a NUL.  Malformed and truncated
+// sequences decode as their first byte, one byte long.
+static size_t utf8_decode(const unsigned char* s, size_t avail, uint32_t* cp) {
+    if (avail == 0 || s[0] == 0) return 0;
+    unsigned char b = s[0];
+    size_t len;
+    uint32_t v;
+    if (b < 0x80)      { *cp = b; return 1; }
+    else if (b < 0xC0) { *cp = b; return 1; }
+    else if (b < 0xE0) { len = 2; v = b & 0x1F; }
+    else if (b < 0xF0) { len = 3; v = b & 0x0F; }
+    else               { len = 4; v = b & 0x07; }
+    if (len > avail) { *cp = b; return 1; }
+    for (size_t i = 1; i < len; i++) {
+        if ((s[i] & 0xC0) != 0x80) { *cp = b; return 1; }
+        v = (v << 6) | (s[i] & 0x3F);
+    }
+    *cp = v;
+    return len;
+}
+
+static bool is_extender(uint32_t cp) {
+    return (cp >= 0x0300  && cp <= 0x036F)  ||   // Combining diacritics
+           (cp >= 0x1AB0  && cp <= 0x1AFF)  ||
+           (cp >= 0x1DC0  && cp <= 0x1DFF)  ||
+           (cp >= 0x20D0  && cp <= 0x20FF)  ||   // ... for symbols
+           (cp >= 0xFE20  && cp <= 0xFE2F)  ||   // Half marks
+           (cp >= 0xFE00  && cp <= 0xFE0F)  ||   // Variation selectors
+           (cp >= 0xE0100 && cp <= 0xE01EF) ||
+           (cp >= 0x1F3FB && cp <= 0x1F3FF) ||   // Emoji skin tones
+           (cp >= 0xE0020 && cp <= 0xE007F) ||   // Emoji tags
+           cp == 0x200D;                         // Zero width joiner
+}
+
+static bool is_regional_indicator(uint32_t cp) {
+    return cp >= 0x1F1E6 && cp <= 0x1F1FF;
+}
+
+// Length in bytes of the cluster starting at s, which holds avail bytes.
+size_t nc_egc_length(const unsigned char* s, size_t avail) {
+    uint32_t cp;
+    size_t len = utf8_decode(s, avail, &cp);
+    if (len == 0) return 0;
+    // ASCII followed by ASCII is a cluster on its own
+    if (cp < 0x80 && (avail == 1 || s[1] < 0x80)) return 1;
+
+    uint32_t prev = cp;
+    unsigned indicators = is_regional_indicator(cp) ? 1 : 0;
+    for (;;) {
+        size_t n = utf8_decode(s + len, avail - len, &cp);
+        if (n == 0) break;
+        bool joins = is_extender(cp) || prev == 0x200D ||
+                     (indicators == 1 && is_regional_indicator(cp));
+        if (!joins) break;
+        if (is_regional_indicator(cp)) indicators++;
+        prev = cp;
+        len += n;
+    }
+    return len;
+}
@@ -0,0 +1,257 @@
+#include "internal.h"
+
+// ---------------------------------------------------------------------------
+// Output buffer — grows to the largest frame seen and is then reused
+// ---------------------------------------------------------------------------
+
+bool nc_out_reserve(nc_outbuf* o, size_t extra) {
+    if (o->limit && (extra > o->limit || o->len > o->limit - extra)) return false;
+    if (o->cap - o->len >= extra) return true;
+    size_t cap = o->cap ? o->cap : 4096;
+    while (cap - o->len < extra) cap *= 2;
+    char* data = realloc(o->data, cap);
+    if (!data) return false;
+    o->data = data;
+    o->cap  = cap;
+    return true;
+}
+
+void nc_out_free(nc_outbuf* o) {
+    free(o->data);
+    o->data = NULL;
+    o->len  = 0;
+    o->cap  = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Decimal table for 0–255.  Entries are copied as three bytes and the
+// output pointer advanced by len; the slack is overwritten by what follows.
+// ---------------------------------------------------------------------------
+
+typedef struct nc_decimal {
+    char    s[3];
+    uint8_t len;
+} nc_decimal;
+
+#define D(str) { str, sizeof(str) - 1 }
+static const nc_decimal nc_dec[256] = {
+    D("0"), D("1"), D("2"), D("3"), D("4"), D("5"), D("6"), D("7"),
+    D("8"), D("9"), D("10"), D("11"), D("12"), D("13"), D("14"), D("15"),
+    D("16"), D("17"), D("18"), D("19"), D("20"), D("21"), D("22"), D("23"),
+    D("24"), D("25"), D("26"), D("27"), D("28"), D("29"), D("30"), D("31"),
+    D("32"), D("33"), D("34"), D("35"), D("36"), D("37"), D("38"), D("39"),
+    D("40"), D("41"), D("42"), D("43"), D("44"), D("45"), D("46"), D("47"),
+    D("48"), D("49"), D("50"), D("51"), D("52"), D("53"), D("54"), D("55"),
+    D("56"), D("57"), D("58"), D("59"), D("60"), D("61"), D("62"), D("63"),
+    D("64"), D("65"), D("66"), D("67"), D("68"), D("69"), D("70"), D("71"),
+    D("72"), D("73"), D("74"), D("75"), D("76"), D("77"), D("78"), D("79"),
+    D("80"), D("81"), D("82"), D("83"), D("84"), D("85"), D("86"), D("87"),
+    D("88"), D("89"), D("90"), D("91"), D("92"), D("93"), D("94"), D("95"),
+    D("96"), D("97"), D("98"), D("99"), D("100"), D("101"), D("102"), D("103"),
+    D("104"), D("105"), D("106"), D("107"), D("108"), D("109"), D("110"), D("111"),
+    D("112"), D("113"), D("114"), D("115"), D("116"), D("117"), D("118"), D("119"),
+    D("120"), D("121"), D("122"), D("123"), D("124"), D("125"), D("126"), D("127"),
+    D("128"), D("129"), D("130"), D("131"), D("132"), D("133"), D("134"), D("135"),
+    D("136"), D("137"), D("138"), D("139"), D("140"), D("141"), D("142"), D("143"),
+    D("144"), D("145"), D("146"), D("147"), D("148"), D("149"), D("150"), D("151"),
+    D("152"), D("153"), D("154"), D("155"), D("156"), D("157"), D("158"), D("159"),
+    D("160"), D("161"), D("162"), D("163"), D("164"), D("165"), D("166"), D("167"),
+    D("168"), D("169"), D("170"), D("171"), D("172"), D("173"), D("174"), D("175"),
+    D("176"), D("177"), D("178"), D("179"), D("180"), D("181"), D("182"), D("183"),
+    D("184"), D("185"), D("186"), D("187"), D("188"), D("189"), D("190"), D("191"),
+    D("192"), D("193"), D("194"), D("195"), D("196"), D("197"), D("198"), D("199"),
+    D("200"), D("201"), D("202"), D("203"), D("204"), D("205"), D("206"), D("207"),
+    D("208"), D("209"), D("210"), D("211"), D("212"), D("213"), D("214"), D("215"),
+    D("216"), D("217"), D("218"), D("219"), D("220"), D("221"), D("222"), D("223"),
+    D("224"), D("225"), D("226"), D("227"), D("228"), D("229"), D("230"), D("231"),
+    D("232"), D("233"), D("234"), D("235"), D("236"), D("237"), D("238"), D("239"),
+    D("240"), D("241"), D("242"), D("243"), D("244"), D("245"), D("246"), D("247"),
+    D("248"), D("249"), D("250"), D("251"), D("252"), D("253"), D("254"), D("255"),
+};
+#undef D
+
+static inline char* put_u8(char* p, unsigned v) {
+    memcpy(p, nc_dec[v].s, 3);
+    return p + nc_dec[v].len;
+}
+
+static inline char* put_uint(char* p, unsigned v) {
+    if (v < 256) return put_u8(p, v);
+    char tmp[10];
+    int n = 0;
+    while (v) {
+        tmp[n++] = (char)('0' + v % 10);
+        v /= 10;
+    }
+    while (n) *p++ = tmp[--n];
+    return p;
+}
+
+static inline char* put_rgb(char* p, uint32_t rgb) {
+    p = put_u8(p, (rgb >> 16) & 0xFF);
+    *p++ = ';';
+    p = put_u8(p, (rgb >> 8) & 0xFF);
+    *p++ = ';';
+    return put_u8(p, rgb & 0xFF);
+}
+
+// A color from nc_palette_color(); base is '3' for the foreground and '4'
+// for the background.
+static inline char* put_color(char* p, uint32_t color, char base) {
+    if (color & NC_COLOR_ANSI) {
+        const unsigned i = color & 0xF;
+        if (i < 8) {
+            *p++ = base;
+        } else if (base == '3') {
+            *p++ = '9';
+        } else {
+            *p++ = '1';
+            *p++ = '0';
+        }
+        *p++ = (char)('0' + (i & 7));
+        return p;
+    }
+    *p++ = base;
+    if (color & NC_COLOR_INDEXED) {
+        memcpy(p, "8;5;", 4);
+        return put_u8(p + 4, color & 0xFF);
+    }
+    memcpy(p, "8;2;", 4);
+    return put_rgb(p + 4, color);
+}
+
+// ---------------------------------------------------------------------------
+// Cursor movement
+// ---------------------------------------------------------------------------
+
+// CUP — absolute position, zero-based arguments.
+char* nc_encode_cup(char* p, unsigned y, unsigned x) {
+    *p++ = '\033';
+    *p++ = '[';
+    p = put_uint(p, y + 1);
+    *p++ = ';';
+    p = put_uint(p, x + 1);
+    *p++ = 'H';
+    return p;
+}
+
+// CUF — move right by n columns.
+char* nc_encode_cuf(char* p, unsigned n) {
+    *p++ = '\033';
+    *p++ = '[';
+    p = put_uint(p, n);
+    *p++ = 'C';
+    return p;
+}
+
+// ---------------------------------------------------------------------------
+// Scroll region — move rows [top, bottom) up by shift (down if negative)
+//
+// Attributes are reset first so the exposed rows are blank with the default
+// background, and the margins are restored afterwards, which homes the
+// cursor.  About 30 bytes against a full repaint of every moved row.
+// ---------------------------------------------------------------------------
+
+char* nc_encode_scroll(char* p, nc_pen* pen,
+                       unsigned top, unsigned bottom, int shift) {
+    p = nc_encode_lit(p, "\033[0m\033[", 6);
+    p = put_uint(p, top + 1);
+    *p++ = ';';
+    p = put_uint(p, bottom);
+    *p++ = 'r';
+    *p++ = '\033';
+    *p++ = '[';
+    p = put_uint(p, (unsigned)(shift > 0 ? shift : -shift));
+    *p++ = shift > 0 ? 'S' : 'T';
+    p = nc_encode_lit(p, "\033[r", 3);
+    pen->styles = 0;
+    pen->fg     = NC_DEFAULT_RGB;
+    pen->bg     = NC_DEFAULT_RGB;
+    return p;
+}
+
+// ---------------------------------------------------------------------------
+// SGR — one combined sequence per change, e.g. ESC[0;1;3;38;2;r;g;bm
+// or ESC[0;1;3;38;5;nm
+// ---------------------------------------------------------------------------
+
+void nc_pen_invalidate(nc_pen* pen) {
+    pen->styles = NC_PEN_UNKNOWN;
+    pen->fg     = NC_DEFAULT_RGB;
+    pen->bg     = NC_DEFAULT_RGB;
+}
+
+static inline char* put_styles(char* p, uint32_t styles, bool sep) {
+    if (styles & NCSTYLE_BOLD) {
+        if (sep) *p++ = ';';
+        *p++ = '1';
+        sep = true;
+    }
+    if (styles & NCSTYLE_ITALIC) {
+        if (sep) *p++ = ';';
+        *p++ = '3';
+        sep = true;
+    }
+    if (styles & NCSTYLE_UNDERLINE) {
+        if (sep) *p++ = ';';
+        *p++ = '4';
+        sep = true;
+    }
+    if (styles & NCSTYLE_STRUCK) {
+        if (sep) *p++ = ';';
+        *p++ = '9';
+    }
+    return p;
+}
+
+char* nc_encode_sgr(char* p, nc_pen* pen,
+                    uint32_t styles, uint32_t fg, uint32_t bg) {
+    if (styles == pen->styles && fg == pen->fg && bg == pen->bg) return p;
+
+    *p++ = '\033';
+    *p++ = '[';
+    bool sep = false;
+
+    if (styles != pen->styles) {
+        if (pen->styles != NC_PEN_UNKNOWN &&
+            (styles & pen->styles) == pen->styles) {
+            // Only adding attributes — no reset needed
+            p = put_styles(p, styles & ~pen->styles, false);
+        } else {
+            // Attributes can only be cleared by a reset, which also
+            // returns both colors to the default
+            *p++ = '0';
+            p = put_styles(p, styles, true);
+            pen->fg = NC_DEFAULT_RGB;
+            pen->bg = NC_DEFAULT_RGB;
+        }
+        pen->styles = styles;
+        sep = true;
+    }
+
+    if (fg != pen->fg) {
+        if (sep) *p++ = ';';
+        if (fg == NC_DEFAULT_RGB) {
+            *p++ = '3';
+            *p++ = '9';
+        } else {
+            p = put_color(p, fg, '3');
+        }
+        pen->fg = fg;
+        sep = true;
+    }
+
+    if (bg != pen->bg) {
+        if (sep) *p++ = ';';
+        if (bg == NC_DEFAULT_RGB) {
+            *p++ = '4';
+            *p++ = '9';
+        } else {
+            p = put_color(p, bg, '4');
+        }
+        pen->bg = bg;
+    }
+
+    *p++ = 'm';
+    return p;
+}
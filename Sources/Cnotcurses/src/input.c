@@ -1,6 +1,7 @@
 #include "internal.h"
 #include <sys/select.h>
 #include <errno.h>
+#include <time.h>
 
 // Defined in terminal.c
 extern volatile sig_atomic_t g_resize_flag;
@@ -9,12 +10,12 @@ extern volatile sig_atomic_t g_resize_flag;
 // Helpers
 // ---------------------------------------------------------------------------
 
-// Wait for data on stdin.  Returns 1 if data ready, 0 on timeout, -1 error.
-static int wait_for_input(const struct timespec* ts) {
+// Wait for data on fd, also watching wakefd unless it is -1 and outfd for
+// room to write unless it is -1.  Returns 1 if data is ready, 2 if only
+// outfd is ready, 0 on timeout or wakeup, -1 on error.
+static int wait_for_input(int fd, int wakefd, int outfd, const struct timespec* ts) {
     fd_set fds;
-    FD_ZERO(&fds);
-    FD_SET(STDIN_FILENO, &fds);
-
+    fd_set wfds;
     struct timeval tv;
     struct timeval* tvp = NULL;
     if (ts) {
@@ -22,210 +23,594 @@ static int wait_for_input(const struct timespec* ts) {
         tv.tv_usec = (int)(ts->tv_nsec / 1000);
         tvp = &tv;
     }
+    int maxfd = wakefd > fd ? wakefd : fd;
+    if (outfd > maxfd) maxfd = outfd;
 
     int ret;
     do {
-        ret = select(STDIN_FILENO + 1, &fds, NULL, NULL, tvp);
+        FD_ZERO(&fds);
+        FD_ZERO(&wfds);
+        FD_SET(fd, &fds);
+        if (wakefd >= 0) FD_SET(wakefd, &fds);
+        if (outfd >= 0) FD_SET(outfd, &wfds);
+        ret = select(maxfd + 1, &fds, &wfds, NULL, tvp);
     } while (ret == -1 && errno == EINTR && !g_resize_flag);
+    if (ret <= 0) return ret;
 
-    return ret;
-}
-
-// Try to read one byte from stdin (non-blocking).
-// Returns the byte (0-255) or -1 if nothing available.
-static int read_byte_nonblock(void) {
-    unsigned char ch;
-    ssize_t n = read(STDIN_FILENO, &ch, 1);
-    return (n == 1) ? (int)ch : -1;
-}
-
-// Wait briefly (50 ms) for more bytes — used for ESC disambiguation.
-static int read_byte_brief(void) {
-    struct timespec ts = { .tv_sec = 0, .tv_nsec = 50000000 }; // 50 ms
-    if (wait_for_input(&ts) <= 0) return -1;
-    return read_byte_nonblock();
+    if (FD_ISSET(fd, &fds)) return 1;
+    if (wakefd >= 0 && FD_ISSET(wakefd, &fds)) {
+        // Consume every pending wakeup; they all collapse into this one
+        char drain[64];
+        while (read(wakefd, drain, sizeof(drain)) > 0) {}
+        return 0;
+    }
+    return 2;
 }
 
 // Decode modifier from xterm parameter:  modifier = 1 + (shift?1:0) + (alt?2:0) + (ctrl?4:0)
-static void decode_modifier(int mod, ncinput* ni) {
-    if (!ni) return;
+static void decode_modifier(unsigned mod, ncinput* ni) {
+    if (mod < 2) return;
     mod -= 1;
     ni->shift = (mod & 1) != 0;
     ni->alt   = (mod & 2) != 0;
     ni->ctrl  = (mod & 4) != 0;
 }
 
+// The key for a single byte outside any sequence.
+static uint32_t byte_key(unsigned char b) {
+    switch (b) {
+        case 13: case 10: return NCKEY_ENTER;
+        case 127: case 8: return NCKEY_BACKSPACE;
+        case 9:           return NCKEY_TAB;
+        default:          return b;
+    }
+}
+
 // ---------------------------------------------------------------------------
-// CSI sequence parser:  ESC [ <params> <final>
-// Called after ESC [ has been consumed.
+// Event queue
 // ---------------------------------------------------------------------------
 
-static uint32_t parse_csi(ncinput* ni) {
-    // Read parameter bytes and the final byte.
-    // Parameters are digits and semicolons; final byte is 0x40-0x7E.
-    int params[4] = {0, 0, 0, 0};
-    int nparam = 0;
-    bool have_digit = false;
+static ncinput* push_event(nc_input* in, uint32_t id) {
+    ncinput* ni = &in->queue[(in->head + in->count) & (NC_INQUEUE_SIZE - 1)];
+    memset(ni, 0, sizeof(*ni));
+    ni->id = id;
+    ni->y = -1;
+    ni->x = -1;
+    in->count++;
+    return ni;
+}
 
-    for (;;) {
-        int ch = read_byte_brief();
-        if (ch < 0) return 0;  // Timeout — incomplete sequence
-
-        if (ch >= '0' && ch <= '9') {
-            if (nparam == 0 && !have_digit) nparam = 1;
-            if (nparam <= 4) params[nparam - 1] = params[nparam - 1] * 10 + (ch - '0');
-            have_digit = true;
-        } else if (ch == ';') {
-            if (nparam < 4) nparam++;
-            have_digit = false;
-        } else {
-            // ch is the final byte
-            // Apply modifier if present (param index 1, i.e. second parameter)
-            if (nparam >= 2) decode_modifier(params[1], ni);
-
-            switch (ch) {
-                case 'A': return NCKEY_UP;
-                case 'B': return NCKEY_DOWN;
-                case 'C': return NCKEY_RIGHT;
-                case 'D': return NCKEY_LEFT;
-                case 'H': return NCKEY_HOME;
-                case 'F': return NCKEY_END;
-                case '~':
-                    // Tilde sequences: number ~ (e.g. ESC[2~)
-                    switch (params[0]) {
-                        case 2: return NCKEY_INS;
-                        case 3: return NCKEY_DEL;
-                        case 5: return NCKEY_PGUP;
-                        case 6: return NCKEY_PGDOWN;
-                        default: return 0;
-                    }
-                default:
-                    return 0;  // Unknown CSI
-            }
-        }
+static void pop_event(nc_input* in, ncinput* ni) {
+    const unsigned i = in->head;
+    if (ni) {
+        *ni = in->queue[i];
+        if (ni->id == NCKEY_PASTE) ni->paste = in->paste.data + in->pasteoff[i];
     }
+    in->head = (i + 1) & (NC_INQUEUE_SIZE - 1);
+    in->count--;
 }
 
 // ---------------------------------------------------------------------------
-// SS3 sequence parser:  ESC O <char>
+// Decoder — a resumable state machine, so a sequence split across reads
+// continues where it stopped.  Each byte falls in a class; the action for
+// (state, class) comes from a table.
 // ---------------------------------------------------------------------------
 
-static uint32_t parse_ss3(void) {
-    int ch = read_byte_brief();
-    if (ch < 0) return 0;
-    switch (ch) {
-        case 'A': return NCKEY_UP;
-        case 'B': return NCKEY_DOWN;
-        case 'C': return NCKEY_RIGHT;
-        case 'D': return NCKEY_LEFT;
-        case 'H': return NCKEY_HOME;
-        case 'F': return NCKEY_END;
-        default:  return 0;
+enum {
+    S_GROUND,
+    S_ESC,      // After ESC
+    S_CSI,      // After ESC [
+    S_SS3,      // After ESC O
+    S_UTF8,     // Inside a multibyte character
+    S_PASTE,    // Inside a bracketed paste; not table-driven
+    NSTATES = S_PASTE,
+};
+
+enum {
+    C_CTRL,     // C0 controls other than ESC
+    C_ESC,
+    C_INTER,    // Space and !"#$%&'()*+,-./
+    C_DIGIT,
+    C_SEP,      // : ;
+    C_PRIV,     // < = > ?
+    C_LBRACKET, // [
+    C_O,        // O
+    C_FINAL,    // Other @ through ~
+    C_DEL,
+    C_CONT,     // UTF-8 continuation byte
+    C_LEAD2,    // UTF-8 lead bytes
+    C_LEAD3,
+    C_LEAD4,
+    C_BAD,      // Never valid in UTF-8
+    NCLASSES,
+};
+
+static const uint8_t byte_class[256] = {
+    [0x00 ... 0x1A] = C_CTRL,
+    [0x1B]          = C_ESC,
+    [0x1C ... 0x1F] = C_CTRL,
+    [0x20 ... 0x2F] = C_INTER,
+    [0x30 ... 0x39] = C_DIGIT,
+    [0x3A ... 0x3B] = C_SEP,
+    [0x3C ... 0x3F] = C_PRIV,
+    [0x40 ... 0x4E] = C_FINAL,
+    ['O']           = C_O,
+    [0x50 ... 0x5A] = C_FINAL,
+    ['[']           = C_LBRACKET,
+    [0x5C ... 0x7E] = C_FINAL,
+    [0x7F]          = C_DEL,
+    [0x80 ... 0xBF] = C_CONT,
+    [0xC0 ... 0xC1] = C_BAD,
+    [0xC2 ... 0xDF] = C_LEAD2,
+    [0xE0 ... 0xEF] = C_LEAD3,
+    [0xF0 ... 0xF4] = C_LEAD4,
+    [0xF5 ... 0xFF] = C_BAD,
+};
+
+enum {
+    A_KEY,        // Emit the byte's key
+    A_ALT,        // Emit the byte's key with Alt
+    A_ESC,        // Start an escape sequence
+    A_ESC_ESC,    // Emit Escape; the second ESC starts a new sequence
+    A_CSI,
+    A_SS3,
+    A_PARAM,      // Accumulate a CSI parameter digit
+    A_SEP,        // Next CSI parameter
+    A_PRIV,       // CSI private marker
+    A_CSI_END,
+    A_SS3_END,
+    A_UTF8,       // Start a multibyte character
+    A_UTF8_CONT,
+    A_UTF8_ABORT, // Emit NCKEY_INVALID, then decode the byte afresh
+    A_INVALID,    // Emit NCKEY_INVALID
+    A_IGNORE,     // Drop the byte, keep the state
+    A_DROP,       // Drop the sequence so far
+};
+
+static const uint8_t actions[NSTATES][NCLASSES] = {
+    [S_GROUND] = {
+        [C_CTRL] = A_KEY, [C_ESC] = A_ESC, [C_INTER] = A_KEY,
+        [C_DIGIT] = A_KEY, [C_SEP] = A_KEY, [C_PRIV] = A_KEY,
+        [C_LBRACKET] = A_KEY, [C_O] = A_KEY, [C_FINAL] = A_KEY,
+        [C_DEL] = A_KEY, [C_CONT] = A_INVALID, [C_LEAD2] = A_UTF8,
+        [C_LEAD3] = A_UTF8, [C_LEAD4] = A_UTF8, [C_BAD] = A_INVALID,
+    },
+    [S_ESC] = {
+        [C_CTRL] = A_ALT, [C_ESC] = A_ESC_ESC, [C_INTER] = A_ALT,
+        [C_DIGIT] = A_ALT, [C_SEP] = A_ALT, [C_PRIV] = A_ALT,
+        [C_LBRACKET] = A_CSI, [C_O] = A_SS3, [C_FINAL] = A_ALT,
+        [C_DEL] = A_ALT, [C_CONT] = A_INVALID, [C_LEAD2] = A_UTF8,
+        [C_LEAD3] = A_UTF8, [C_LEAD4] = A_UTF8, [C_BAD] = A_INVALID,
+    },
+    [S_CSI] = {
+        [C_CTRL] = A_IGNORE, [C_ESC] = A_ESC, [C_INTER] = A_IGNORE,
+        [C_DIGIT] = A_PARAM, [C_SEP] = A_SEP, [C_PRIV] = A_PRIV,
+        [C_LBRACKET] = A_CSI_END, [C_O] = A_CSI_END, [C_FINAL] = A_CSI_END,
+        [C_DEL] = A_IGNORE, [C_CONT] = A_DROP, [C_LEAD2] = A_DROP,
+        [C_LEAD3] = A_DROP, [C_LEAD4] = A_DROP, [C_BAD] = A_DROP,
+    },
+    [S_SS3] = {
+        [C_CTRL] = A_DROP, [C_ESC] = A_ESC, [C_INTER] = A_DROP,
+        [C_DIGIT] = A_PARAM, [C_SEP] = A_DROP, [C_PRIV] = A_DROP,
+        [C_LBRACKET] = A_SS3_END, [C_O] = A_SS3_END, [C_FINAL] = A_SS3_END,
+        [C_DEL] = A_DROP, [C_CONT] = A_DROP, [C_LEAD2] = A_DROP,
+        [C_LEAD3] = A_DROP, [C_LEAD4] = A_DROP, [C_BAD] = A_DROP,
+    },
+    [S_UTF8] = {
+        [C_CTRL] = A_UTF8_ABORT, [C_ESC] = A_UTF8_ABORT, [C_INTER] = A_UTF8_ABORT,
+        [C_DIGIT] = A_UTF8_ABORT, [C_SEP] = A_UTF8_ABORT, [C_PRIV] = A_UTF8_ABORT,
+        [C_LBRACKET] = A_UTF8_ABORT, [C_O] = A_UTF8_ABORT, [C_FINAL] = A_UTF8_ABORT,
+        [C_DEL] = A_UTF8_ABORT, [C_CONT] = A_UTF8_CONT, [C_LEAD2] = A_UTF8_ABORT,
+        [C_LEAD3] = A_UTF8_ABORT, [C_LEAD4] = A_UTF8_ABORT, [C_BAD] = A_UTF8_ABORT,
+    },
+};
+
+static const char paste_end[] = "\033[201~";
+#define PASTE_END_LEN (sizeof(paste_end) - 1)
+
+// SGR (mode 1006) mouse report: ESC [ < button ; x ; y M on press and
+// motion, m on release.  The button code carries the button in its low
+// bits, modifiers in 4/8/16, motion in 32, wheel in 64 and buttons 8-11
+// in 128.  Coordinates count from 1.
+static void mouse_end(nc_input* in, unsigned char final) {
+    const unsigned* params = in->params;
+    in->state = S_GROUND;
+    if (in->nparam != 3 || (final != 'M' && final != 'm')) return;
+    const unsigned code = params[0];
+    const unsigned low = code & 3;
+    uint32_t key;
+    if (code & 32) {
+        key = NCKEY_MOTION;
+    } else if (code & 64) {
+        key = NCKEY_BUTTON4 + low;
+    } else if (code & 128) {
+        key = NCKEY_BUTTON1 + 7 + low;
+    } else if (low < 3) {
+        key = NCKEY_BUTTON1 + low;
+    } else {
+        return;   // Release with no button, from the legacy encoding only
     }
+    ncinput* ni = push_event(in, key);
+    ni->x = params[1] ? (int)params[1] - 1 : 0;
+    ni->y = params[2] ? (int)params[2] - 1 : 0;
+    ni->shift = (code & 4) != 0;
+    ni->alt   = (code & 8) != 0;
+    ni->ctrl  = (code & 16) != 0;
+    ni->evtype = final == 'm' ? NCTYPE_RELEASE : NCTYPE_PRESS;
 }
 
-// ---------------------------------------------------------------------------
-// Read a single UTF-8 codepoint from stdin (first byte already read).
-// ---------------------------------------------------------------------------
+// ESC [ <params> <final>
+static void csi_end(nc_input* in, unsigned char final) {
+    const unsigned* params = in->params;
+    uint32_t key = 0;
+    if (in->priv == '<') {
+        mouse_end(in, final);
+        return;
+    } else if (in->priv) {
+        // Other private sequences (mode replies) are not keys
+    } else if (final == '~') {
+        switch (params[0]) {
+            case 1: case 7: key = NCKEY_HOME; break;
+            case 2:         key = NCKEY_INS; break;
+            case 3:         key = NCKEY_DEL; break;
+            case 4: case 8: key = NCKEY_END; break;
+            case 5:         key = NCKEY_PGUP; break;
+            case 6:         key = NCKEY_PGDOWN; break;
+            case 200:
+                in->state = S_PASTE;
+                in->pastestart = in->paste.len;
+                in->pastematch = 0;
+                in->pastecut   = false;
+                return;
+            default: break;
+        }
+    } else {
+        switch (final) {
+            case 'A': key = NCKEY_UP; break;
+            case 'B': key = NCKEY_DOWN; break;
+            case 'C': key = NCKEY_RIGHT; break;
+            case 'D': key = NCKEY_LEFT; break;
+            case 'H': key = NCKEY_HOME; break;
+            case 'F': key = NCKEY_END; break;
+            case 'Z': key = NCKEY_TAB; break;   // Shift-Tab
+            default: break;
+        }
+    }
+    in->state = S_GROUND;
+    if (!key) return;   // Unknown sequences are dropped
+    ncinput* ni = push_event(in, key);
+    if (in->nparam >= 2) decode_modifier(params[1], ni);
+    if (final == 'Z') ni->shift = true;
+}
+
+// ESC O <final>
+static void ss3_end(nc_input* in, unsigned char final) {
+    uint32_t key = 0;
+    switch (final) {
+        case 'A': key = NCKEY_UP; break;
+        case 'B': key = NCKEY_DOWN; break;
+        case 'C': key = NCKEY_RIGHT; break;
+        case 'D': key = NCKEY_LEFT; break;
+        case 'H': key = NCKEY_HOME; break;
+        case 'F': key = NCKEY_END; break;
+        case 'M': key = NCKEY_ENTER; break;  // Keypad Enter
+        default: break;
+    }
+    in->state = S_GROUND;
+    if (!key) return;
+    ncinput* ni = push_event(in, key);
+    if (in->nparam >= 1) decode_modifier(in->params[0], ni);
+}
 
-static uint32_t read_utf8(int first_byte) {
-    uint32_t cp;
-    int remaining;
+// Once text that does not fit is lost, the rest of the paste is dropped
+// too: the event carries the start of the paste, not one with holes in it.
+static void paste_append(nc_input* in, const void* data, size_t len) {
+    if (in->pastecut) return;
+    if (!nc_out_reserve(&in->paste, len)) {
+        in->pastecut = true;
+        // Under a limit, keep what fits, up to the last whole character
+        const nc_outbuf* p = &in->paste;
+        size_t room = p->limit > p->len ? p->limit - p->len : 0;
+        if (room >= len) return;
+        while (room && (((const unsigned char*)data)[room] & 0xC0) == 0x80) room--;
+        if (!room || !nc_out_reserve(&in->paste, room)) return;
+        len = room;
+    }
+    memcpy(in->paste.data + in->paste.len, data, len);
+    in->paste.len += len;
+}
 
-    if (first_byte < 0xE0) {
-        cp = (uint32_t)(first_byte & 0x1F);
-        remaining = 1;
-    } else if (first_byte < 0xF0) {
-        cp = (uint32_t)(first_byte & 0x0F);
-        remaining = 2;
-    } else {
-        cp = (uint32_t)(first_byte & 0x07);
-        remaining = 3;
+// Copy paste text until the end marker, a chunk at a time.  Returns the
+// bytes consumed.
+static size_t decode_paste(nc_input* in, const unsigned char* p, size_t n) {
+    size_t i = 0;
+    while (i < n) {
+        if (in->pastematch == 0) {
+            const unsigned char* esc = memchr(p + i, 0x1B, n - i);
+            const size_t run = esc ? (size_t)(esc - (p + i)) : n - i;
+            paste_append(in, p + i, run);
+            i += run;
+            if (!esc) break;
+        }
+        if ((char)p[i] == paste_end[in->pastematch]) {
+            i++;
+            if (++in->pastematch == PASTE_END_LEN) {
+                const size_t start = in->pastestart;
+                const unsigned slot = (in->head + in->count) & (NC_INQUEUE_SIZE - 1);
+                ncinput* ni = push_event(in, NCKEY_PASTE);
+                ni->pastelen = in->paste.len - start;
+                ni->pastetruncated = in->pastecut;
+                in->pasteoff[slot] = start;
+                in->state = S_GROUND;
+                break;
+            }
+        } else {
+            // Not the end marker after all; the matched bytes are text, and
+            // this byte is looked at again
+            paste_append(in, paste_end, in->pastematch);
+            in->pastematch = 0;
+        }
     }
+    return i;
+}
 
-    for (int i = 0; i < remaining; i++) {
-        int b = read_byte_brief();
-        if (b < 0 || (b & 0xC0) != 0x80) return NCKEY_INVALID;
-        cp = (cp << 6) | (uint32_t)(b & 0x3F);
+// Decode buffered bytes until they run out or the queue is nearly full.
+static void decode(nc_input* in) {
+    while (in->pos < in->len && in->count + 2 <= NC_INQUEUE_SIZE) {
+        if (in->state == S_PASTE) {
+            in->pos += decode_paste(in, in->buf + in->pos, in->len - in->pos);
+            continue;
+        }
+        const unsigned char b = in->buf[in->pos++];
+        switch (actions[in->state][byte_class[b]]) {
+            case A_KEY:
+                push_event(in, byte_key(b));
+                break;
+            case A_ALT:
+                push_event(in, byte_key(b))->alt = true;
+                in->state = S_GROUND;
+                break;
+            case A_ESC_ESC:
+                push_event(in, NCKEY_ESC);
+                // fallthrough
+            case A_ESC:
+                in->state = S_ESC;
+                break;
+            case A_CSI:
+            case A_SS3:
+                in->state = b == '[' ? S_CSI : S_SS3;
+                in->priv = 0;
+                in->nparam = 0;
+                memset(in->params, 0, sizeof(in->params));
+                break;
+            case A_PARAM:
+                if (in->nparam == 0) in->nparam = 1;
+                if (in->nparam <= NC_CSI_PARAMS) {
+                    unsigned* v = &in->params[in->nparam - 1];
+                    if (*v < 100000) *v = *v * 10 + (unsigned)(b - '0');
+                }
+                break;
+            case A_SEP:
+                if (in->nparam == 0) in->nparam = 1;
+                if (in->nparam <= NC_CSI_PARAMS) in->nparam++;
+                break;
+            case A_PRIV:
+                in->priv = (char)b;
+                break;
+            case A_CSI_END:
+                csi_end(in, b);
+                break;
+            case A_SS3_END:
+                ss3_end(in, b);
+                break;
+            case A_UTF8: {
+                in->alt  = in->state == S_ESC;
+                in->need = b < 0xE0 ? 1 : b < 0xF0 ? 2 : 3;
+                in->cp   = b & (0x3Fu >> in->need);
+                in->state = S_UTF8;
+                break;
+            }
+            case A_UTF8_CONT:
+                in->cp = (in->cp << 6) | (b & 0x3Fu);
+                if (--in->need == 0) {
+                    push_event(in, in->cp)->alt = in->alt;
+                    in->state = S_GROUND;
+                }
+                break;
+            case A_UTF8_ABORT:
+                push_event(in, NCKEY_INVALID);
+                in->state = S_GROUND;
+                in->pos--;   // Decode this byte again from the ground state
+                break;
+            case A_INVALID:
+                push_event(in, NCKEY_INVALID);
+                in->state = S_GROUND;
+                break;
+            case A_DROP:
+                in->state = S_GROUND;
+                break;
+            case A_IGNORE:
+            default:
+                break;
+        }
     }
+}
 
-    return cp;
+// A sequence has begun but not ended; it resolves when more bytes arrive
+// or the escape delay passes.
+static inline bool partial(const nc_input* in) {
+    return in->state != S_GROUND && in->state != S_PASTE;
+}
+
+// The escape delay passed: a lone ESC is the Escape key, and whatever else
+// was started is given up.
+static void flush_partial(nc_input* in) {
+    switch (in->state) {
+        case S_ESC:  push_event(in, NCKEY_ESC); break;
+        case S_SS3:  push_event(in, 'O')->alt = true; break;   // Alt+O
+        case S_UTF8: push_event(in, NCKEY_INVALID); break;
+        default: break;
+    }
+    in->state = S_GROUND;
+}
+
+// Decode, noting when a partial sequence begins.
+static void decode_buffered(nc_input* in) {
+    const bool was_partial = partial(in);
+    decode(in);
+    if (partial(in) && !was_partial) in->pending_since = nc_now_ns();
+}
+
+// Read everything available in one call and decode it.  Returns false at
+// end of input or on error.
+static bool read_input(int fd, nc_input* in) {
+    if (in->pos == in->len) {
+        in->pos = in->len = 0;
+    } else if (in->pos > 0) {
+        memmove(in->buf, in->buf + in->pos, in->len - in->pos);
+        in->len -= in->pos;
+        in->pos = 0;
+    }
+    ssize_t n;
+    do {
+        n = read(fd, in->buf + in->len, NC_INBUF_SIZE - in->len);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+    in->len += (size_t)n;
+    decode_buffered(in);
+    return true;
+}
+
+static bool take_resize(struct notcurses* nc) {
+    if (nc->headless || !g_resize_flag) return false;
+    g_resize_flag = 0;
+    push_event(&nc->input, NCKEY_RESIZE);
+    return true;
+}
+
+// Make sure an event is queued, waiting up to ts for input.  Leaves the
+// queue empty on timeout, wakeup or error.
+static void fill_queue(struct notcurses* nc, const struct timespec* ts) {
+    nc_input* in = &nc->input;
+    nc_catch_up(nc);
+    if (in->count) return;
+    // Every paste handed out has been consumed
+    if (in->state != S_PASTE) in->paste.len = 0;
+    // Bytes left over when the queue filled up
+    decode_buffered(in);
+    if (in->count) return;
+
+    const uint64_t deadline = ts
+        ? nc_now_ns() + (uint64_t)ts->tv_sec * 1000000000ull + (uint64_t)ts->tv_nsec
+        : UINT64_MAX;
+    for (;;) {
+        if (take_resize(nc)) return;
+
+        // A partial sequence is resolved within the escape delay, even if
+        // that outlasts ts, as a lone ESC must come back as the Escape key
+        const bool waiting = partial(in);
+        const uint64_t escdeadline = waiting ? in->pending_since + in->escdelay : UINT64_MAX;
+        const uint64_t until = waiting ? escdeadline : deadline;
+        struct timespec wait;
+        const struct timespec* waitp = NULL;
+        if (until != UINT64_MAX) {
+            const uint64_t now = nc_now_ns();
+            const uint64_t left = until > now ? until - now : 0;
+            wait.tv_sec  = (time_t)(left / 1000000000ull);
+            wait.tv_nsec = (long)(left % 1000000000ull);
+            waitp = &wait;
+        }
+
+        // Output left over from a render is sent as the terminal takes
+        // it, here unless a render thread sends it
+        const int outfd = !nc->pipeline && notcurses_output_pending(nc) ? nc->outfd : -1;
+        const int ready = wait_for_input(nc->infd, nc->wakefd[0], outfd, waitp);
+        if (ready < 0) {
+            take_resize(nc);   // The signal may have interrupted the wait
+            return;
+        }
+        if (ready == 2) {
+            nc_catch_up(nc);
+            continue;
+        }
+        if (ready > 0) {
+            // Keep reading while bytes are waiting, even past the deadline,
+            // so a long paste is not cut short by a zero timeout
+            if (!read_input(nc->infd, in) || in->count) return;
+            continue;
+        }
+        if (waiting && nc_now_ns() >= escdeadline) {
+            flush_partial(in);
+            if (in->count) return;
+            if (nc_now_ns() < deadline) continue;
+        }
+        take_resize(nc);
+        return;   // Timeout or notcurses_wake()
+    }
+}
+
+void nc_input_init(nc_input* in) {
+    memset(in, 0, sizeof(*in));
+    in->escdelay = (uint64_t)NC_ESC_DELAY_MS * 1000000ull;
+}
+
+void nc_input_free(nc_input* in) {
+    nc_out_free(&in->paste);
 }
 
 // ---------------------------------------------------------------------------
-// notcurses_get — main input entry point
+// notcurses_wake — interrupt notcurses_get() from another thread
+// ---------------------------------------------------------------------------
+
+int notcurses_wake(struct notcurses* nc) {
+    if (!nc || nc->wakefd[1] < 0) return -1;
+    // A full pipe already guarantees a wakeup, so EAGAIN is success
+    ssize_t n;
+    do {
+        n = write(nc->wakefd[1], "", 1);
+    } while (n < 0 && errno == EINTR);
+    return (n == 1 || errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+}
+
+// ---------------------------------------------------------------------------
+// notcurses_get / notcurses_getvec — main input entry points
 //
-// Returns 0 on timeout, or the key code (Unicode codepoint / NCKEY_*).
+// notcurses_get returns 0 on timeout, or the key code (Unicode codepoint /
+// NCKEY_*).
 // ---------------------------------------------------------------------------
 
 uint32_t notcurses_get(struct notcurses* nc,
                        const struct timespec* ts, ncinput* ni) {
     if (!nc) return 0;
-
-    // Zero out ncinput
     if (ni) memset(ni, 0, sizeof(ncinput));
 
-    // Check resize flag first
-    if (g_resize_flag) {
-        g_resize_flag = 0;
-        uint32_t key = NCKEY_RESIZE;
-        if (ni) ni->id = key;
-        return key;
-    }
+    fill_queue(nc, ts);
+    if (!nc->input.count) return 0;
+    const uint32_t key = nc->input.queue[nc->input.head].id;
+    pop_event(&nc->input, ni);
+    return key;
+}
 
-    // Wait for input (or timeout)
-    int ready = wait_for_input(ts);
-    if (ready <= 0) {
-        // Check resize flag again (signal may have arrived during select)
-        if (g_resize_flag) {
-            g_resize_flag = 0;
-            uint32_t key = NCKEY_RESIZE;
-            if (ni) ni->id = key;
-            return key;
-        }
-        return 0;  // Timeout
-    }
+int notcurses_getvec(struct notcurses* nc, const struct timespec* ts,
+                     ncinput* ni, int vcount) {
+    if (!nc || !ni || vcount <= 0) return -1;
 
-    int byte = read_byte_nonblock();
-    if (byte < 0) return 0;
+    fill_queue(nc, ts);
+    int n = 0;
+    while (n < vcount && nc->input.count) {
+        pop_event(&nc->input, &ni[n++]);
+    }
+    return n;
+}
 
-    uint32_t key = 0;
+void notcurses_set_escape_delay(struct notcurses* nc, unsigned ms) {
+    if (nc) nc->input.escdelay = (uint64_t)ms * 1000000ull;
+}
 
-    if (byte == 27) {
-        // ESC — could be escape key or start of escape sequence
-        int next = read_byte_brief();
-        if (next < 0) {
-            // No follow-up byte → bare Escape key
-            key = NCKEY_ESC;
-        } else if (next == '[') {
-            key = parse_csi(ni);
-            if (key == 0) key = NCKEY_ESC;  // Unrecognized sequence
-        } else if (next == 'O') {
-            key = parse_ss3();
-            if (key == 0) key = NCKEY_ESC;
-        } else {
-            // Alt + key
-            if (ni) ni->alt = true;
-            if (next >= 0x80) {
-                key = read_utf8(next);
-            } else {
-                key = (uint32_t)next;
-            }
-        }
-    } else if (byte == 13 || byte == 10) {
-        key = NCKEY_ENTER;
-    } else if (byte == 127 || byte == 8) {
-        key = NCKEY_BACKSPACE;
-    } else if (byte == 9) {
-        key = NCKEY_TAB;
-    } else if (byte >= 0x80) {
-        // UTF-8 multibyte
-        key = read_utf8(byte);
-    } else {
-        // Regular ASCII
-        key = (uint32_t)byte;
-    }
+unsigned notcurses_escape_delay(const struct notcurses* nc) {
+    return nc ? (unsigned)(nc->input.escdelay / 1000000ull) : 0;
+}
 
-    if (ni) ni->id = key;
-    return key;
+void notcurses_set_paste_limit(struct notcurses* nc, size_t limit) {
+    if (nc) nc->input.paste.limit = limit;
 }
@@ -8,19 +8,156 @@
 #include <string.h>
 #include <signal.h>
 #include <unistd.h>
+#include <sys/uio.h>
 
 // ---------------------------------------------------------------------------
-// Cell — one character position in a plane buffer
+// Cell — one character position in a plane buffer, packed into 16 bytes
+//
+// A grapheme cluster of up to four UTF-8 bytes is stored inline,
+// NUL-padded.  Longer clusters (combining marks, ZWJ sequences) live in the
+// egcpool of the buffer that owns the cell, and gcluster holds
+// NC_EGC_POOLED followed by the 24-bit pool offset.  0xFF never occurs in
+// UTF-8, so the two forms cannot be confused.
 // ---------------------------------------------------------------------------
+#define NC_DEFAULT_RGB  0xFFFFFFFFu   // Terminal default color
+#define NC_EGC_POOLED   0xFFu         // First gcluster byte of a pooled cluster
+#define NC_EGC_INLINE   4             // Longest cluster stored in the cell
+#define NC_EGC_MAX      32            // Longest cluster kept; more is dropped
+#define NC_CELL_WRITTEN 0x0001u       // Cell has content; others are transparent
+_Static_assert(NC_DEFAULT_RGB == NCSPAN_DEFAULT_RGB, "spans and cells share the default");
+
 typedef struct nc_cell {
-    char     gcluster[8];   // UTF-8 encoded grapheme (up to 4 bytes + NUL)
-    uint32_t fg_rgb;        // Foreground 0x00RRGGBB
-    uint32_t bg_rgb;        // Background 0x00RRGGBB
-    uint32_t styles;        // NCSTYLE_* bitmask
-    bool     fg_set;        // Foreground was explicitly set
-    bool     bg_set;        // Background was explicitly set
-    bool     written;       // Cell has content
+    char     gcluster[NC_EGC_INLINE];  // Inline UTF-8 or pool reference
+    uint32_t fg;            // Foreground 0x00RRGGBB or NC_DEFAULT_RGB
+    uint32_t bg;            // Background 0x00RRGGBB or NC_DEFAULT_RGB
+    uint16_t styles;        // NCSTYLE_* bitmask
+    uint16_t flags;         // NC_CELL_* bitmask
 } nc_cell;
+_Static_assert(sizeof(nc_cell) == 16, "nc_cell must stay packed");
+
+// ---------------------------------------------------------------------------
+// Grapheme pool — NUL-terminated clusters too long for a cell, back to back.
+// Cleared with the buffer it belongs to.
+// ---------------------------------------------------------------------------
+typedef struct nc_egcpool {
+    char*  data;
+    size_t len;
+    size_t cap;
+} nc_egcpool;
+
+// ---------------------------------------------------------------------------
+// Output buffer — owned by struct notcurses and reused across frames
+// ---------------------------------------------------------------------------
+typedef struct nc_outbuf {
+    char*  data;
+    size_t len;
+    size_t cap;
+    size_t limit;   // Most bytes it may hold, or 0 for no limit
+} nc_outbuf;
+
+// ---------------------------------------------------------------------------
+// Band — rows of a full repaint encoded on their own thread (see buffer.c)
+// ---------------------------------------------------------------------------
+#define NC_ENCODE_THREADS_MAX 64
+
+typedef struct nc_band {
+    nc_outbuf out;       // Escapes for the band's rows, reused across frames
+    uint64_t  emitted;   // Cells written
+    bool      ok;        // False if out could not grow
+} nc_band;
+
+typedef struct nc_workers nc_workers;
+
+// ---------------------------------------------------------------------------
+// Snapshot — a composited frame queued for the render thread (see
+// pipeline.c)
+// ---------------------------------------------------------------------------
+typedef struct nc_snapshot {
+    nc_cell*   cells;
+    nc_egcpool pool;      // Long clusters referenced by cells
+    size_t     cap;       // Cells there is room for
+    unsigned   rows;
+    unsigned   cols;
+    bool       repaint;   // Repaint every cell, as notcurses_refresh()
+} nc_snapshot;
+
+typedef struct nc_pipeline nc_pipeline;
+
+// ---------------------------------------------------------------------------
+// Pen — the SGR state the terminal is currently in
+// ---------------------------------------------------------------------------
+#define NC_PEN_UNKNOWN 0xFFFFFFFFu   // Styles not known; next SGR resets
+
+typedef struct nc_pen {
+    uint32_t styles;
+    uint32_t fg;    // A color from nc_palette_color()
+    uint32_t bg;
+} nc_pen;
+
+// ---------------------------------------------------------------------------
+// Palette — how RGB colors are encoded for the terminal (see palette.c)
+//
+// Colors are quantized before the pen compares them, so neighbouring cells
+// whose colors share a palette entry need no SGR between them.  Quantized
+// colors carry a flag above the 24 RGB bits saying which form to emit.
+// ---------------------------------------------------------------------------
+#define NC_COLOR_INDEXED 0x01000000u  // Low byte is an xterm-256 index
+#define NC_COLOR_ANSI    0x02000000u  // Low nibble is an ANSI color 0-15
+#define NC_LUT16_SIZE    32768        // 5 bits per channel
+
+typedef struct nc_palette {
+    nccolors_e colors;
+    uint8_t*   lut16;   // 15-bit RGB → ANSI color, once 16 colors are used
+} nc_palette;
+
+uint8_t nc_rgb_to_256(uint32_t rgb);
+bool    nc_palette_set(nc_palette* pal, nccolors_e colors);
+void    nc_palette_free(nc_palette* pal);
+
+// An RGB color or NC_DEFAULT_RGB as the terminal will be sent it.
+static inline uint32_t nc_palette_color(const nc_palette* pal, uint32_t rgb) {
+    if (rgb == NC_DEFAULT_RGB || pal->colors == NCCOLORS_RGB) return rgb;
+    if (pal->colors == NCCOLORS_256) return NC_COLOR_INDEXED | nc_rgb_to_256(rgb);
+    const unsigned key = ((rgb >> 9) & 0x7C00) | ((rgb >> 6) & 0x3E0) | ((rgb >> 3) & 0x1F);
+    return NC_COLOR_ANSI | pal->lut16[key];
+}
+
+// Worst case bytes emitted for one cell: cursor move + SGR + glyph
+#define NC_CELL_MAX_BYTES (96 + NC_EGC_MAX)
+
+// ---------------------------------------------------------------------------
+// Input decoder state — bytes read in bulk, decoded by a resumable state
+// machine into a ring of events (see input.c)
+// ---------------------------------------------------------------------------
+#define NC_INBUF_SIZE     4096   // Bytes read per read(2) at most
+#define NC_INQUEUE_SIZE   256    // Decoded events waiting; power of two
+#define NC_CSI_PARAMS     8
+#define NC_ESC_DELAY_MS   50     // Default; see notcurses_set_escape_delay()
+
+typedef struct nc_input {
+    unsigned char buf[NC_INBUF_SIZE];    // Read but not yet decoded
+    size_t        pos;
+    size_t        len;
+    ncinput       queue[NC_INQUEUE_SIZE];
+    size_t        pasteoff[NC_INQUEUE_SIZE];  // Offset into paste, per event
+    unsigned      head;                  // Oldest queued event
+    unsigned      count;
+    // Sequence being decoded
+    uint8_t       state;
+    bool          alt;                   // ESC prefix: Alt modifier
+    char          priv;                  // CSI private marker, e.g. '<'
+    unsigned      nparam;
+    unsigned      params[NC_CSI_PARAMS];
+    uint32_t      cp;                    // UTF-8 codepoint so far
+    unsigned      need;                  // UTF-8 continuation bytes left
+    uint64_t      pending_since;         // When the partial sequence began, ns
+    uint64_t      escdelay;              // ns to wait for the rest of one
+    // Bracketed paste
+    nc_outbuf     paste;                 // Text of the pastes queued
+    size_t        pastestart;            // Where the open paste begins
+    unsigned      pastematch;            // Bytes of the end marker matched
+    bool          pastecut;              // Text of the open paste was lost
+} nc_input;
 
 // ---------------------------------------------------------------------------
 // Full struct definitions (opaque to Swift, visible to .c files)
@@ -28,6 +165,7 @@ typedef struct nc_cell {
 
 struct ncplane {
     nc_cell*          cells;      // Row-major cell buffer
+    nc_egcpool        pool;       // Clusters too long for cells
     unsigned          rows;
     unsigned          cols;
     int               y;          // Position relative to parent / screen
@@ -39,26 +177,166 @@ struct ncplane {
     uint32_t          styles;     // Current drawing style bits
     bool              fg_set;     // FG has been set via set_fg_rgb
     bool              bg_set;     // BG has been set via set_bg_rgb
-    struct ncplane*   parent;     // NULL for stdplane
+    struct ncplane*   parent;     // NULL for stdplane and offscreen planes
+    struct ncplane*   above;      // Next plane up the z-order (NULL at top)
+    struct ncplane*   below;      // Next plane down the z-order
     struct notcurses* nc;         // Owner context
+    bool              offscreen;  // Outside the z-order, never composited
 };
 
 struct notcurses {
     struct ncplane*  stdplane;
+    struct ncplane*  top;         // Topmost plane in the z-order
+    struct ncplane*  bottom;      // Bottommost plane in the z-order
+    nc_cell*         frame;       // All planes composited, rows*cols
+    nc_egcpool       framepool;   // Long clusters referenced by frame
+    unsigned         framerows;   // Dimensions of frame
+    unsigned         framecols;
     struct termios   original;    // Saved terminal state
     FILE*            fp;          // Output stream
+    nc_outbuf        out;         // Encoded frame, reused across renders
+    int              outfd;       // Terminal opened again, non-blocking; -1 if none
+    nc_outbuf        pending;     // Output the terminal has not taken yet
+    size_t           pendingoff;  // Bytes of pending already sent
+    uint64_t         pending_since;  // When pending last became non-empty, ns
+    bool             owed;        // A render was dropped; send the latest
+    size_t           sinklimit;   // Headless: most bytes the sink holds
+    nc_cell*         lastframe;   // Cells as last presented to the terminal
+    nc_egcpool       lastpool;    // Long clusters referenced by lastframe
+    unsigned         lastrows;    // Dimensions of lastframe
+    unsigned         lastcols;
+    uint64_t*        framehash;   // Per-row hashes of the frame being rendered
+    uint64_t*        lasthash;    // Per-row hashes of lastframe
+    bool             repaint;     // Next render repaints every cell
+    ncstats          stats;       // Render counters
     unsigned         rows;
     unsigned         cols;
     uint64_t         flags;
     bool             alt_screen;  // Alternate screen is active
+    unsigned         mice;        // NCMICE_* events being reported
+    int              wakefd[2];   // Self-pipe written by notcurses_wake()
+    int              infd;        // Input is read from here
+    bool             headless;    // No terminal; see notcurses_init_headless()
+    nc_outbuf        sink;        // Headless: bytes rendered, not yet taken
+    int              injectfd;    // Headless: write end of the input pipe
+    nc_input         input;       // Input decoder and event queue
+    nc_palette       palette;     // Color encoding of rendered output
+    nc_workers*      encoders;    // Threads encoding bands; NULL with one
+    nc_band*         bands;       // One per encoding thread, ours included
+    unsigned         nbands;      // 0 when encoding on the calling thread
+    nc_pipeline*     pipeline;    // Render thread; NULL when synchronous
 };
 
+// ---------------------------------------------------------------------------
+// Grapheme clusters (implemented in egcpool.c)
+// ---------------------------------------------------------------------------
+void        nc_egcpool_clear(nc_egcpool* pool);
+void        nc_egcpool_free(nc_egcpool* pool);
+bool        nc_egcpool_copy(nc_egcpool* dst, const nc_egcpool* src);
+bool        nc_cell_set_egc(nc_cell* c, nc_egcpool* pool,
+                            const char* egc, size_t len);
+bool        nc_cell_copy(nc_cell* dst, nc_egcpool* dstpool,
+                         const nc_cell* src, const nc_egcpool* srcpool);
+size_t      nc_egc_length(const unsigned char* s, size_t avail);
+
+// The cluster of a cell and its length in bytes; not NUL-terminated when
+// stored inline.
+static inline const char* nc_cell_egc(const nc_cell* c, const nc_egcpool* pool,
+                                      size_t* len) {
+    if ((unsigned char)c->gcluster[0] == NC_EGC_POOLED) {
+        const unsigned char* g = (const unsigned char*)c->gcluster;
+        const char* egc = pool->data + (g[1] | g[2] << 8 | (size_t)g[3] << 16);
+        *len = strlen(egc);
+        return egc;
+    }
+    size_t n = 0;
+    while (n < NC_EGC_INLINE && c->gcluster[n]) n++;
+    *len = n;
+    return c->gcluster;
+}
+
 // ---------------------------------------------------------------------------
 // Internal helpers (implemented in buffer.c)
 // ---------------------------------------------------------------------------
 void nc_plane_init_cells(struct ncplane* n);
 void nc_plane_free_cells(struct ncplane* n);
-void nc_render_plane(struct notcurses* nc, struct ncplane* n);
+void nc_render_frame(struct notcurses* nc);
+const nc_cell* nc_composite(struct notcurses* nc, const nc_egcpool** pool);
+void nc_present(struct notcurses* nc, const nc_cell* frame,
+                const nc_egcpool* pool, unsigned rows, unsigned cols);
 void nc_get_terminal_size(unsigned* rows, unsigned* cols);
 
+// ---------------------------------------------------------------------------
+// Input (implemented in input.c)
+// ---------------------------------------------------------------------------
+void nc_input_init(nc_input* in);
+void nc_input_free(nc_input* in);
+
+// ---------------------------------------------------------------------------
+// Output (implemented in terminal.c)
+// ---------------------------------------------------------------------------
+void nc_write_out(struct notcurses* nc, const char* data, size_t len);
+void nc_write_outv(struct notcurses* nc, const struct iovec* iov, int count);
+bool nc_flush_pending(struct notcurses* nc);
+void nc_catch_up(struct notcurses* nc);
+
+static inline uint64_t nc_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// ---------------------------------------------------------------------------
+// Worker threads (implemented in workers.c)
+//
+// nc_workers_run() calls fn once per index in [0, count) on the workers
+// and the calling thread, and returns when every call has.  A NULL pool
+// runs them all on the calling thread.
+// ---------------------------------------------------------------------------
+nc_workers* nc_workers_create(unsigned threads);
+void        nc_workers_destroy(nc_workers* w);
+void        nc_workers_run(nc_workers* w, unsigned count,
+                           void (*fn)(void* arg, unsigned index), void* arg);
+
+// ---------------------------------------------------------------------------
+// Render thread (implemented in pipeline.c)
+//
+// Calls that read or change the render state (front buffer, output,
+// statistics, palette) bracket it with nc_pipeline_hold() and
+// nc_pipeline_release(), which do nothing without a pipeline.
+// ---------------------------------------------------------------------------
+bool nc_pipeline_start(struct notcurses* nc);
+void nc_pipeline_stop(struct notcurses* nc);
+bool nc_pipeline_submit(struct notcurses* nc, bool repaint);
+void nc_pipeline_hold(nc_pipeline* pl);
+void nc_pipeline_release(nc_pipeline* pl);
+void nc_pipeline_retry(nc_pipeline* pl);
+
+// ---------------------------------------------------------------------------
+// Z-order list (implemented in plane.c)
+// ---------------------------------------------------------------------------
+void nc_zorder_push_top(struct notcurses* nc, struct ncplane* n);
+void nc_zorder_unlink(struct notcurses* nc, struct ncplane* n);
+
+// ---------------------------------------------------------------------------
+// ANSI encoder (implemented in encode.c)
+//
+// The nc_encode_* functions write at p and return the new end; callers
+// reserve NC_CELL_MAX_BYTES per cell up front.
+// ---------------------------------------------------------------------------
+bool  nc_out_reserve(nc_outbuf* o, size_t extra);
+void  nc_out_free(nc_outbuf* o);
+void  nc_pen_invalidate(nc_pen* pen);
+char* nc_encode_cup(char* p, unsigned y, unsigned x);
+char* nc_encode_cuf(char* p, unsigned n);
+char* nc_encode_scroll(char* p, nc_pen* pen,
+                       unsigned top, unsigned bottom, int shift);
+char* nc_encode_sgr(char* p, nc_pen* pen,
+                    uint32_t styles, uint32_t fg, uint32_t bg);
+
+static inline char* nc_encode_lit(char* p, const char* s, size_t n) {
+    memcpy(p, s, n);
+    return p + n;
+}
+
 #endif /* NOTCURSES_INTERNAL_H */
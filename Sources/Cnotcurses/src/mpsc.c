@@ -0,0 +1,66 @@
+#include "internal.h"
+#include <stdatomic.h>
+
+// ---------------------------------------------------------------------------
+// Multi-producer, single-consumer queue
+//
+// A linked list with a stub node (Vyukov).  Producers swap themselves in
+// at the head with one atomic exchange and then link the previous head to
+// their node; the consumer follows next pointers from the tail.  A push
+// that has exchanged the head but not linked yet is invisible to pop
+// until the link is stored, so pop may briefly report empty.
+// ---------------------------------------------------------------------------
+
+typedef struct ncmpsc_node {
+    _Atomic(struct ncmpsc_node*) next;
+    void*                        item;
+} ncmpsc_node;
+
+struct ncmpsc {
+    _Atomic(ncmpsc_node*) head;   // Most recently pushed node
+    ncmpsc_node*          tail;   // Stub; its successor holds the next item
+};
+
+struct ncmpsc* ncmpsc_create(void) {
+    struct ncmpsc* q = malloc(sizeof(*q));
+    ncmpsc_node* stub = calloc(1, sizeof(*stub));
+    if (!q || !stub) {
+        free(q);
+        free(stub);
+        return NULL;
+    }
+    atomic_init(&stub->next, NULL);
+    atomic_init(&q->head, stub);
+    q->tail = stub;
+    return q;
+}
+
+void ncmpsc_destroy(struct ncmpsc* q) {
+    if (!q) return;
+    while (ncmpsc_pop(q)) {}
+    free(q->tail);
+    free(q);
+}
+
+int ncmpsc_push(struct ncmpsc* q, void* item) {
+    if (!q) return -1;
+    ncmpsc_node* n = malloc(sizeof(*n));
+    if (!n) return -1;
+    n->item = item;
+    atomic_init(&n->next, NULL);
+    ncmpsc_node* prev = atomic_exchange_explicit(&q->head, n, memory_order_acq_rel);
+    atomic_store_explicit(&prev->next, n, memory_order_release);
+    return 0;
+}
+
+void* ncmpsc_pop(struct ncmpsc* q) {
+    if (!q) return NULL;
+    ncmpsc_node* stub = q->tail;
+    ncmpsc_node* next = atomic_load_explicit(&stub->next, memory_order_acquire);
+    if (!next) return NULL;
+    // The popped node becomes the new stub
+    void* item = next->item;
+    q->tail = next;
+    free(stub);
+    return item;
+}
@@ -0,0 +1,145 @@
+#include "internal.h"
+
+// ---------------------------------------------------------------------------
+// Color support detection
+//
+// The environment is all there is to go on without a round trip to the
+// terminal: COLORTERM is set by terminals with 24-bit color (and passed
+// through by most multiplexers), TERM names the terminfo entry, whose
+// "-256color" and "-direct" variants say what they mean.
+// ---------------------------------------------------------------------------
+
+// Terminals that support 24-bit color under their own TERM name
+static const char* const rgb_terms[] = {
+    "xterm-kitty", "xterm-ghostty", "alacritty", "foot", "wezterm", "contour",
+};
+
+nccolors_e notcurses_detect_colors(const char* term, const char* colorterm) {
+    if (colorterm && (!strcmp(colorterm, "truecolor") || !strcmp(colorterm, "24bit"))) {
+        return NCCOLORS_RGB;
+    }
+    if (!term || !*term) return NCCOLORS_16;
+    if (strstr(term, "-direct") || strstr(term, "truecolor")) return NCCOLORS_RGB;
+    for (size_t i = 0; i < sizeof(rgb_terms) / sizeof(*rgb_terms); i++) {
+        if (!strncmp(term, rgb_terms[i], strlen(rgb_terms[i]))) return NCCOLORS_RGB;
+    }
+    if (strstr(term, "256color")) return NCCOLORS_256;
+    // xterm, screen, tmux, linux and the rest: the eight ANSI colors and
+    // their bright variants are all terminfo promises
+    return NCCOLORS_16;
+}
+
+// ---------------------------------------------------------------------------
+// RGB → xterm-256 — the nearest of the 6x6x6 cube and the 24-step gray ramp
+//
+// Each cube axis has the levels 0, 95, 135, 175, 215, 255, so the nearest
+// level of a channel is a comparison and a division.  Only two candidates
+// are left to compare, the cube color and the gray nearest the channel
+// mean, which keeps this constant time without a table.
+// ---------------------------------------------------------------------------
+
+static inline unsigned cube_index(unsigned v) {
+    return v < 48 ? 0 : v < 115 ? 1 : (v - 35) / 40;
+}
+
+static inline unsigned cube_level(unsigned i) {
+    return i ? 55 + i * 40 : 0;
+}
+
+static inline unsigned distance(unsigned r1, unsigned g1, unsigned b1,
+                                unsigned r2, unsigned g2, unsigned b2) {
+    const int dr = (int)r1 - (int)r2;
+    const int dg = (int)g1 - (int)g2;
+    const int db = (int)b1 - (int)b2;
+    return (unsigned)(dr * dr + dg * dg + db * db);
+}
+
+uint8_t nc_rgb_to_256(uint32_t rgb) {
+    const unsigned r = (rgb >> 16) & 0xFF;
+    const unsigned g = (rgb >> 8) & 0xFF;
+    const unsigned b = rgb & 0xFF;
+
+    const unsigned ri = cube_index(r), gi = cube_index(g), bi = cube_index(b);
+    const unsigned cr = cube_level(ri), cg = cube_level(gi), cb = cube_level(bi);
+    if (cr == r && cg == g && cb == b) return (uint8_t)(16 + ri * 36 + gi * 6 + bi);
+
+    // Gray levels are 8, 18, ..., 238
+    const unsigned mean = (r + g + b) / 3;
+    const unsigned gi24 = mean < 8 ? 0 : mean > 233 ? 23 : (mean - 3) / 10;
+    const unsigned gray = 8 + gi24 * 10;
+
+    if (distance(r, g, b, gray, gray, gray) < distance(r, g, b, cr, cg, cb)) {
+        return (uint8_t)(232 + gi24);
+    }
+    return (uint8_t)(16 + ri * 36 + gi * 6 + bi);
+}
+
+// ---------------------------------------------------------------------------
+// RGB → 16 colors — a table indexed by the top five bits of each channel,
+// built once when the context switches to 16 colors.  The palette is
+// xterm's default; terminals theme these colors, so nearest is a guess
+// either way and 15-bit precision is plenty.
+// ---------------------------------------------------------------------------
+
+static const uint8_t ansi_palette[16][3] = {
+    {0, 0, 0}, {205, 0, 0}, {0, 205, 0}, {205, 205, 0},
+    {0, 0, 238}, {205, 0, 205}, {0, 205, 205}, {229, 229, 229},
+    {127, 127, 127}, {255, 0, 0}, {0, 255, 0}, {255, 255, 0},
+    {92, 92, 255}, {255, 0, 255}, {0, 255, 255}, {255, 255, 255},
+};
+
+static uint8_t* build_lut16(void) {
+    uint8_t* lut = malloc(NC_LUT16_SIZE);
+    if (!lut) return NULL;
+    for (unsigned i = 0; i < NC_LUT16_SIZE; i++) {
+        // The middle of the range of colors sharing this entry
+        const unsigned r = ((i >> 10) & 0x1F) << 3 | 4;
+        const unsigned g = ((i >> 5) & 0x1F) << 3 | 4;
+        const unsigned b = (i & 0x1F) << 3 | 4;
+        unsigned best = 0;
+        unsigned bestd = UINT32_MAX;
+        for (unsigned c = 0; c < 16; c++) {
+            const unsigned d = distance(r, g, b, ansi_palette[c][0],
+                                        ansi_palette[c][1], ansi_palette[c][2]);
+            if (d < bestd) {
+                bestd = d;
+                best = c;
+            }
+        }
+        lut[i] = (uint8_t)best;
+    }
+    return lut;
+}
+
+bool nc_palette_set(nc_palette* pal, nccolors_e colors) {
+    if (colors == NCCOLORS_16 && !pal->lut16) {
+        pal->lut16 = build_lut16();
+        if (!pal->lut16) return false;
+    }
+    pal->colors = colors;
+    return true;
+}
+
+void nc_palette_free(nc_palette* pal) {
+    free(pal->lut16);
+    pal->lut16 = NULL;
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+nccolors_e notcurses_colors(const struct notcurses* nc) {
+    return nc ? nc->palette.colors : NCCOLORS_RGB;
+}
+
+int notcurses_set_colors(struct notcurses* nc, nccolors_e colors) {
+    if (!nc || colors < NCCOLORS_16 || colors > NCCOLORS_RGB) return -1;
+    if (colors == nc->palette.colors) return 0;
+    nc_pipeline_hold(nc->pipeline);
+    const bool set = nc_palette_set(&nc->palette, colors);
+    // Cells on screen were encoded the old way; compare nothing against them
+    if (set) nc->repaint = true;
+    nc_pipeline_release(nc->pipeline);
+    return set ? 0 : -1;
+}
@@ -0,0 +1,193 @@
+#include "internal.h"
+#include <pthread.h>
+#include <poll.h>
+
+// ---------------------------------------------------------------------------
+// Pipelined rendering
+//
+// notcurses_render() composites the planes and copies the frame into a
+// snapshot, which it queues for the render thread; the caller goes on to
+// the next frame while the thread diffs, encodes and writes this one.
+// The queue holds one frame: a frame queued before the thread took the
+// last one replaces it, so the thread always writes the latest.
+//
+// Three snapshots rotate: the caller fills one, one is queued, and the
+// thread works on the third.  Everything the render path owns (the front
+// buffer, output buffers, pending bytes, statistics) belongs to the
+// thread while it is busy; API calls touching it hold the pipeline, which
+// waits until the frames submitted so far have been handled.
+// ---------------------------------------------------------------------------
+
+// How often the thread checks the terminal while it lags, ms
+#define NC_PIPELINE_POLL_MS 10
+
+struct nc_pipeline {
+    pthread_t       thread;
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;        // Any change to the state below
+    nc_snapshot     snaps[3];
+    nc_snapshot*    fill;        // Filled by the caller, unlocked
+    nc_snapshot*    queued;      // Waiting for the thread
+    nc_snapshot*    work;        // Written by the thread, or owed
+    bool            ready;       // queued holds a frame
+    bool            busy;        // The thread is using the render state
+    bool            owed;        // work could not be written yet
+    bool            retry;       // Try writing work again
+    bool            stopping;
+    uint64_t        superseded;  // Queued frames replaced, to be counted
+};
+
+static void* render_main(void* arg) {
+    struct notcurses* nc = arg;
+    nc_pipeline* pl = nc->pipeline;
+    pthread_mutex_lock(&pl->lock);
+    for (;;) {
+        const bool fresh = pl->ready;
+        if (fresh) {
+            nc_snapshot* s = pl->work;
+            pl->work   = pl->queued;
+            pl->queued = s;
+            pl->ready  = false;
+        } else if (!(pl->owed && pl->retry)) {
+            if (pl->stopping) break;
+            if (pl->owed && !nc->headless && nc->outfd >= 0) {
+                // Wait for the terminal to take more, without the lock
+                pthread_mutex_unlock(&pl->lock);
+                struct pollfd pfd = { .fd = nc->outfd, .events = POLLOUT };
+                const bool writable = poll(&pfd, 1, NC_PIPELINE_POLL_MS) > 0;
+                pthread_mutex_lock(&pl->lock);
+                pl->retry |= writable;
+            } else {
+                pthread_cond_wait(&pl->cond, &pl->lock);
+            }
+            continue;
+        }
+        pl->retry = false;
+        pl->busy  = true;
+        const uint64_t superseded = pl->superseded;
+        pl->superseded = 0;
+        pthread_mutex_unlock(&pl->lock);
+
+        nc_snapshot* s = pl->work;
+        nc->stats.frames_dropped += superseded;
+        if (s->repaint) {
+            nc->repaint = true;
+            s->repaint  = false;
+        }
+        // As a synchronous render, the frame waits while the terminal is
+        // still taking the last one; the next frame replaces it
+        const bool sent = nc_flush_pending(nc);
+        if (sent) nc_present(nc, s->cells, &s->pool, s->rows, s->cols);
+        else if (fresh) nc->stats.frames_dropped++;
+
+        pthread_mutex_lock(&pl->lock);
+        pl->owed = !sent;
+        pl->busy = false;
+        pthread_cond_broadcast(&pl->cond);
+    }
+    pthread_mutex_unlock(&pl->lock);
+    return NULL;
+}
+
+bool nc_pipeline_start(struct notcurses* nc) {
+    nc_pipeline* pl = calloc(1, sizeof(*pl));
+    if (!pl) return false;
+    pl->fill   = &pl->snaps[0];
+    pl->queued = &pl->snaps[1];
+    pl->work   = &pl->snaps[2];
+    pthread_mutex_init(&pl->lock, NULL);
+    pthread_cond_init(&pl->cond, NULL);
+    nc->pipeline = pl;
+    if (pthread_create(&pl->thread, NULL, render_main, nc) != 0) {
+        nc->pipeline = NULL;
+        pthread_cond_destroy(&pl->cond);
+        pthread_mutex_destroy(&pl->lock);
+        free(pl);
+        return false;
+    }
+    return true;
+}
+
+// Write the queued frame, stop the thread and free the snapshots.  A frame
+// still owed is left to the synchronous catch-up.
+void nc_pipeline_stop(struct notcurses* nc) {
+    nc_pipeline* pl = nc->pipeline;
+    if (!pl) return;
+    pthread_mutex_lock(&pl->lock);
+    pl->stopping = true;
+    pthread_cond_broadcast(&pl->cond);
+    pthread_mutex_unlock(&pl->lock);
+    pthread_join(pl->thread, NULL);
+
+    if (pl->owed) nc->owed = true;
+    for (int i = 0; i < 3; i++) {
+        free(pl->snaps[i].cells);
+        nc_egcpool_free(&pl->snaps[i].pool);
+    }
+    pthread_cond_destroy(&pl->cond);
+    pthread_mutex_destroy(&pl->lock);
+    free(pl);
+    nc->pipeline = NULL;
+}
+
+// Copy the composited frame and queue it, replacing a frame the thread
+// has not taken yet.
+bool nc_pipeline_submit(struct notcurses* nc, bool repaint) {
+    nc_pipeline* pl = nc->pipeline;
+    const nc_egcpool* pool;
+    const nc_cell* frame = nc_composite(nc, &pool);
+    if (!frame) return false;
+
+    nc_snapshot* s = pl->fill;
+    const unsigned rows = nc->stdplane->rows;
+    const unsigned cols = nc->stdplane->cols;
+    const size_t count = (size_t)rows * cols;
+    if (s->cap < count) {
+        nc_cell* cells = realloc(s->cells, count * sizeof(nc_cell));
+        if (!cells) return false;
+        s->cells = cells;
+        s->cap   = count;
+    }
+    if (!nc_egcpool_copy(&s->pool, pool)) return false;
+    memcpy(s->cells, frame, count * sizeof(nc_cell));
+    s->rows    = rows;
+    s->cols    = cols;
+    s->repaint = repaint;
+
+    pthread_mutex_lock(&pl->lock);
+    if (pl->ready) {
+        pl->superseded++;
+        s->repaint |= pl->queued->repaint;
+    }
+    pl->fill   = pl->queued;
+    pl->queued = s;
+    pl->ready  = true;
+    pthread_cond_broadcast(&pl->cond);
+    pthread_mutex_unlock(&pl->lock);
+    return true;
+}
+
+// Wait for the frames submitted so far to be written or dropped, and keep
+// the thread off the render state until nc_pipeline_release().
+void nc_pipeline_hold(nc_pipeline* pl) {
+    if (!pl) return;
+    pthread_mutex_lock(&pl->lock);
+    while (pl->busy || pl->ready || (pl->owed && pl->retry)) {
+        pthread_cond_wait(&pl->cond, &pl->lock);
+    }
+}
+
+void nc_pipeline_release(nc_pipeline* pl) {
+    if (pl) pthread_mutex_unlock(&pl->lock);
+}
+
+// Have the thread try an owed frame again, as the output may have room
+// for it now.  Does not wait.
+void nc_pipeline_retry(nc_pipeline* pl) {
+    pthread_mutex_lock(&pl->lock);
+    if (pl->owed) {
+        pl->retry = true;
+        pthread_cond_broadcast(&pl->cond);
+    }
+    pthread_mutex_unlock(&pl->lock);
+}
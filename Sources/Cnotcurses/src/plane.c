@@ -1,5 +1,32 @@
 #include "internal.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// Z-order list — planes are painted from nc->bottom up to nc->top
+// ---------------------------------------------------------------------------
+
+void nc_zorder_push_top(struct notcurses* nc, struct ncplane* n) {
+    n->above = NULL;
+    n->below = nc->top;
+    if (nc->top) nc->top->above = n;
+    else         nc->bottom = n;
+    nc->top = n;
+}
+
+void nc_zorder_unlink(struct notcurses* nc, struct ncplane* n) {
+    if (n->above) n->above->below = n->below;
+    else          nc->top = n->below;
+    if (n->below) n->below->above = n->above;
+    else          nc->bottom = n->above;
+    n->above = NULL;
+    n->below = NULL;
+}
+
 // ---------------------------------------------------------------------------
 // ncplane_create
 // ---------------------------------------------------------------------------
@@ -18,70 +45,277 @@ struct ncplane* ncplane_create(struct ncplane* parent,
     n->parent = parent;
     n->nc     = parent->nc;
     nc_plane_init_cells(n);
+    if (!n->cells) {
+        free(n);
+        return NULL;
+    }
+    nc_zorder_push_top(n->nc, n);
 
     return n;
 }
 
 // ---------------------------------------------------------------------------
-// ncplane_destroy
+// ncplane_create_offscreen — a plane of n's context that is never
+// composited.  It is drawn into like any plane and reaches the screen only
+// through ncplane_blit().
+// ---------------------------------------------------------------------------
+
+struct ncplane* ncplane_create_offscreen(const struct ncplane* n,
+                                         unsigned rows, unsigned cols) {
+    if (!n) return NULL;
+
+    struct ncplane* o = calloc(1, sizeof(struct ncplane));
+    if (!o) return NULL;
+
+    o->rows      = rows > 0 ? rows : 1;
+    o->cols      = cols > 0 ? cols : 1;
+    o->nc        = n->nc;
+    o->offscreen = true;
+    nc_plane_init_cells(o);
+    if (!o->cells) {
+        free(o);
+        return NULL;
+    }
+    return o;
+}
+
+// ---------------------------------------------------------------------------
+// ncplane_destroy — children are reparented and keep their screen position
 // ---------------------------------------------------------------------------
 
 int ncplane_destroy(struct ncplane* n) {
     if (!n) return -1;
+    if (n->offscreen) {
+        nc_plane_free_cells(n);
+        free(n);
+        return 0;
+    }
+    if (n == n->nc->stdplane) return -1;
+    struct notcurses* nc = n->nc;
+    nc_zorder_unlink(nc, n);
+    for (struct ncplane* p = nc->bottom; p; p = p->above) {
+        if (p->parent == n) {
+            p->parent = n->parent;
+            p->y += n->y;
+            p->x += n->x;
+        }
+    }
     nc_plane_free_cells(n);
     free(n);
     return 0;
 }
 
 // ---------------------------------------------------------------------------
-// ncplane_putstr — write a string starting at the cursor position
+// ncplane_putstr / ncplane_putnstr — write a string starting at the cursor
+// position, one grapheme cluster per column, stopping at the end of the
+// row.  ncplane_putnstr reads at most len bytes and needs no terminator.
 // Returns the number of columns written, or -1 on error.
 // ---------------------------------------------------------------------------
 
+// Rebuild the pool from the clusters cells still reference, dropping those
+// of overwritten cells.
+static void plane_compact_pool(struct ncplane* n) {
+    nc_egcpool fresh = { 0 };
+    const size_t count = (size_t)n->rows * n->cols;
+    for (size_t i = 0; i < count; i++) {
+        nc_cell* cell = &n->cells[i];
+        if ((unsigned char)cell->gcluster[0] != NC_EGC_POOLED) continue;
+        size_t len;
+        const char* egc = nc_cell_egc(cell, &n->pool, &len);
+        nc_cell_set_egc(cell, &fresh, egc, len);
+    }
+    nc_egcpool_free(&n->pool);
+    n->pool = fresh;
+}
+
+static void plane_set_egc(struct ncplane* n, nc_cell* cell,
+                          const unsigned char* egc, size_t len) {
+    if (!nc_cell_set_egc(cell, &n->pool, (const char*)egc, len)) {
+        plane_compact_pool(n);
+        nc_cell_set_egc(cell, &n->pool, (const char*)egc, len);
+    }
+}
+
+// Number of leading bytes of s, at most len, that are ASCII other than
+// NUL.  Blocks of 16 (8 without SIMD) bytes are tested at once; the block
+// holding the first other byte is finished one byte at a time.
+static size_t ascii_run(const unsigned char* s, size_t len) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+        // High bit set in bytes >= 0x80 and, after the compare, in NULs
+        int stop = _mm_movemask_epi8(_mm_or_si128(v, _mm_cmpeq_epi8(v, zero)));
+        if (stop) return i + (size_t)__builtin_ctz((unsigned)stop);
+    }
+#elif defined(__aarch64__)
+    const uint8x16_t one = vdupq_n_u8(1);
+    const uint8x16_t limit = vdupq_n_u8(0x7E);
+    for (; i + 16 <= len; i += 16) {
+        // NUL wraps to 0xFF, so both it and bytes >= 0x80 exceed the limit
+        uint8x16_t v = vsubq_u8(vld1q_u8(s + i), one);
+        if (vmaxvq_u8(vcgtq_u8(v, limit))) break;
+    }
+#else
+    const uint64_t ones = 0x0101010101010101ull;
+    const uint64_t highs = 0x8080808080808080ull;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t w;
+        memcpy(&w, s + i, sizeof(w));
+        if ((w | ((w - ones) & ~w)) & highs) break;
+    }
+#endif
+    while (i < len && (unsigned)(s[i] - 1) < 0x7Fu) i++;
+    return i;
+}
+
+// Write count cells that differ from tmpl, whose glyph is empty, only in
+// holding the ASCII byte s[i].  The template stays in a vector register;
+// written out field by field the compiler rebuilds it for every cell.
+static void stamp_ascii(nc_cell* dst, const nc_cell* tmpl,
+                        const unsigned char* s, size_t count) {
+#if defined(__SSE2__)
+    const __m128i t = _mm_loadu_si128((const __m128i*)tmpl);
+    for (size_t i = 0; i < count; i++) {
+        _mm_storeu_si128((__m128i*)&dst[i], _mm_or_si128(t, _mm_cvtsi32_si128(s[i])));
+    }
+#elif defined(__aarch64__)
+    const uint8x16_t t = vld1q_u8((const uint8_t*)tmpl);
+    for (size_t i = 0; i < count; i++) {
+        vst1q_u8((uint8_t*)&dst[i], vsetq_lane_u8(s[i], t, 0));
+    }
+#else
+    for (size_t i = 0; i < count; i++) {
+        memcpy(&dst[i], tmpl, sizeof(nc_cell));
+        dst[i].gcluster[0] = (char)s[i];
+    }
+#endif
+}
+
+// A cell in the plane's current drawing state, without a glyph.
+static nc_cell plane_template(const struct ncplane* n) {
+    return (nc_cell){
+        .fg     = n->fg_set ? n->fg_rgb : NC_DEFAULT_RGB,
+        .bg     = n->bg_set ? n->bg_rgb : NC_DEFAULT_RGB,
+        .styles = (uint16_t)n->styles,
+        .flags  = NC_CELL_WRITTEN,
+    };
+}
+
 int ncplane_putstr(struct ncplane* n, const char* s) {
     if (!n || !s) return -1;
+    return ncplane_putnstr(n, strlen(s), s);
+}
 
-    int written = 0;
-    const unsigned char* p = (const unsigned char*)s;
+// Write len bytes of s with the look of tmpl from column x of row y, which
+// must be on the plane.  Returns the column after the last cell written.
+static unsigned plane_put(struct ncplane* n, const nc_cell* tmpl, unsigned y,
+                          unsigned x, const unsigned char* p, size_t len) {
+    nc_cell* row = &n->cells[(size_t)y * n->cols];
+    const unsigned cols = n->cols;
+    const unsigned char* end = p + len;
 
-    while (*p) {
-        if (n->cursor_y < 0 || (unsigned)n->cursor_y >= n->rows ||
-            n->cursor_x < 0 || (unsigned)n->cursor_x >= n->cols) {
-            break;  // Out of bounds
+    while (p < end && x < cols && *p) {
+        // Stamp a run of ASCII a block at a time.  One byte past the row
+        // is scanned so a full row needs no lookahead; the last byte
+        // before other text is held back, as a combining mark may follow.
+        const size_t room = cols - x;
+        const size_t limit = (size_t)(end - p) < room + 1 ? (size_t)(end - p) : room + 1;
+        size_t run = ascii_run(p, limit);
+        if (run > 0 && run < limit && p[run] != 0) run--;
+        if (run > room) run = room;
+        if (run > 0) {
+            stamp_ascii(row + x, tmpl, p, run);
+            p += run;
+            x += (unsigned)run;
+            continue;
         }
 
-        nc_cell* cell = &n->cells[n->cursor_y * n->cols + n->cursor_x];
+        size_t egclen = nc_egc_length(p, (size_t)(end - p));
+        row[x] = *tmpl;
+        plane_set_egc(n, &row[x], p, egclen);
+        p += egclen;
+        x++;
+    }
+    return x;
+}
 
-        // Determine UTF-8 byte length for this codepoint
-        int byte_len;
-        if (*p < 0x80)       byte_len = 1;
-        else if (*p < 0xE0)  byte_len = 2;
-        else if (*p < 0xF0)  byte_len = 3;
-        else                 byte_len = 4;
+int ncplane_putnstr(struct ncplane* n, size_t len, const char* s) {
+    if (!n || !s) return -1;
+    if (n->cursor_y < 0 || (unsigned)n->cursor_y >= n->rows ||
+        n->cursor_x < 0 || (unsigned)n->cursor_x >= n->cols) {
+        return 0;  // Out of bounds
+    }
 
-        // Copy bytes into cell gcluster
-        int i;
-        for (i = 0; i < byte_len && p[i]; i++) {
-            cell->gcluster[i] = (char)p[i];
-        }
-        cell->gcluster[i] = '\0';
+    const nc_cell tmpl = plane_template(n);
+    const unsigned start = (unsigned)n->cursor_x;
+    const unsigned x = plane_put(n, &tmpl, (unsigned)n->cursor_y, start,
+                                 (const unsigned char*)s, len);
+    n->cursor_x = (int)x;
+    return (int)(x - start);
+}
 
-        // Apply current plane state to cell
-        cell->fg_rgb  = n->fg_rgb;
-        cell->bg_rgb  = n->bg_rgb;
-        cell->styles  = n->styles;
-        cell->fg_set  = n->fg_set;
-        cell->bg_set  = n->bg_set;
-        cell->written = true;
+// ---------------------------------------------------------------------------
+// ncplane_putspans — write a batch of styled runs of text.  Each span
+// carries its own position and look, so a frame's text crosses into C in
+// one call; the plane's cursor and drawing state are left alone.  Spans
+// starting off the plane are skipped.  Returns the number of columns
+// written, or -1 on error.
+// ---------------------------------------------------------------------------
 
-        p += byte_len;
-        n->cursor_x++;
-        written++;
+int ncplane_putspans(struct ncplane* n, const ncspan* spans, size_t count) {
+    if (!n || (!spans && count)) return -1;
+    int written = 0;
+    for (size_t i = 0; i < count; i++) {
+        const ncspan* sp = &spans[i];
+        if (sp->y < 0 || (unsigned)sp->y >= n->rows ||
+            sp->x < 0 || (unsigned)sp->x >= n->cols || !sp->len || !sp->utf8) {
+            continue;
+        }
+        const nc_cell tmpl = {
+            .fg     = sp->fg == NC_DEFAULT_RGB ? NC_DEFAULT_RGB : sp->fg & 0xFFFFFFu,
+            .bg     = sp->bg == NC_DEFAULT_RGB ? NC_DEFAULT_RGB : sp->bg & 0xFFFFFFu,
+            .styles = (uint16_t)sp->styles,
+            .flags  = NC_CELL_WRITTEN,
+        };
+        const unsigned x = plane_put(n, &tmpl, (unsigned)sp->y, (unsigned)sp->x,
+                                     (const unsigned char*)sp->utf8, sp->len);
+        written += (int)(x - (unsigned)sp->x);
     }
-
     return written;
 }
 
+// ---------------------------------------------------------------------------
+// ncplane_fill — write the first cluster of egc in the plane's drawing
+// state to every cell of a rectangle, clipped to the plane.  The cursor
+// does not move.  Returns the number of cells written, or -1 on error.
+// ---------------------------------------------------------------------------
+
+int ncplane_fill(struct ncplane* n, int y, int x, unsigned rows, unsigned cols,
+                 const char* egc) {
+    if (!n || !egc || !*egc) return -1;
+    const long top    = y < 0 ? 0 : y;
+    const long left   = x < 0 ? 0 : x;
+    const long bottom = (long)y + rows < (long)n->rows ? (long)y + rows : (long)n->rows;
+    const long right  = (long)x + cols < (long)n->cols ? (long)x + cols : (long)n->cols;
+    if (top >= bottom || left >= right) return 0;
+
+    // A pooled cluster is stored once and shared by every cell
+    const size_t egclen = nc_egc_length((const unsigned char*)egc, strlen(egc));
+    nc_cell cell = plane_template(n);
+    plane_set_egc(n, &cell, (const unsigned char*)egc, egclen);
+
+    const size_t width = (size_t)(right - left);
+    for (long r = top; r < bottom; r++) {
+        nc_cell* dst = &n->cells[(size_t)r * n->cols + (size_t)left];
+        for (size_t i = 0; i < width; i++) {
+            dst[i] = cell;
+        }
+    }
+    return (int)((size_t)(bottom - top) * width);
+}
+
 // ---------------------------------------------------------------------------
 // ncplane_cursor_move_yx
 // ---------------------------------------------------------------------------
@@ -131,6 +365,7 @@ void ncplane_erase(struct ncplane* n) {
     if (!n) return;
     size_t count = (size_t)n->rows * n->cols;
     memset(n->cells, 0, count * sizeof(nc_cell));
+    nc_egcpool_clear(&n->pool);
     n->cursor_y = 0;
     n->cursor_x = 0;
     n->fg_set   = false;
@@ -138,6 +373,136 @@ void ncplane_erase(struct ncplane* n) {
     n->styles   = 0;
 }
 
+// ---------------------------------------------------------------------------
+// ncplane_scrollup — shift content up r rows, blanking the rows exposed at
+// the bottom.  The renderer turns the shift into a terminal scroll.
+// ---------------------------------------------------------------------------
+
+int ncplane_scrollup(struct ncplane* n, int r) {
+    if (!n || r < 0) return -1;
+    const size_t rowcells = n->cols;
+    const unsigned shift = (unsigned)r < n->rows ? (unsigned)r : n->rows;
+    const unsigned kept = n->rows - shift;
+    memmove(n->cells, n->cells + shift * rowcells, kept * rowcells * sizeof(nc_cell));
+    memset(n->cells + kept * rowcells, 0, shift * rowcells * sizeof(nc_cell));
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// ncplane_blit — copy all of src onto dst with its top-left corner at (y, x)
+// of dst, clipped to dst.  Each row is one memcpy; long clusters are then
+// moved into dst's pool.  The copy is opaque: cells src never wrote blank
+// the cells beneath them.
+// ---------------------------------------------------------------------------
+
+int ncplane_blit(const struct ncplane* src, struct ncplane* dst, int y, int x) {
+    if (!src || !dst || src == dst) return -1;
+    const int top    = y > 0 ? y : 0;
+    const int left   = x > 0 ? x : 0;
+    const long b     = (long)y + src->rows;
+    const long r     = (long)x + src->cols;
+    const int bottom = b < (long)dst->rows ? (int)b : (int)dst->rows;
+    const int right  = r < (long)dst->cols ? (int)r : (int)dst->cols;
+    if (top >= bottom || left >= right) return 0;
+
+    const size_t width = (size_t)(right - left);
+    for (int row = top; row < bottom; row++) {
+        const nc_cell* from = &src->cells[(size_t)(row - y) * src->cols + (left - x)];
+        nc_cell* to = &dst->cells[(size_t)row * dst->cols + left];
+        memcpy(to, from, width * sizeof(nc_cell));
+        if (src->pool.len == 0) continue;
+        // Drop the references into src's pool first, as storing a cluster
+        // may compact dst's pool, which reads every cell of dst
+        bool pooled = false;
+        for (size_t i = 0; i < width; i++) {
+            if ((unsigned char)from[i].gcluster[0] != NC_EGC_POOLED) continue;
+            memset(to[i].gcluster, 0, NC_EGC_INLINE);
+            pooled = true;
+        }
+        for (size_t i = 0; pooled && i < width; i++) {
+            if ((unsigned char)from[i].gcluster[0] != NC_EGC_POOLED) continue;
+            size_t len;
+            const char* egc = nc_cell_egc(&from[i], &src->pool, &len);
+            plane_set_egc(dst, &to[i], (const unsigned char*)egc, len);
+        }
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// ncplane_move_yx / ncplane_yx — position relative to the parent plane
+// ---------------------------------------------------------------------------
+
+int ncplane_move_yx(struct ncplane* n, int y, int x) {
+    if (!n || n->offscreen || n == n->nc->stdplane) return -1;
+    n->y = y;
+    n->x = x;
+    return 0;
+}
+
+void ncplane_yx(const struct ncplane* n, int* y, int* x) {
+    if (!n) return;
+    if (y) *y = n->y;
+    if (x) *x = n->x;
+}
+
+// ---------------------------------------------------------------------------
+// Z-order manipulation
+// ---------------------------------------------------------------------------
+
+void ncplane_move_top(struct ncplane* n) {
+    if (!n || n->offscreen) return;
+    nc_zorder_unlink(n->nc, n);
+    nc_zorder_push_top(n->nc, n);
+}
+
+void ncplane_move_bottom(struct ncplane* n) {
+    if (!n || n->offscreen) return;
+    struct notcurses* nc = n->nc;
+    nc_zorder_unlink(nc, n);
+    n->below = NULL;
+    n->above = nc->bottom;
+    if (nc->bottom) nc->bottom->below = n;
+    else            nc->top = n;
+    nc->bottom = n;
+}
+
+// Place n directly above target.
+int ncplane_move_above(struct ncplane* n, struct ncplane* target) {
+    if (!n || !target || n == target || n->nc != target->nc) return -1;
+    if (n->offscreen || target->offscreen) return -1;
+    struct notcurses* nc = n->nc;
+    nc_zorder_unlink(nc, n);
+    n->below = target;
+    n->above = target->above;
+    if (target->above) target->above->below = n;
+    else               nc->top = n;
+    target->above = n;
+    return 0;
+}
+
+// Place n directly below target.
+int ncplane_move_below(struct ncplane* n, struct ncplane* target) {
+    if (!n || !target || n == target || n->nc != target->nc) return -1;
+    if (n->offscreen || target->offscreen) return -1;
+    struct notcurses* nc = n->nc;
+    nc_zorder_unlink(nc, n);
+    n->above = target;
+    n->below = target->below;
+    if (target->below) target->below->above = n;
+    else               nc->bottom = n;
+    target->below = n;
+    return 0;
+}
+
+struct ncplane* ncplane_above(struct ncplane* n) {
+    return n ? n->above : NULL;
+}
+
+struct ncplane* ncplane_below(struct ncplane* n) {
+    return n ? n->below : NULL;
+}
+
 // ---------------------------------------------------------------------------
 // ncplane_dim_yx
 // ---------------------------------------------------------------------------
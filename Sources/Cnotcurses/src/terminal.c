@@ -1,4 +1,6 @@
 #include "internal.h"
+#include <fcntl.h>
+#include <errno.h>
 
 // ---------------------------------------------------------------------------
 // SIGWINCH handling
@@ -12,22 +14,125 @@ static void sigwinch_handler(int sig) {
 }
 
 // ---------------------------------------------------------------------------
-// notcurses_init
+// Context setup shared by terminal and headless contexts
 // ---------------------------------------------------------------------------
 
-struct notcurses* notcurses_init(const notcurses_options* opts, FILE* fp) {
+static bool make_pipe(int fds[2]) {
+    if (pipe(fds) != 0) {
+        fds[0] = fds[1] = -1;
+        return false;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+        fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+    }
+    return true;
+}
+
+// A context of the given size with its standard plane, before any
+// terminal setup.
+static struct notcurses* nc_create(const notcurses_options* opts,
+                                   unsigned rows, unsigned cols) {
     struct notcurses* nc = calloc(1, sizeof(struct notcurses));
     if (!nc) return NULL;
+    nc->flags    = opts ? opts->flags : 0;
+    nc->rows     = rows;
+    nc->cols     = cols;
+    nc->infd     = STDIN_FILENO;
+    nc->outfd    = -1;
+    nc->injectfd = -1;
+    nc_input_init(&nc->input);
+    nc->palette.colors = NCCOLORS_RGB;
 
-    nc->fp    = fp ? fp : stdout;
-    nc->flags = opts ? opts->flags : 0;
+    nc->stdplane = calloc(1, sizeof(struct ncplane));
+    if (!nc->stdplane) {
+        free(nc);
+        return NULL;
+    }
+    nc->stdplane->rows   = nc->rows;
+    nc->stdplane->cols   = nc->cols;
+    nc->stdplane->y      = 0;
+    nc->stdplane->x      = 0;
+    nc->stdplane->parent = NULL;
+    nc->stdplane->nc     = nc;
+    nc_plane_init_cells(nc->stdplane);
+    nc_zorder_push_top(nc, nc->stdplane);
+
+    // Self-pipe for notcurses_wake(); without it waking is unsupported
+    make_pipe(nc->wakefd);
+    return nc;
+}
 
+// Stop the encoding threads and free their buffers.
+static void free_bands(struct notcurses* nc) {
+    nc_workers_destroy(nc->encoders);
+    for (unsigned i = 0; i < nc->nbands; i++) nc_out_free(&nc->bands[i].out);
+    free(nc->bands);
+    nc->encoders = NULL;
+    nc->bands    = NULL;
+    nc->nbands   = 0;
+}
+
+// Free a context and every plane, including the stdplane.
+static void nc_free(struct notcurses* nc) {
+    struct ncplane* p = nc->bottom;
+    while (p) {
+        struct ncplane* above = p->above;
+        nc_plane_free_cells(p);
+        free(p);
+        p = above;
+    }
+    free(nc->frame);
+    free(nc->lastframe);
+    free(nc->framehash);
+    free(nc->lasthash);
+    nc_egcpool_free(&nc->framepool);
+    nc_egcpool_free(&nc->lastpool);
+    nc_out_free(&nc->out);
+    nc_out_free(&nc->sink);
+    nc_out_free(&nc->pending);
+    nc_input_free(&nc->input);
+    nc_palette_free(&nc->palette);
+    free_bands(nc);
+    if (nc->wakefd[0] >= 0) {
+        close(nc->wakefd[0]);
+        close(nc->wakefd[1]);
+    }
+    if (nc->headless && nc->infd >= 0) {
+        close(nc->infd);
+        close(nc->injectfd);
+    }
+    if (nc->outfd >= 0) close(nc->outfd);
+    free(nc);
+}
+
+// The terminal size, unless the context is headless and keeps its own.
+static void refresh_size(struct notcurses* nc) {
+    if (!nc->headless) nc_get_terminal_size(&nc->rows, &nc->cols);
+}
+
+// ---------------------------------------------------------------------------
+// notcurses_init
+// ---------------------------------------------------------------------------
+
+struct notcurses* notcurses_init(const notcurses_options* opts, FILE* fp) {
     // Query terminal dimensions
-    nc_get_terminal_size(&nc->rows, &nc->cols);
+    unsigned rows, cols;
+    nc_get_terminal_size(&rows, &cols);
+
+    struct notcurses* nc = nc_create(opts, rows, cols);
+    if (!nc) return NULL;
+    nc->fp = fp ? fp : stdout;
+
+    // Encode colors as the environment says the terminal can show them
+    if (!nc_palette_set(&nc->palette, notcurses_detect_colors(getenv("TERM"), getenv("COLORTERM")))) {
+        nc_free(nc);
+        return NULL;
+    }
 
     // Save current terminal settings
     if (tcgetattr(STDIN_FILENO, &nc->original) != 0) {
-        free(nc);
+        nc_free(nc);
         return NULL;
     }
 
@@ -40,7 +145,7 @@ struct notcurses* notcurses_init(const notcurses_options* opts, FILE* fp) {
     raw.c_cc[VMIN]  = 0;
     raw.c_cc[VTIME] = 0;
     if (tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw) != 0) {
-        free(nc);
+        nc_free(nc);
         return NULL;
     }
 
@@ -50,10 +155,20 @@ struct notcurses* notcurses_init(const notcurses_options* opts, FILE* fp) {
         nc->alt_screen = true;
     }
 
-    // Hide cursor, clear screen
-    fprintf(nc->fp, "\033[?25l\033[2J\033[H");
+    // Hide cursor, clear screen, report pastes between markers
+    fprintf(nc->fp, "\033[?25l\033[2J\033[H\033[?2004h");
     fflush(nc->fp);
 
+    // Frames are written without blocking, so a stalled link cannot freeze
+    // the caller.  The terminal is opened again for them: O_NONBLOCK on
+    // the stream's own descriptor would reach every process sharing it.
+    // Output that is not a terminal is written through the stream.
+    const int streamfd = fileno(nc->fp);
+    const char* tty = streamfd >= 0 && isatty(streamfd) ? ttyname(streamfd) : NULL;
+    if (tty) {
+        nc->outfd = open(tty, O_WRONLY | O_NONBLOCK | O_NOCTTY | O_CLOEXEC);
+    }
+
     // Install SIGWINCH handler
     struct sigaction sa;
     memset(&sa, 0, sizeof(sa));
@@ -61,79 +176,427 @@ struct notcurses* notcurses_init(const notcurses_options* opts, FILE* fp) {
     sa.sa_flags   = SA_RESTART;
     sigaction(SIGWINCH, &sa, NULL);
 
-    // Create the standard plane
-    nc->stdplane = calloc(1, sizeof(struct ncplane));
-    if (!nc->stdplane) {
-        tcsetattr(STDIN_FILENO, TCSAFLUSH, &nc->original);
-        free(nc);
+    return nc;
+}
+
+// ---------------------------------------------------------------------------
+// notcurses_init_headless — no terminal: output collects in memory and
+// input comes from a pipe fed by notcurses_inject()
+// ---------------------------------------------------------------------------
+
+struct notcurses* notcurses_init_headless(const notcurses_options* opts,
+                                          unsigned rows, unsigned cols) {
+    if (rows == 0 || cols == 0) return NULL;
+    struct notcurses* nc = nc_create(opts, rows, cols);
+    if (!nc) return NULL;
+    nc->headless = true;
+
+    int fds[2];
+    if (!make_pipe(fds)) {
+        nc->infd = -1;
+        nc_free(nc);
         return NULL;
     }
-    nc->stdplane->rows   = nc->rows;
-    nc->stdplane->cols   = nc->cols;
-    nc->stdplane->y      = 0;
-    nc->stdplane->x      = 0;
-    nc->stdplane->parent = NULL;
-    nc->stdplane->nc     = nc;
-    nc_plane_init_cells(nc->stdplane);
-
+    nc->infd     = fds[0];
+    nc->injectfd = fds[1];
     return nc;
 }
 
+const char* notcurses_output(struct notcurses* nc, size_t* len) {
+    if (!nc || !nc->headless) return NULL;
+    nc_pipeline_hold(nc->pipeline);
+    if (len) *len = nc->sink.len;
+    // An empty sink may not have a buffer yet
+    const char* data = nc->sink.data ? nc->sink.data : "";
+    nc_pipeline_release(nc->pipeline);
+    return data;
+}
+
+char* notcurses_output_take(struct notcurses* nc, size_t* len) {
+    if (len) *len = 0;
+    if (!nc || !nc->headless) return NULL;
+    // Swapped out under the hold, so a frame the render thread writes
+    // next goes into a fresh buffer rather than the one being read
+    nc_pipeline_hold(nc->pipeline);
+    char* data = nc->sink.data;
+    if (len) *len = nc->sink.len;
+    nc->sink.data = NULL;
+    nc->sink.len = 0;
+    nc->sink.cap = 0;
+    nc_pipeline_release(nc->pipeline);
+    return data;
+}
+
+void notcurses_output_clear(struct notcurses* nc) {
+    if (!nc || !nc->headless) return;
+    nc_pipeline_hold(nc->pipeline);
+    nc->sink.len = 0;
+    nc_pipeline_release(nc->pipeline);
+}
+
+int notcurses_inject(struct notcurses* nc, const char* bytes, size_t len) {
+    if (!nc || !nc->headless || !bytes) return -1;
+    size_t queued = 0;
+    while (queued < len) {
+        ssize_t n = write(nc->injectfd, bytes + queued, len - queued);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;   // EAGAIN: the pipe is full
+        }
+        queued += (size_t)n;
+    }
+    return (int)queued;
+}
+
+void notcurses_set_output_limit(struct notcurses* nc, size_t limit) {
+    if (!nc || !nc->headless) return;
+    nc_pipeline_hold(nc->pipeline);
+    nc->sinklimit = limit;
+    nc_pipeline_release(nc->pipeline);
+}
+
+void notcurses_set_pending_limit(struct notcurses* nc, size_t limit) {
+    if (!nc) return;
+    nc_pipeline_hold(nc->pipeline);
+    nc->pending.limit = limit;
+    nc_pipeline_release(nc->pipeline);
+}
+
+size_t notcurses_output_pending(const struct notcurses* nc) {
+    if (!nc) return 0;
+    nc_pipeline_hold(nc->pipeline);
+    const size_t pending = nc->pending.len - nc->pendingoff;
+    nc_pipeline_release(nc->pipeline);
+    return pending;
+}
+
 // ---------------------------------------------------------------------------
-// notcurses_stop
+// Encoding threads — bands of a full repaint are encoded in parallel
 // ---------------------------------------------------------------------------
 
-int notcurses_stop(struct notcurses* nc) {
+int notcurses_set_encode_threads(struct notcurses* nc, unsigned threads) {
     if (!nc) return -1;
+    if (threads < 1) threads = 1;
+    if (threads > NC_ENCODE_THREADS_MAX) threads = NC_ENCODE_THREADS_MAX;
+    nc_pipeline_hold(nc->pipeline);
+    int ret = 0;
+    if (threads != notcurses_encode_threads(nc)) {
+        free_bands(nc);
+        if (threads > 1) {
+            nc->bands    = calloc(threads, sizeof(nc_band));
+            nc->encoders = nc->bands ? nc_workers_create(threads - 1) : NULL;
+            if (nc->encoders) {
+                nc->nbands = threads;
+            } else {
+                free(nc->bands);
+                nc->bands = NULL;
+                ret = -1;
+            }
+        }
+    }
+    nc_pipeline_release(nc->pipeline);
+    return ret;
+}
 
-    // Reset attributes, show cursor
-    fprintf(nc->fp, "\033[0m\033[?25h");
+unsigned notcurses_encode_threads(const struct notcurses* nc) {
+    return nc && nc->nbands ? nc->nbands : 1;
+}
 
-    // Leave alternate screen
-    if (nc->alt_screen) {
-        fprintf(nc->fp, "\033[?1049l");
+// ---------------------------------------------------------------------------
+// Output — written without blocking; what the terminal does not take is
+// kept in pending and sent ahead of anything else
+// ---------------------------------------------------------------------------
+
+// Write as much as the terminal, or the sink of a headless context, takes
+// right now.  Returns the number of bytes taken.
+static size_t out_try(struct notcurses* nc, const char* data, size_t len) {
+    if (nc->headless) {
+        size_t room = len;
+        if (nc->sinklimit) {
+            room = nc->sink.len < nc->sinklimit ? nc->sinklimit - nc->sink.len : 0;
+            if (room > len) room = len;
+        }
+        if (!room || !nc_out_reserve(&nc->sink, room)) return 0;
+        memcpy(nc->sink.data + nc->sink.len, data, room);
+        nc->sink.len += room;
+        return room;
+    }
+    if (nc->outfd < 0) {
+        // Not a terminal: all that is left is a blocking stream
+        fwrite(data, 1, len, nc->fp);
+        fflush(nc->fp);
+        return len;
+    }
+    size_t done = 0;
+    while (done < len) {
+        const ssize_t n = write(nc->outfd, data + done, len - done);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;   // EAGAIN: the terminal is not keeping up
+        }
+        done += (size_t)n;
     }
+    return done;
+}
 
-    // Clear screen and home cursor so the shell prompt starts cleanly
-    fprintf(nc->fp, "\033[2J\033[H");
-    fflush(nc->fp);
+// As out_try() for the pieces of iov in turn, with one writev() to a
+// terminal.  Returns the number of bytes taken.
+static size_t out_tryv(struct notcurses* nc, const struct iovec* iov, int count) {
+    size_t done = 0;
+    int i = 0;
+    if (!nc->headless && nc->outfd >= 0) {
+        ssize_t n;
+        do {
+            n = writev(nc->outfd, iov, count);
+        } while (n < 0 && errno == EINTR);
+        if (n <= 0) return 0;
+        done = (size_t)n;
+        // A short write leaves the rest to out_try(), which stops at EAGAIN
+        while (i < count && (size_t)n >= iov[i].iov_len) n -= (ssize_t)iov[i++].iov_len;
+        if (i == count) return done;
+        const size_t rest = iov[i].iov_len - (size_t)n;
+        const size_t taken = out_try(nc, (const char*)iov[i].iov_base + n, rest);
+        done += taken;
+        if (taken < rest) return done;
+        i++;
+    }
+    for (; i < count; i++) {
+        const size_t taken = out_try(nc, iov[i].iov_base, iov[i].iov_len);
+        done += taken;
+        if (taken < iov[i].iov_len) break;
+    }
+    return done;
+}
 
-    // Restore terminal settings
-    tcsetattr(STDIN_FILENO, TCSAFLUSH, &nc->original);
+// Hand encoded bytes to the terminal, keeping what it does not take.
+void nc_write_out(struct notcurses* nc, const char* data, size_t len) {
+    const struct iovec iov = { .iov_base = (void*)data, .iov_len = len };
+    nc_write_outv(nc, &iov, 1);
+}
 
-    // Free stdplane
-    if (nc->stdplane) {
-        nc_plane_free_cells(nc->stdplane);
-        free(nc->stdplane);
+// As nc_write_out() for the pieces of iov, back to back.
+void nc_write_outv(struct notcurses* nc, const struct iovec* iov, int count) {
+    size_t skip = 0;   // Bytes already taken
+    if (nc_flush_pending(nc)) {
+        skip = out_tryv(nc, iov, count);
+        while (count && skip >= iov->iov_len) {
+            skip -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (!count) return;
+        nc->pending_since = nc_now_ns();
     }
 
-    free(nc);
+    // The rest goes after whatever is already waiting
+    nc_outbuf* p = &nc->pending;
+    if (nc->pendingoff) {
+        p->len -= nc->pendingoff;
+        memmove(p->data, p->data + nc->pendingoff, p->len);
+        nc->pendingoff = 0;
+    }
+    size_t len = 0;
+    for (int i = 0; i < count; i++) len += iov[i].iov_len;
+    if (!nc_out_reserve(p, len - skip)) {
+        // The bytes are lost, so what the terminal shows is unknown
+        nc->repaint = true;
+        return;
+    }
+    for (int i = 0; i < count; i++, skip = 0) {
+        memcpy(p->data + p->len, (const char*)iov[i].iov_base + skip, iov[i].iov_len - skip);
+        p->len += iov[i].iov_len - skip;
+    }
+}
+
+// Send what is pending.  Returns true once nothing is.
+bool nc_flush_pending(struct notcurses* nc) {
+    nc_outbuf* p = &nc->pending;
+    if (nc->pendingoff == p->len) return true;
+    nc->pendingoff += out_try(nc, p->data + nc->pendingoff, p->len - nc->pendingoff);
+    if (nc->pendingoff < p->len) return false;
+    p->len = 0;
+    nc->pendingoff = 0;
+    nc->stats.stall_ns += nc_now_ns() - nc->pending_since;
+    return true;
+}
+
+// Send what is pending and then the frame dropped while it was, if any.
+// The planes hold the state that frame would have shown.  The render
+// thread catches up on its own, and only needs telling when the sink of a
+// headless context may have room again.
+void nc_catch_up(struct notcurses* nc) {
+    if (nc->pipeline) {
+        nc_pipeline_retry(nc->pipeline);
+        return;
+    }
+    if (nc->owed && nc_flush_pending(nc)) {
+        nc->owed = false;
+        nc_render_frame(nc);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Mouse reporting — the DEC tracking mode that covers the events asked
+// for, with reports in the SGR encoding (1006)
+// ---------------------------------------------------------------------------
+
+// The tracking mode reporting the events of mask, or 0 for none.
+static int mice_mode(unsigned mask) {
+    if (mask & NCMICE_MOVE_EVENT)   return 1003;   // Any motion
+    if (mask & NCMICE_DRAG_EVENT)   return 1002;   // Buttons and drags
+    if (mask & NCMICE_BUTTON_EVENT) return 1000;   // Buttons only
     return 0;
 }
 
+int notcurses_mice_enable(struct notcurses* nc, unsigned eventmask) {
+    if (!nc) return -1;
+    eventmask &= NCMICE_ALL_EVENTS;
+    nc_pipeline_hold(nc->pipeline);
+    const int from = mice_mode(nc->mice);
+    const int to = mice_mode(eventmask);
+    if (!nc->headless && from != to) {
+        // Leave the old mode before entering the new one; the encoding
+        // stays on while any mode is
+        char seq[32];
+        int len = 0;
+        if (from) len += snprintf(seq + len, sizeof(seq) - (size_t)len, "\033[?%dl", from);
+        if (to)   len += snprintf(seq + len, sizeof(seq) - (size_t)len, "\033[?%dh", to);
+        if (!from)    len += snprintf(seq + len, sizeof(seq) - (size_t)len, "\033[?1006h");
+        else if (!to) len += snprintf(seq + len, sizeof(seq) - (size_t)len, "\033[?1006l");
+        nc_write_out(nc, seq, (size_t)len);
+    }
+    nc->mice = eventmask;
+    nc_pipeline_release(nc->pipeline);
+    return 0;
+}
+
+unsigned notcurses_mice_enabled(const struct notcurses* nc) {
+    return nc ? nc->mice : NCMICE_NO_EVENTS;
+}
+
 // ---------------------------------------------------------------------------
-// notcurses_render
+// notcurses_stop
 // ---------------------------------------------------------------------------
 
-int notcurses_render(struct notcurses* nc) {
-    if (!nc || !nc->stdplane) return -1;
+int notcurses_stop(struct notcurses* nc) {
+    if (!nc) return -1;
+    nc_pipeline_stop(nc);
+
+    if (!nc->headless) {
+        // The rest of the last frame first, waiting for the terminal
+        if (nc->outfd >= 0) {
+            fcntl(nc->outfd, F_SETFL, fcntl(nc->outfd, F_GETFL) & ~O_NONBLOCK);
+        }
+        nc_flush_pending(nc);
+
+        // Reset attributes, show cursor, end bracketed paste and whatever
+        // mouse reporting was turned on
+        fprintf(nc->fp, "\033[0m\033[?25h\033[?2004l");
+        const int mice = mice_mode(nc->mice);
+        if (mice) fprintf(nc->fp, "\033[?%dl\033[?1006l", mice);
+
+        // Leave alternate screen
+        if (nc->alt_screen) {
+            fprintf(nc->fp, "\033[?1049l");
+        }
+
+        // Clear screen and home cursor so the shell prompt starts cleanly
+        fprintf(nc->fp, "\033[2J\033[H");
+        fflush(nc->fp);
+
+        // Restore terminal settings
+        tcsetattr(STDIN_FILENO, TCSAFLUSH, &nc->original);
+    }
+
+    nc_free(nc);
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// notcurses_render
+// ---------------------------------------------------------------------------
 
+static int render(struct notcurses* nc, bool repaint) {
     // Check if terminal was resized; if so, resize stdplane to match
-    unsigned new_rows, new_cols;
-    nc_get_terminal_size(&new_rows, &new_cols);
-    if (new_rows != nc->rows || new_cols != nc->cols) {
-        nc->rows = new_rows;
-        nc->cols = new_cols;
-        nc->stdplane->rows = new_rows;
-        nc->stdplane->cols = new_cols;
+    refresh_size(nc);
+    if (nc->stdplane->rows != nc->rows || nc->stdplane->cols != nc->cols) {
+        nc->stdplane->rows = nc->rows;
+        nc->stdplane->cols = nc->cols;
         nc_plane_free_cells(nc->stdplane);
         nc_plane_init_cells(nc->stdplane);
     }
 
-    nc_render_plane(nc, nc->stdplane);
+    // A render thread takes a copy of the frame from here
+    if (nc->pipeline) return nc_pipeline_submit(nc, repaint) ? 0 : -1;
+    if (repaint) nc->repaint = true;
+
+    // While the terminal is still taking the last frame this one is
+    // dropped.  The next frame sent is diffed against the last one sent,
+    // so it carries every change made in between.
+    if (!nc_flush_pending(nc)) {
+        nc->owed = true;
+        nc->stats.frames_dropped++;
+        return 0;
+    }
+    nc->owed = false;
+    nc_render_frame(nc);
+    return 0;
+}
+
+int notcurses_render(struct notcurses* nc) {
+    if (!nc || !nc->stdplane) return -1;
+    return render(nc, false);
+}
+
+// ---------------------------------------------------------------------------
+// notcurses_refresh — repaint every cell, ignoring the last presented frame
+// ---------------------------------------------------------------------------
+
+int notcurses_refresh(struct notcurses* nc) {
+    if (!nc || !nc->stdplane) return -1;
+    return render(nc, true);
+}
+
+// ---------------------------------------------------------------------------
+// notcurses_set_pipelined — render on a thread of its own
+// ---------------------------------------------------------------------------
+
+int notcurses_set_pipelined(struct notcurses* nc, bool pipelined) {
+    if (!nc) return -1;
+    if (pipelined == (nc->pipeline != NULL)) return 0;
+    if (!pipelined) {
+        nc_pipeline_stop(nc);
+        return 0;
+    }
+    if (!nc_pipeline_start(nc)) return -1;
+    // The thread sends a frame owed so far once the terminal takes it
+    if (nc->owed && nc_pipeline_submit(nc, false)) nc->owed = false;
     return 0;
 }
 
+bool notcurses_pipelined(const struct notcurses* nc) {
+    return nc && nc->pipeline;
+}
+
+// ---------------------------------------------------------------------------
+// notcurses_stats / notcurses_stats_reset
+// ---------------------------------------------------------------------------
+
+void notcurses_stats(struct notcurses* nc, ncstats* stats) {
+    if (!nc || !stats) return;
+    nc_pipeline_hold(nc->pipeline);
+    *stats = nc->stats;
+    nc_pipeline_release(nc->pipeline);
+}
+
+void notcurses_stats_reset(struct notcurses* nc, ncstats* stats) {
+    if (!nc) return;
+    nc_pipeline_hold(nc->pipeline);
+    if (stats) *stats = nc->stats;
+    memset(&nc->stats, 0, sizeof(nc->stats));
+    nc_pipeline_release(nc->pipeline);
+}
+
 // ---------------------------------------------------------------------------
 // notcurses_stdplane
 // ---------------------------------------------------------------------------
@@ -151,7 +614,7 @@ struct ncplane* notcurses_stddim_yx(struct notcurses* nc,
     if (!nc) return NULL;
 
     // Refresh dimensions from kernel
-    nc_get_terminal_size(&nc->rows, &nc->cols);
+    refresh_size(nc);
 
     if (rows) *rows = nc->rows;
     if (cols) *cols = nc->cols;
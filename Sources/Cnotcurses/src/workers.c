@@ -0,0 +1,102 @@
+#include "internal.h"
+#include <pthread.h>
+
+// ---------------------------------------------------------------------------
+// Worker threads
+//
+// A fixed set of threads that run the pieces of one job at a time.  The
+// thread that posts a job takes pieces too and returns once every piece
+// has finished.  Jobs are a handful of large pieces, so pieces are handed
+// out under the lock.
+// ---------------------------------------------------------------------------
+
+struct nc_workers {
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;        // A job was posted, or the pool is stopping
+    pthread_cond_t  done;        // The last piece of a job finished
+    pthread_t*      threads;
+    unsigned        nthreads;
+    bool            stopping;
+    void          (*fn)(void* arg, unsigned index);
+    void*           arg;
+    unsigned        count;       // Pieces in the job
+    unsigned        next;        // Next piece to hand out
+    unsigned        unfinished;  // Pieces not finished yet
+};
+
+// Take pieces until none are left.  Called and returns with the lock held.
+static void run_pieces(nc_workers* w) {
+    while (w->next < w->count) {
+        const unsigned index = w->next++;
+        pthread_mutex_unlock(&w->lock);
+        w->fn(w->arg, index);
+        pthread_mutex_lock(&w->lock);
+        if (--w->unfinished == 0) pthread_cond_signal(&w->done);
+    }
+}
+
+static void* worker_main(void* p) {
+    nc_workers* w = p;
+    pthread_mutex_lock(&w->lock);
+    while (!w->stopping) {
+        if (w->next < w->count) run_pieces(w);
+        else pthread_cond_wait(&w->wake, &w->lock);
+    }
+    pthread_mutex_unlock(&w->lock);
+    return NULL;
+}
+
+nc_workers* nc_workers_create(unsigned threads) {
+    nc_workers* w = calloc(1, sizeof(*w));
+    if (!w) return NULL;
+    w->threads = calloc(threads ? threads : 1, sizeof(pthread_t));
+    if (!w->threads) {
+        free(w);
+        return NULL;
+    }
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->wake, NULL);
+    pthread_cond_init(&w->done, NULL);
+    for (unsigned i = 0; i < threads; i++) {
+        if (pthread_create(&w->threads[i], NULL, worker_main, w) != 0) {
+            nc_workers_destroy(w);
+            return NULL;
+        }
+        w->nthreads++;
+    }
+    return w;
+}
+
+void nc_workers_destroy(nc_workers* w) {
+    if (!w) return;
+    pthread_mutex_lock(&w->lock);
+    w->stopping = true;
+    pthread_cond_broadcast(&w->wake);
+    pthread_mutex_unlock(&w->lock);
+    for (unsigned i = 0; i < w->nthreads; i++) {
+        pthread_join(w->threads[i], NULL);
+    }
+    pthread_cond_destroy(&w->done);
+    pthread_cond_destroy(&w->wake);
+    pthread_mutex_destroy(&w->lock);
+    free(w->threads);
+    free(w);
+}
+
+void nc_workers_run(nc_workers* w, unsigned count,
+                    void (*fn)(void* arg, unsigned index), void* arg) {
+    if (!w) {
+        for (unsigned i = 0; i < count; i++) fn(arg, i);
+        return;
+    }
+    pthread_mutex_lock(&w->lock);
+    w->fn         = fn;
+    w->arg        = arg;
+    w->count      = count;
+    w->next       = 0;
+    w->unfinished = count;
+    pthread_cond_broadcast(&w->wake);
+    run_pieces(w);
+    while (w->unfinished) pthread_cond_wait(&w->done, &w->lock);
+    pthread_mutex_unlock(&w->lock);
+}
@@ -0,0 +1,76 @@
+import Cnotcurses
+
+/// Styled runs of text queued for a plane and written in one call.
+///
+/// Text is copied into a byte arena as it is appended, straight from the
+/// string's UTF-8 storage, and the arena and span storage are kept when the
+/// list is cleared, so drawing a frame allocates nothing once the list has
+/// grown to the size of a frame.
+public struct DrawList {
+    private var spans: [ncspan] = []
+    // Start of each span's text in the arena
+    private var offsets: [Int] = []
+    private var arena: [UInt8] = []
+
+    public init() {}
+
+    /// The number of spans queued.
+    public var count: Int { spans.count }
+
+    public var isEmpty: Bool { spans.isEmpty }
+
+    /// Queue `text` at a plane row and column. A nil color is the
+    /// terminal's default.
+    public mutating func append(_ text: String, y: Int, x: Int,
+                                foreground: RGBColor? = nil, background: RGBColor? = nil,
+                                styles: TextAttribute = []) {
+        var text = text
+        text.withUTF8 {
+            append(utf8: $0, y: y, x: x, foreground: foreground, background: background, styles: styles)
+        }
+    }
+
+    /// Queue UTF-8 text at a plane row and column, copying the bytes.
+    public mutating func append(utf8: UnsafeBufferPointer<UInt8>, y: Int, x: Int,
+                                foreground: RGBColor? = nil, background: RGBColor? = nil,
+                                styles: TextAttribute = []) {
+        offsets.append(arena.count)
+        arena.append(contentsOf: utf8)
+        spans.append(ncspan(
+            y: Int32(clamping: y), x: Int32(clamping: x),
+            fg: foreground?.rgb ?? NCSPAN_DEFAULT_RGB,
+            bg: background?.rgb ?? NCSPAN_DEFAULT_RGB,
+            styles: styles.rawValue,
+            utf8: nil, len: utf8.count))
+    }
+
+    /// Forget every span, keeping the storage for the next frame.
+    public mutating func removeAll() {
+        spans.removeAll(keepingCapacity: true)
+        offsets.removeAll(keepingCapacity: true)
+        arena.removeAll(keepingCapacity: true)
+    }
+
+    // Point each span at its text, then hand the batch to `body`.
+    fileprivate mutating func withSpans<R>(_ body: (UnsafeBufferPointer<ncspan>) -> R) -> R {
+        arena.withUnsafeBufferPointer { bytes in
+            let base = bytes.baseAddress.map { UnsafeRawPointer($0).assumingMemoryBound(to: CChar.self) }
+            for i in spans.indices {
+                spans[i].utf8 = base.map { $0 + offsets[i] }
+            }
+            return spans.withUnsafeBufferPointer(body)
+        }
+    }
+}
+
+extension Plane {
+    /// Write every span of `list` in order, clipped to the end of its row,
+    /// in a single call. The cursor, colors and styles set on the plane are
+    /// unchanged. Returns the number of cells written.
+    @discardableResult
+    public func draw(_ list: inout DrawList) -> Int {
+        list.withSpans { spans in
+            Int(ncplane_putspans(plane, spans.baseAddress, spans.count))
+        }
+    }
+}
@@ -10,6 +10,18 @@ public struct InputEvent {
     public let ctrl: Bool
     /// Whether alt was held.
     public let alt: Bool
+    /// For a paste, whether the text did not all fit and only its start
+    /// is given.
+    public let isPasteTruncated: Bool
+
+    public init(key: KeyEvent, shift: Bool = false, ctrl: Bool = false, alt: Bool = false,
+                isPasteTruncated: Bool = false) {
+        self.key = key
+        self.shift = shift
+        self.ctrl = ctrl
+        self.alt = alt
+        self.isPasteTruncated = isPasteTruncated
+    }
 }
 
 /// Known key events.
@@ -19,14 +31,57 @@ public enum KeyEvent: Equatable {
     case down
     case left
     case right
+    case pageUp
+    case pageDown
+    case home
+    case end
     case enter
     case escape
     case backspace
     case tab
     case resize
+    /// Text pasted into a terminal that supports bracketed paste, as one
+    /// event rather than a key per character.
+    case paste(String)
+    /// A mouse button, wheel or pointer movement, from a terminal that
+    /// reports the mouse.
+    case mouse(MouseEvent)
     case unknown(UInt32)
 }
 
+/// A mouse button press or release, a wheel step or pointer movement.
+public struct MouseEvent: Equatable, Sendable {
+    public enum Action: Equatable, Sendable {
+        case press
+        case release
+        case move
+    }
+
+    public enum Button: Equatable, Sendable {
+        case left
+        case middle
+        case right
+        case scrollUp
+        case scrollDown
+        /// Buttons 6 through 11, such as horizontal wheels and side buttons.
+        case other(Int)
+    }
+
+    public var action: Action
+    /// The button pressed or released; nil for movement.
+    public var button: Button?
+    /// The cell under the pointer, counted from 0.
+    public var row: Int
+    public var column: Int
+
+    public init(_ action: Action, button: Button? = nil, row: Int, column: Int) {
+        self.action = action
+        self.button = button
+        self.row = row
+        self.column = column
+    }
+}
+
 extension Terminal {
     /// Poll for input with an optional timeout in milliseconds.
     /// Returns nil if no input is available within the timeout.
@@ -41,13 +96,48 @@ extension Terminal {
         }
 
         guard result != 0 else { return nil }
+        return InputEvent(ni)
+    }
+
+    /// Every event already received, up to `limit`, waiting up to `timeout`
+    /// milliseconds (forever if negative) when there are none. A burst of
+    /// key presses or a paste is decoded from a single read.
+    public func getInputs(timeout: Int = -1, limit: Int = 64) -> [InputEvent] {
+        var buffer = [ncinput](repeating: ncinput(), count: max(1, limit))
+        let count: Int32 = buffer.withUnsafeMutableBufferPointer { events in
+            if timeout >= 0 {
+                var ts = timespec(tv_sec: timeout / 1000, tv_nsec: (timeout % 1000) * 1_000_000)
+                return notcurses_getvec(nc, &ts, events.baseAddress, Int32(events.count))
+            }
+            return notcurses_getvec(nc, nil, events.baseAddress, Int32(events.count))
+        }
+        return buffer.prefix(max(0, Int(count))).map(InputEvent.init)
+    }
 
-        let shift = ni.shift
-        let ctrl = ni.ctrl
-        let alt = ni.alt
+    /// How long a lone escape waits for the rest of an escape sequence
+    /// before it is read as the Escape key. Shorter makes Escape snappier;
+    /// too short splits sequences sent over slow links.
+    public var escapeDelay: Duration {
+        get { .milliseconds(Int(notcurses_escape_delay(nc))) }
+        set {
+            let (seconds, attoseconds) = newValue.components
+            let milliseconds = max(0, seconds * 1000 + attoseconds / 1_000_000_000_000_000)
+            notcurses_set_escape_delay(nc, UInt32(clamping: milliseconds))
+        }
+    }
+
+    /// Hold at most `bytes` bytes of pasted text for the pastes not yet
+    /// read, or any number when nil. A paste that does not fit arrives cut
+    /// short, with `isPasteTruncated` set.
+    public func setPasteLimit(_ bytes: Int?) {
+        notcurses_set_paste_limit(nc, bytes.map { max(1, $0) } ?? 0)
+    }
+}
 
+extension InputEvent {
+    init(_ ni: ncinput) {
         let key: KeyEvent
-        switch result {
+        switch ni.id {
         case nckey_up():
             key = .up
         case nckey_down():
@@ -56,6 +146,14 @@ extension Terminal {
             key = .left
         case nckey_right():
             key = .right
+        case nckey_pgup():
+            key = .pageUp
+        case nckey_pgdown():
+            key = .pageDown
+        case nckey_home():
+            key = .home
+        case nckey_end():
+            key = .end
         case nckey_enter():
             key = .enter
         case nckey_esc():
@@ -66,14 +164,106 @@ extension Terminal {
             key = .tab
         case nckey_resize():
             key = .resize
+        case nckey_paste():
+            let text = ni.paste.map {
+                UnsafeRawBufferPointer(start: $0, count: ni.pastelen)
+            }
+            key = .paste(text.map { String(decoding: $0, as: UTF8.self) } ?? "")
+        case nckey_motion():
+            key = .mouse(MouseEvent(.move, row: Int(ni.y), column: Int(ni.x)))
+        case nckey_button1()...nckey_button11():
+            let button: MouseEvent.Button
+            switch ni.id - nckey_button1() + 1 {
+            case 1: button = .left
+            case 2: button = .middle
+            case 3: button = .right
+            case 4: button = .scrollUp
+            case 5: button = .scrollDown
+            case let number: button = .other(Int(number))
+            }
+            let action: MouseEvent.Action = ni.evtype == NCTYPE_RELEASE ? .release : .press
+            key = .mouse(MouseEvent(action, button: button, row: Int(ni.y), column: Int(ni.x)))
         default:
-            if let scalar = Unicode.Scalar(result) {
+            if let scalar = Unicode.Scalar(ni.id) {
                 key = .character(Character(scalar))
             } else {
-                key = .unknown(result)
+                key = .unknown(ni.id)
             }
         }
 
-        return InputEvent(key: key, shift: shift, ctrl: ctrl, alt: alt)
+        self.init(key: key, shift: ni.shift, ctrl: ni.ctrl, alt: ni.alt,
+                  isPasteTruncated: ni.pastetruncated)
+    }
+}
+
+// MARK: - Injected input
+
+extension Terminal {
+    /// Queue raw bytes as input on a headless terminal, exactly as a
+    /// terminal would send them. Returns false if they did not all fit.
+    @discardableResult
+    public func inject(_ bytes: [UInt8]) -> Bool {
+        bytes.withUnsafeBufferPointer { buffer in
+            guard let base = buffer.baseAddress else { return true }
+            return base.withMemoryRebound(to: CChar.self, capacity: buffer.count) {
+                Int(notcurses_inject(nc, $0, buffer.count)) == buffer.count
+            }
+        }
+    }
+
+    /// Queue key presses on a headless terminal. As from a real terminal,
+    /// an escape followed at once by another key reads as Alt plus that key.
+    @discardableResult
+    public func inject(_ keys: KeyEvent...) -> Bool {
+        inject(keys.flatMap(\.inputSequence))
+    }
+
+    /// Queue typed text on a headless terminal.
+    @discardableResult
+    public func inject(text: String) -> Bool {
+        inject(Array(text.utf8))
+    }
+}
+
+extension KeyEvent {
+    /// The bytes a terminal sends for this key; empty for events that
+    /// are not keys.
+    var inputSequence: [UInt8] {
+        switch self {
+        case .character(let character): return Array(String(character).utf8)
+        case .up:        return Array("\u{1B}[A".utf8)
+        case .down:      return Array("\u{1B}[B".utf8)
+        case .right:     return Array("\u{1B}[C".utf8)
+        case .left:      return Array("\u{1B}[D".utf8)
+        case .pageUp:    return Array("\u{1B}[5~".utf8)
+        case .pageDown:  return Array("\u{1B}[6~".utf8)
+        case .home:      return Array("\u{1B}[H".utf8)
+        case .end:       return Array("\u{1B}[F".utf8)
+        case .enter:     return [0x0D]
+        case .escape:    return [0x1B]
+        case .backspace: return [0x7F]
+        case .tab:       return [0x09]
+        case .resize:    return []
+        case .paste(let text):
+            return Array("\u{1B}[200~".utf8) + Array(text.utf8) + Array("\u{1B}[201~".utf8)
+        case .mouse(let event):
+            // SGR encoding, with coordinates counted from 1
+            var code: Int
+            switch event.button {
+            case .left: code = 0
+            case .middle: code = 1
+            case .right: code = 2
+            case .scrollUp: code = 64
+            case .scrollDown: code = 65
+            case .other(let number): code = number < 8 ? 60 + number : 120 + number
+            case nil: code = 3
+            }
+            if event.action == .move { code += 32 }
+            let final = event.action == .release ? "m" : "M"
+            return Array("\u{1B}[<\(code);\(event.column + 1);\(event.row + 1)\(final)".utf8)
+        case .unknown(let code):
+            guard let scalar = Unicode.Scalar(code) else { return [] }
+            return Array(String(Character(scalar)).utf8)
+        }
     }
 }
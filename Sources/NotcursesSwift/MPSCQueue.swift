@@ -0,0 +1,38 @@
+import Cnotcurses
+
+/// A lock-free multi-producer, single-consumer queue of objects.
+///
+/// Any thread may `push`; only one thread at a time may `pop`. The queue
+/// keeps a strong reference to each element until it is popped.
+public final class MPSCQueue<Element: AnyObject>: @unchecked Sendable {
+    private let queue: OpaquePointer
+
+    public init() {
+        guard let queue = ncmpsc_create() else {
+            fatalError("Failed to allocate MPSC queue")
+        }
+        self.queue = queue
+    }
+
+    deinit {
+        while pop() != nil {}
+        ncmpsc_destroy(queue)
+    }
+
+    /// Append an element. Returns false if it could not be queued.
+    @discardableResult
+    public func push(_ element: Element) -> Bool {
+        let item = Unmanaged.passRetained(element)
+        guard ncmpsc_push(queue, item.toOpaque()) == 0 else {
+            item.release()
+            return false
+        }
+        return true
+    }
+
+    /// Remove the oldest element, or return nil if the queue is empty.
+    public func pop() -> Element? {
+        guard let item = ncmpsc_pop(queue) else { return nil }
+        return Unmanaged<Element>.fromOpaque(item).takeRetainedValue()
+    }
+}
@@ -1,13 +1,21 @@
 import Cnotcurses
 
 /// Safe Swift wrapper around an ncplane.
+///
+/// Planes are composited bottom to top when the terminal renders. A child
+/// plane is positioned relative to its parent and clipped to it; cells that
+/// were never written are transparent.
 public final class Plane {
     let plane: OpaquePointer
     private let ownsPlane: Bool
+    // Keeps the parent plane (and ultimately the Terminal) alive, since the
+    // C planes are freed when the notcurses context stops.
+    private let owner: AnyObject
 
-    init(plane: OpaquePointer, ownsPlane: Bool) {
+    init(plane: OpaquePointer, ownsPlane: Bool, owner: AnyObject) {
         self.plane = plane
         self.ownsPlane = ownsPlane
+        self.owner = owner
     }
 
     deinit {
@@ -26,7 +34,25 @@ public final class Plane {
         guard let child = ncplane_create(plane, &opts) else {
             throw TerminalError.planeFailed("Failed to create child plane")
         }
-        return Plane(plane: child, ownsPlane: true)
+        return Plane(plane: child, ownsPlane: true, owner: self)
+    }
+
+    /// Create a plane of the same terminal that is never composited.
+    ///
+    /// Draw into it like any plane, then copy it onto visible planes with
+    /// `blit(_:y:x:)`. An offscreen plane cannot be moved or restacked.
+    public func createOffscreen(rows: Int, cols: Int) throws -> Plane {
+        guard let offscreen = ncplane_create_offscreen(plane, UInt32(max(rows, 0)), UInt32(max(cols, 0))) else {
+            throw TerminalError.planeFailed("Failed to create offscreen plane")
+        }
+        return Plane(plane: offscreen, ownsPlane: true, owner: self)
+    }
+
+    /// Copy every cell of `source` onto this plane with its top-left
+    /// corner at (`y`, `x`), clipped to this plane, one row at a time.
+    /// The copy is opaque: cells `source` never wrote blank those beneath.
+    public func blit(_ source: Plane, y: Int, x: Int) {
+        ncplane_blit(source.plane, plane, Int32(y), Int32(x))
     }
 
     /// Write a string at the current cursor position.
@@ -35,7 +61,23 @@ public final class Plane {
         if y >= 0 || x >= 0 {
             ncplane_cursor_move_yx(plane, Int32(max(y, 0)), Int32(max(x, 0)))
         }
-        return Int(ncplane_putstr(plane, str))
+        // Pass the UTF-8 bytes with their length; no NUL-terminated copy
+        var str = str
+        return str.withUTF8 { utf8 in
+            guard let base = utf8.baseAddress else { return 0 }
+            return base.withMemoryRebound(to: CChar.self, capacity: utf8.count) {
+                Int(ncplane_putnstr(plane, utf8.count, $0))
+            }
+        }
+    }
+
+    /// Write `glyph` in the current colors and styles to every cell of a
+    /// rectangle, clipped to the plane. The cursor does not move.
+    /// Returns the number of cells written.
+    @discardableResult
+    public func fill(y: Int, x: Int, rows: Int, cols: Int, with glyph: String = " ") -> Int {
+        guard rows > 0, cols > 0 else { return 0 }
+        return Int(ncplane_fill(plane, Int32(y), Int32(x), UInt32(rows), UInt32(cols), glyph))
     }
 
     /// Set the foreground color using RGB components.
@@ -85,11 +127,51 @@ public final class Plane {
         ncplane_erase(plane)
     }
 
+    /// Shift the contents up by `rows`, leaving blank rows at the bottom.
+    /// Rendering moves the shifted rows with a terminal scroll instead of
+    /// repainting them.
+    public func scrollUp(by rows: Int = 1) {
+        ncplane_scrollup(plane, Int32(max(0, rows)))
+    }
+
     /// Move cursor to the given position.
     public func moveCursor(y: Int, x: Int) {
         ncplane_cursor_move_yx(plane, Int32(y), Int32(x))
     }
 
+    /// Position relative to the parent plane.
+    public var position: (y: Int, x: Int) {
+        var y: Int32 = 0
+        var x: Int32 = 0
+        ncplane_yx(plane, &y, &x)
+        return (Int(y), Int(x))
+    }
+
+    /// Move the plane relative to its parent. The standard plane cannot move.
+    public func move(y: Int, x: Int) {
+        ncplane_move_yx(plane, Int32(y), Int32(x))
+    }
+
+    /// Raise the plane above every other plane.
+    public func moveToTop() {
+        ncplane_move_top(plane)
+    }
+
+    /// Lower the plane below every other plane.
+    public func moveToBottom() {
+        ncplane_move_bottom(plane)
+    }
+
+    /// Place the plane directly above another plane.
+    public func move(above other: Plane) {
+        ncplane_move_above(plane, other.plane)
+    }
+
+    /// Place the plane directly below another plane.
+    public func move(below other: Plane) {
+        ncplane_move_below(plane, other.plane)
+    }
+
     /// Plane dimensions (rows, columns).
     public var dimensions: (rows: Int, cols: Int) {
         var rows: UInt32 = 0
@@ -0,0 +1,50 @@
+import Cnotcurses
+
+/// Counters describing the work done by `Terminal.render()`.
+public struct RenderStatistics: Equatable, Sendable {
+    /// Frames rendered.
+    public let renders: UInt64
+    /// Frames that repainted every cell (first frame, resize, `refresh()`).
+    public let fullRepaints: UInt64
+    /// Cells compared against the previously presented frame.
+    public let cellsDiffed: UInt64
+    /// Cells written to the terminal.
+    public let cellsEmitted: UInt64
+    /// Bytes written to the terminal.
+    public let bytesWritten: UInt64
+    /// Frames that moved shifted rows with a terminal scroll region
+    /// instead of repainting them.
+    public let scrolls: UInt64
+    /// Renders skipped because the terminal had not taken the last frame.
+    public let framesDropped: UInt64
+    /// Time spent waiting for the terminal to take output.
+    public let stallTime: Duration
+
+    init(_ stats: ncstats) {
+        self.renders = stats.renders
+        self.fullRepaints = stats.full_repaints
+        self.cellsDiffed = stats.cells_diffed
+        self.cellsEmitted = stats.cells_emitted
+        self.bytesWritten = stats.bytes_written
+        self.scrolls = stats.scrolls
+        self.framesDropped = stats.frames_dropped
+        self.stallTime = .nanoseconds(Int64(stats.stall_ns))
+    }
+}
+
+extension Terminal {
+    /// Render counters accumulated since initialization or the last reset.
+    public var statistics: RenderStatistics {
+        var stats = ncstats()
+        notcurses_stats(nc, &stats)
+        return RenderStatistics(stats)
+    }
+
+    /// Return the current render counters and reset them to zero.
+    @discardableResult
+    public func resetStatistics() -> RenderStatistics {
+        var stats = ncstats()
+        notcurses_stats_reset(nc, &stats)
+        return RenderStatistics(stats)
+    }
+}
@@ -46,3 +46,55 @@ public struct TextAttribute: OptionSet, Sendable {
     public static let underline = TextAttribute(rawValue: UInt32(NCSTYLE_UNDERLINE))
     public static let struck    = TextAttribute(rawValue: UInt32(NCSTYLE_STRUCK))
 }
+
+// MARK: - Color Support
+
+/// How many colors a terminal can show, which decides how colors are written.
+public enum ColorSupport: Sendable, CaseIterable {
+    /// The 16 ANSI colors; every color is shown as the nearest of them.
+    case ansi16
+    /// The xterm 256-color palette; every color is shown as its nearest entry.
+    case palette256
+    /// 24-bit color, written exactly.
+    case trueColor
+
+    init(_ colors: nccolors_e) {
+        switch colors {
+        case NCCOLORS_16: self = .ansi16
+        case NCCOLORS_256: self = .palette256
+        default: self = .trueColor
+        }
+    }
+
+    var ncColors: nccolors_e {
+        switch self {
+        case .ansi16: return NCCOLORS_16
+        case .palette256: return NCCOLORS_256
+        case .trueColor: return NCCOLORS_RGB
+        }
+    }
+
+    /// The support claimed by values of the `TERM` and `COLORTERM`
+    /// environment variables.
+    public static func detected(term: String?, colorTerm: String?) -> ColorSupport {
+        func withOptionalCString<R>(_ string: String?, _ body: (UnsafePointer<CChar>?) -> R) -> R {
+            guard let string else { return body(nil) }
+            return string.withCString(body)
+        }
+        return withOptionalCString(term) { term in
+            withOptionalCString(colorTerm) { colorTerm in
+                ColorSupport(notcurses_detect_colors(term, colorTerm))
+            }
+        }
+    }
+}
+
+extension Terminal {
+    /// How colors are encoded in rendered output. A terminal starts with
+    /// what its environment claims and a headless terminal with
+    /// `.trueColor`; setting it repaints everything on the next render.
+    public var colorSupport: ColorSupport {
+        get { ColorSupport(notcurses_colors(nc)) }
+        set { notcurses_set_colors(nc, newValue.ncColors) }
+    }
+}
@@ -14,10 +14,27 @@ public struct TerminalOptions: OptionSet, Sendable {
     public static let suppressBanners   = TerminalOptions(rawValue: UInt64(NCOPTION_SUPPRESS_BANNERS))
 }
 
+/// Mouse events a terminal reports.
+public struct MouseEvents: OptionSet, Sendable {
+    public let rawValue: UInt32
+    public init(rawValue: UInt32) { self.rawValue = rawValue }
+
+    /// Presses, releases and wheel steps.
+    public static let buttons = MouseEvents(rawValue: UInt32(NCMICE_BUTTON_EVENT))
+    /// Motion while a button is held.
+    public static let drags   = MouseEvents(rawValue: UInt32(NCMICE_DRAG_EVENT))
+    /// Motion with no button held, for hover. Every pointer move is then
+    /// reported.
+    public static let motion  = MouseEvents(rawValue: UInt32(NCMICE_MOVE_EVENT))
+}
+
 /// Safe Swift wrapper around the notcurses terminal library.
 public final class Terminal {
     let nc: OpaquePointer
 
+    /// Whether this terminal renders into memory instead of a TTY.
+    public let isHeadless: Bool
+
     /// Initialize a notcurses context.
     /// - Parameter flags: Initialization flags (default: no alternate screen for debugging).
     public init(flags: UInt64 = UInt64(NCOPTION_NO_ALTERNATE_SCREEN)) throws {
@@ -30,6 +47,22 @@ public final class Terminal {
             throw TerminalError.initFailed
         }
         self.nc = nc
+        isHeadless = false
+    }
+
+    /// Create a headless terminal of a fixed size, which needs no TTY.
+    ///
+    /// Rendered output collects in memory until taken with `takeOutput()`,
+    /// and input is whatever was queued with `inject`. Together with
+    /// `VirtualScreen` this runs an application under tests and benchmarks.
+    public init(headlessRows rows: Int, cols: Int) throws {
+        var opts = notcurses_options()
+        guard rows > 0, cols > 0,
+              let nc = notcurses_init_headless(&opts, UInt32(rows), UInt32(cols)) else {
+            throw TerminalError.initFailed
+        }
+        self.nc = nc
+        isHeadless = true
     }
 
     deinit {
@@ -45,10 +78,89 @@ public final class Terminal {
         return self
     }
 
+    /// Repaint every cell, ignoring what was presented by the last render.
+    /// Use this when something else has drawn over the terminal.
+    @discardableResult
+    public func refresh() throws -> Self {
+        guard notcurses_refresh(nc) == 0 else {
+            throw TerminalError.renderFailed
+        }
+        return self
+    }
+
+    /// The bytes a headless terminal rendered since the last call, which
+    /// are then discarded. Always empty for a real terminal.
+    public func takeOutput() -> [UInt8] {
+        // Taken in one step, so a frame from the render thread is neither
+        // written over the bytes being copied nor cleared unread
+        var length = 0
+        guard let bytes = notcurses_output_take(nc, &length) else { return [] }
+        defer { free(bytes) }
+        return [UInt8](UnsafeRawBufferPointer(start: bytes, count: length))
+    }
+
+    /// Drop the bytes a headless terminal rendered without copying them.
+    public func discardOutput() {
+        notcurses_output_clear(nc)
+    }
+
+    /// Bytes rendered but not yet taken by the terminal. While any are
+    /// left, `render()` drops the frame; the latest state is sent once the
+    /// terminal catches up, from the next render or while `getInput` waits.
+    public var pendingOutputBytes: Int {
+        notcurses_output_pending(nc)
+    }
+
+    /// Model a slow link on a headless terminal: it takes at most `bytes`
+    /// bytes of output until they are taken with `takeOutput()`, or any
+    /// number when nil. Has no effect on a real terminal.
+    public func setOutputLimit(_ bytes: Int?) {
+        notcurses_set_output_limit(nc, bytes.map { max(1, $0) } ?? 0)
+    }
+
+    /// Keep at most `bytes` bytes for a terminal that lags, or any number
+    /// when nil. Output beyond that is lost, and the next render repaints
+    /// every cell.
+    public func setPendingLimit(_ bytes: Int?) {
+        notcurses_set_pending_limit(nc, bytes.map { max(1, $0) } ?? 0)
+    }
+
+    /// Threads that encode a full repaint of a large screen, the rendering
+    /// thread included. Its rows are cut into bands encoded in parallel and
+    /// written in one call. 1, the default, encodes on the rendering thread.
+    public var encodeThreads: Int {
+        get { Int(notcurses_encode_threads(nc)) }
+        set { notcurses_set_encode_threads(nc, UInt32(clamping: max(1, newValue))) }
+    }
+
+    /// Whether renders are written by a thread of their own. `render()`
+    /// then copies the frame and returns while the thread diffs, encodes
+    /// and writes it; a frame the thread has not started on is replaced
+    /// by the next. Reading statistics or headless output waits for the
+    /// frames rendered so far. Off by default.
+    public var isPipelined: Bool {
+        get { notcurses_pipelined(nc) }
+        set { notcurses_set_pipelined(nc, newValue) }
+    }
+
+    /// Mouse events the terminal reports, none by default. Any reporting
+    /// takes over the terminal's own text selection until it is turned
+    /// off again, at the latest when the terminal stops.
+    public var mouseEvents: MouseEvents {
+        get { MouseEvents(rawValue: notcurses_mice_enabled(nc)) }
+        set { notcurses_mice_enable(nc, newValue.rawValue) }
+    }
+
+    /// Interrupt a `getInput` call that is waiting on another thread; it
+    /// returns nil as if it had timed out. Safe to call from any thread.
+    public func wake() {
+        notcurses_wake(nc)
+    }
+
     /// The standard plane (root plane covering the entire terminal).
     public var standardPlane: Plane {
         let stdPlane = notcurses_stdplane(nc)!
-        return Plane(plane: stdPlane, ownsPlane: false)
+        return Plane(plane: stdPlane, ownsPlane: false, owner: self)
     }
 
     /// Terminal dimensions (rows, columns).
@@ -0,0 +1,344 @@
+/// An in-memory model of a terminal screen, built by decoding the escape
+/// sequences a renderer writes.
+///
+/// Feed it the output of a headless `Terminal` to inspect what a real
+/// terminal would show, cell by cell. It understands the subset of VT100 and
+/// xterm sequences the renderer emits: cursor movement, erasing, SGR colors
+/// and styles, scroll regions and cursor visibility. Every character takes
+/// one column, as it does in the renderer's cell grid.
+public struct VirtualScreen {
+    /// One character cell as displayed.
+    public struct Cell: Equatable, Sendable {
+        public var character: Character
+        /// The foreground color, or nil for the terminal default.
+        public var foreground: RGBColor?
+        /// The background color, or nil for the terminal default.
+        public var background: RGBColor?
+        public var styles: TextAttribute
+
+        public init(character: Character = " ", foreground: RGBColor? = nil,
+                    background: RGBColor? = nil, styles: TextAttribute = []) {
+            self.character = character
+            self.foreground = foreground
+            self.background = background
+            self.styles = styles
+        }
+
+        public static let blank = Cell()
+    }
+
+    public let rows: Int
+    public let cols: Int
+    /// The cells in row-major order.
+    public private(set) var cells: [Cell]
+    /// The cursor position; `cursorX == cols` means a wrap is pending after
+    /// writing the last column.
+    public private(set) var cursorY = 0
+    public private(set) var cursorX = 0
+    public private(set) var isCursorVisible = true
+
+    // Current SGR state, applied to written characters
+    private var pen = Cell.blank
+    // Scroll region rows, inclusive
+    private var scrollTop = 0
+    private var scrollBottom: Int
+
+    private enum ParseState {
+        case ground
+        case escape
+        case csi
+    }
+    private var state = ParseState.ground
+    private var parameters: [UInt8] = []
+    // Printable bytes not yet decoded into characters
+    private var text: [UInt8] = []
+
+    public init(rows: Int, cols: Int) {
+        precondition(rows > 0 && cols > 0, "screen must have at least one cell")
+        self.rows = rows
+        self.cols = cols
+        cells = Array(repeating: .blank, count: rows * cols)
+        scrollBottom = rows - 1
+    }
+
+    /// A screen the size of `terminal`.
+    public init(matching terminal: Terminal) {
+        let dims = terminal.dimensions
+        self.init(rows: dims.rows, cols: dims.cols)
+    }
+
+    /// The cell at a row and column.
+    public subscript(row: Int, column: Int) -> Cell {
+        cells[row * cols + column]
+    }
+
+    /// The characters of one row, with trailing blanks removed.
+    public func text(ofRow row: Int) -> String {
+        var line = String(cells[row * cols ..< (row + 1) * cols].map(\.character))
+        while line.last == " " { line.removeLast() }
+        return line
+    }
+
+    /// Every row as text, with trailing blanks removed.
+    public var lines: [String] {
+        (0..<rows).map(text(ofRow:))
+    }
+
+    /// Decode the output a headless terminal rendered since the last call.
+    public mutating func update(from terminal: Terminal) {
+        feed(terminal.takeOutput())
+    }
+
+    /// Decode terminal output bytes.
+    public mutating func feed(_ bytes: some Sequence<UInt8>) {
+        for byte in bytes {
+            switch state {
+            case .ground:
+                ground(byte)
+            case .escape:
+                if byte == UInt8(ascii: "[") {
+                    parameters.removeAll(keepingCapacity: true)
+                    state = .csi
+                } else {
+                    // Two-byte sequences are not emitted; drop them
+                    state = .ground
+                }
+            case .csi:
+                if byte >= 0x40 && byte <= 0x7E {
+                    state = .ground
+                    executeCSI(byte)
+                } else {
+                    parameters.append(byte)
+                }
+            }
+        }
+        flushText()
+    }
+
+    // MARK: - Ground state
+
+    private mutating func ground(_ byte: UInt8) {
+        switch byte {
+        case 0x1B:
+            flushText()
+            state = .escape
+        case 0x0D:
+            flushText()
+            cursorX = 0
+        case 0x0A:
+            flushText()
+            lineFeed()
+        case 0x08:
+            flushText()
+            cursorX = max(0, min(cursorX, cols - 1) - 1)
+        case 0x00..<0x20, 0x7F:
+            flushText()
+        default:
+            text.append(byte)
+        }
+    }
+
+    // Write the pending text, one character per column, with autowrap.
+    private mutating func flushText() {
+        guard !text.isEmpty else { return }
+        let string = String(decoding: text, as: UTF8.self)
+        text.removeAll(keepingCapacity: true)
+        for character in string {
+            if cursorX >= cols {
+                cursorX = 0
+                lineFeed()
+            }
+            var cell = pen
+            cell.character = character
+            cells[cursorY * cols + cursorX] = cell
+            cursorX += 1
+        }
+    }
+
+    private mutating func lineFeed() {
+        if cursorY == scrollBottom {
+            scroll(by: 1)
+        } else if cursorY < rows - 1 {
+            cursorY += 1
+        }
+    }
+
+    // MARK: - Control sequences
+
+    private mutating func executeCSI(_ final: UInt8) {
+        if parameters.first == UInt8(ascii: "?") {
+            if final == UInt8(ascii: "h") || final == UInt8(ascii: "l") {
+                setPrivateModes(enabled: final == UInt8(ascii: "h"))
+            }
+            return
+        }
+
+        let args = numericParameters()
+        func arg(_ index: Int, default value: Int) -> Int {
+            index < args.count && args[index] > 0 ? args[index] : value
+        }
+
+        switch final {
+        case UInt8(ascii: "H"), UInt8(ascii: "f"):
+            cursorY = min(arg(0, default: 1), rows) - 1
+            cursorX = min(arg(1, default: 1), cols) - 1
+        case UInt8(ascii: "A"):
+            cursorY = max(0, cursorY - arg(0, default: 1))
+        case UInt8(ascii: "B"):
+            cursorY = min(rows - 1, cursorY + arg(0, default: 1))
+        case UInt8(ascii: "C"):
+            cursorX = min(cols - 1, cursorX + arg(0, default: 1))
+        case UInt8(ascii: "D"):
+            cursorX = max(0, min(cursorX, cols - 1) - arg(0, default: 1))
+        case UInt8(ascii: "G"):
+            cursorX = min(arg(0, default: 1), cols) - 1
+        case UInt8(ascii: "J"):
+            eraseInDisplay(args.first ?? 0)
+        case UInt8(ascii: "K"):
+            eraseInLine(args.first ?? 0)
+        case UInt8(ascii: "m"):
+            selectGraphicRendition(args.isEmpty ? [0] : args)
+        case UInt8(ascii: "r"):
+            let top = arg(0, default: 1) - 1
+            let bottom = min(arg(1, default: rows), rows) - 1
+            if top < bottom {
+                scrollTop = top
+                scrollBottom = bottom
+            } else {
+                scrollTop = 0
+                scrollBottom = rows - 1
+            }
+            cursorY = 0
+            cursorX = 0
+        case UInt8(ascii: "S"):
+            scroll(by: arg(0, default: 1))
+        case UInt8(ascii: "T"):
+            scroll(by: -arg(0, default: 1))
+        default:
+            break
+        }
+    }
+
+    // Parameters as numbers; empty fields read as 0.
+    private func numericParameters() -> [Int] {
+        guard !parameters.isEmpty else { return [] }
+        return parameters.split(separator: UInt8(ascii: ";"), omittingEmptySubsequences: false).map { field in
+            field.reduce(0) { value, digit in
+                (UInt8(ascii: "0")...UInt8(ascii: "9")).contains(digit)
+                    ? value * 10 + Int(digit - UInt8(ascii: "0")) : value
+            }
+        }
+    }
+
+    private mutating func setPrivateModes(enabled: Bool) {
+        let modes = String(decoding: parameters.dropFirst(), as: UTF8.self).split(separator: ";")
+        if modes.contains("25") {
+            isCursorVisible = enabled
+        }
+    }
+
+    private mutating func eraseInDisplay(_ mode: Int) {
+        let cursor = cursorY * cols + min(cursorX, cols - 1)
+        switch mode {
+        case 0: clear(cursor ..< cells.count)
+        case 1: clear(0 ..< cursor + 1)
+        default: clear(0 ..< cells.count)
+        }
+    }
+
+    private mutating func eraseInLine(_ mode: Int) {
+        let start = cursorY * cols
+        let cursor = start + min(cursorX, cols - 1)
+        switch mode {
+        case 0: clear(cursor ..< start + cols)
+        case 1: clear(start ..< cursor + 1)
+        default: clear(start ..< start + cols)
+        }
+    }
+
+    // Erased cells take the current background, as on xterm.
+    private mutating func clear(_ range: Range<Int>) {
+        let blank = Cell(background: pen.background)
+        for index in range {
+            cells[index] = blank
+        }
+    }
+
+    // Move the scroll region up by `count` rows (down if negative).
+    private mutating func scroll(by count: Int) {
+        let height = scrollBottom - scrollTop + 1
+        let shift = min(abs(count), height)
+        guard shift > 0 else { return }
+        let top = scrollTop * cols
+        let bottom = (scrollBottom + 1) * cols
+        var region = Array(cells[top ..< bottom])
+        let blanks = Array(repeating: Cell(background: pen.background), count: shift * cols)
+        if count > 0 {
+            region = Array(region.dropFirst(shift * cols)) + blanks
+        } else {
+            region = blanks + region.dropLast(shift * cols)
+        }
+        cells.replaceSubrange(top ..< bottom, with: region)
+    }
+
+    private mutating func selectGraphicRendition(_ args: [Int]) {
+        var i = 0
+        while i < args.count {
+            let code = args[i]
+            switch code {
+            case 0: pen = .blank
+            case 1: pen.styles.insert(.bold)
+            case 3: pen.styles.insert(.italic)
+            case 4: pen.styles.insert(.underline)
+            case 9: pen.styles.insert(.struck)
+            case 22: pen.styles.remove(.bold)
+            case 23: pen.styles.remove(.italic)
+            case 24: pen.styles.remove(.underline)
+            case 29: pen.styles.remove(.struck)
+            case 30...37: pen.foreground = Self.paletteColor(code - 30)
+            case 90...97: pen.foreground = Self.paletteColor(code - 90 + 8)
+            case 40...47: pen.background = Self.paletteColor(code - 40)
+            case 100...107: pen.background = Self.paletteColor(code - 100 + 8)
+            case 39: pen.foreground = nil
+            case 49: pen.background = nil
+            case 38, 48:
+                var color: RGBColor?
+                if i + 4 < args.count && args[i + 1] == 2 {
+                    color = RGBColor(r: UInt8(clamping: args[i + 2]),
+                                     g: UInt8(clamping: args[i + 3]),
+                                     b: UInt8(clamping: args[i + 4]))
+                    i += 4
+                } else if i + 2 < args.count && args[i + 1] == 5 {
+                    color = Self.paletteColor(args[i + 2])
+                    i += 2
+                }
+                if code == 38 { pen.foreground = color } else { pen.background = color }
+            default:
+                break
+            }
+            i += 1
+        }
+    }
+
+    // The xterm 256-color palette.
+    static func paletteColor(_ index: Int) -> RGBColor {
+        let base: [(UInt8, UInt8, UInt8)] = [
+            (0, 0, 0), (205, 0, 0), (0, 205, 0), (205, 205, 0),
+            (0, 0, 238), (205, 0, 205), (0, 205, 205), (229, 229, 229),
+            (127, 127, 127), (255, 0, 0), (0, 255, 0), (255, 255, 0),
+            (92, 92, 255), (255, 0, 255), (0, 255, 255), (255, 255, 255),
+        ]
+        switch index {
+        case 0..<16:
+            let (r, g, b) = base[index]
+            return RGBColor(r: r, g: g, b: b)
+        case 16..<232:
+            let steps: [UInt8] = [0, 95, 135, 175, 215, 255]
+            let i = index - 16
+            return RGBColor(r: steps[i / 36], g: steps[i / 6 % 6], b: steps[i % 6])
+        default:
+            let level = UInt8(clamping: 8 + 10 * (min(index, 255) - 232))
+            return RGBColor(r: level, g: level, b: level)
+        }
+    }
+}
@@ -0,0 +1,167 @@
+// Micro-benchmark for the Cnotcurses render path.
+//
+//   swift run -c release RenderBenchmark [frames] [rows] [cols]
+//
+// Renders a synthetic full-screen plane with a different color in every
+// cell into a headless context and reports time and bytes per frame and
+// cells written per second, one line per case:
+//
+//   full    repaint every cell
+//   diff    one changed cell per frame
+//   fill    erase and redraw the plane, nothing changes on screen
+//   table   erase and redraw striped rows of ASCII text, as a table view
+//   scroll  shift up one line and write a new bottom line
+//
+//   full-Nt repaint every cell, encoded in bands on N = 1, 2, 4, 8 threads
+
+#include "notcurses_compat.h"
+#include <stdlib.h>
+#include <time.h>
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Render, dropping the output the headless context collected.
+static void render(struct notcurses* nc) {
+    notcurses_render(nc);
+    notcurses_output_clear(nc);
+}
+
+// Every cell gets its own foreground/background and a rotating style.
+static void fill_colorful(struct ncplane* n) {
+    static const unsigned styles[] = {
+        0, NCSTYLE_BOLD, NCSTYLE_ITALIC, NCSTYLE_BOLD | NCSTYLE_UNDERLINE,
+    };
+    unsigned rows, cols;
+    ncplane_dim_yx(n, &rows, &cols);
+    char glyph[2] = { 0, 0 };
+    for (unsigned r = 0; r < rows; r++) {
+        ncplane_cursor_move_yx(n, (int)r, 0);
+        for (unsigned c = 0; c < cols; c++) {
+            ncplane_set_fg_rgb(n, (r * 7 + c * 13) & 0xFFFFFF);
+            ncplane_set_bg_rgb(n, ((r * 3) << 16 | (c * 5) << 8) & 0xFFFFFF);
+            ncplane_set_styles(n, styles[(r + c) % 4]);
+            glyph[0] = (char)('!' + (r + c) % 94);
+            ncplane_putstr(n, glyph);
+        }
+    }
+}
+
+// Alternate row backgrounds with a line of ASCII columns on each row.
+static void fill_table(struct ncplane* n) {
+    unsigned rows, cols;
+    ncplane_dim_yx(n, &rows, &cols);
+    char line[512];
+    for (unsigned r = 0; r < rows; r++) {
+        ncplane_set_bg_rgb(n, r & 1 ? 0x202020 : 0x303030);
+        ncplane_fill(n, (int)r, 0, 1, cols, " ");
+        int len = snprintf(line, sizeof(line),
+                           "%6u  request-%-8u  GET /api/items/%-6u  200  %4ums",
+                           r, r * 17, r * 31, (r * 7) % 1000);
+        ncplane_set_fg_rgb(n, 0xC0C0C0);
+        ncplane_cursor_move_yx(n, (int)r, 1);
+        ncplane_putnstr(n, (size_t)len, line);
+    }
+}
+
+static void report(const char* name, struct notcurses* nc,
+                   unsigned frames, uint64_t elapsed) {
+    ncstats stats;
+    notcurses_stats_reset(nc, &stats);
+    unsigned rows, cols;
+    notcurses_stddim_yx(nc, &rows, &cols);
+    printf("%-8s rows=%u cols=%u frames=%u ns/frame=%.0f bytes/frame=%.0f cells/s=%.0f\n",
+           name, rows, cols, frames,
+           (double)elapsed / frames,
+           (double)stats.bytes_written / frames,
+           (double)stats.cells_emitted * 1e9 / elapsed);
+}
+
+int main(int argc, char** argv) {
+    unsigned frames = argc > 1 ? (unsigned)atoi(argv[1]) : 200;
+    unsigned rows   = argc > 2 ? (unsigned)atoi(argv[2]) : 130;
+    unsigned cols   = argc > 3 ? (unsigned)atoi(argv[3]) : 200;
+    if (frames == 0 || rows == 0 || cols == 0) {
+        fprintf(stderr, "usage: %s [frames] [rows] [cols]\n", argv[0]);
+        return 1;
+    }
+
+    struct notcurses* nc = notcurses_init_headless(NULL, rows, cols);
+    if (!nc) return 1;
+    struct ncplane* n = notcurses_stdplane(nc);
+    fill_colorful(n);
+
+    // Warm up: sizes the output buffer and the front buffer
+    render(nc);
+    notcurses_stats_reset(nc, NULL);
+
+    // Full repaint of every cell
+    uint64_t start = now_ns();
+    for (unsigned i = 0; i < frames; i++) {
+        notcurses_refresh(nc);
+        notcurses_output_clear(nc);
+    }
+    report("full", nc, frames, now_ns() - start);
+
+    // One changed cell per frame
+    start = now_ns();
+    for (unsigned i = 0; i < frames; i++) {
+        ncplane_cursor_move_yx(n, (int)(i % rows), (int)(i % cols));
+        ncplane_putstr(n, (i & 1) ? "#" : "@");
+        render(nc);
+    }
+    report("diff", nc, frames, now_ns() - start);
+
+    // Redraw the whole screen every frame, as TerminalUI does: erase, fill,
+    // and diff against an identical front buffer
+    start = now_ns();
+    for (unsigned i = 0; i < frames; i++) {
+        ncplane_erase(n);
+        fill_colorful(n);
+        render(nc);
+    }
+    report("fill", nc, frames, now_ns() - start);
+
+    start = now_ns();
+    for (unsigned i = 0; i < frames; i++) {
+        ncplane_erase(n);
+        fill_table(n);
+        render(nc);
+    }
+    report("table", nc, frames, now_ns() - start);
+
+    // tail -f: shift everything up one line and write a new bottom line
+    start = now_ns();
+    for (unsigned i = 0; i < frames; i++) {
+        ncplane_scrollup(n, 1);
+        ncplane_cursor_move_yx(n, (int)rows - 1, 0);
+        for (unsigned c = 0; c < cols; c++) {
+            ncplane_putstr(n, (c + i) & 1 ? "-" : "=");
+        }
+        render(nc);
+    }
+    report("scroll", nc, frames, now_ns() - start);
+
+    // Full repaint as the encoder gets more threads
+    fill_colorful(n);
+    static const unsigned threads[] = { 1, 2, 4, 8 };
+    for (size_t t = 0; t < sizeof(threads) / sizeof(*threads); t++) {
+        if (notcurses_set_encode_threads(nc, threads[t]) != 0) break;
+        render(nc);
+        notcurses_stats_reset(nc, NULL);
+        start = now_ns();
+        for (unsigned i = 0; i < frames; i++) {
+            notcurses_refresh(nc);
+            notcurses_output_clear(nc);
+        }
+        char name[16];
+        snprintf(name, sizeof(name), "full-%ut", threads[t]);
+        report(name, nc, frames, now_ns() - start);
+    }
+
+    notcurses_stop(nc);
+    return 0;
+}
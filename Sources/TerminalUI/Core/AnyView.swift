@@ -11,3 +11,14 @@ public struct AnyView: View {
         self._viewType = type(of: view)
     }
 }
+
+// MARK: - Primitive view
+
+extension AnyView {
+    public static func _makeView(_ view: AnyView, inputs: _ViewInputs) {
+        inputs.control.kind = .container
+        if let content = view._storage as? any View {
+            ViewGraph.makeChild(content, inputs: inputs)
+        }
+    }
+}
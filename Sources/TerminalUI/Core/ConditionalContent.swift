@@ -5,3 +5,17 @@ public enum ConditionalContent<TrueContent: View, FalseContent: View>: View {
 
     public var body: Never { fatalError() }
 }
+
+// MARK: - Primitive view
+
+extension ConditionalContent {
+    public static func _makeView(_ view: ConditionalContent, inputs: _ViewInputs) {
+        inputs.control.kind = .container
+        switch view {
+        case .trueContent(let content):
+            ViewGraph.makeChild(content, inputs: inputs)
+        case .falseContent(let content):
+            ViewGraph.makeChild(content, inputs: inputs)
+        }
+    }
+}
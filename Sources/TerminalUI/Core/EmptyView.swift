@@ -3,3 +3,11 @@ public struct EmptyView: View {
     public var body: Never { fatalError() }
     public init() {}
 }
+
+// MARK: - Primitive view
+
+extension EmptyView {
+    public static func _makeView(_ view: EmptyView, inputs: _ViewInputs) {
+        inputs.control.kind = .container
+    }
+}
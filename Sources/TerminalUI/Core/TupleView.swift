@@ -3,7 +3,151 @@ public struct TupleView<T>: View {
     public var value: T
     public var body: Never { fatalError() }
 
+    // Builds each element with its static type. Set by `ViewBuilder`;
+    // tuples created through the public initializer are reflected instead.
+    internal let elements: (any TupleElements.Type)?
+
     public init(_ value: T) {
         self.value = value
+        self.elements = nil
+    }
+
+    internal init(_ value: T, elements: any TupleElements.Type) {
+        self.value = value
+        self.elements = elements
+    }
+}
+
+// MARK: - Primitive view
+
+extension TupleView {
+    public static func _makeView(_ view: TupleView, inputs: _ViewInputs) {
+        inputs.control.kind = .container
+        _makeViewList(view, inputs: inputs)
+    }
+
+    public static func _makeViewList(_ view: TupleView, inputs: _ViewInputs) {
+        if let elements = view.elements {
+            elements.makeViewList(view.value, inputs: inputs)
+        } else {
+            ViewGraph.makeReflectedChildren(view.value, inputs: inputs)
+        }
+    }
+}
+
+// MARK: - Tuple element visitors
+
+/// Adds the elements of a tuple value to a container, one `_makeViewList`
+/// call per element. One conforming type exists per `ViewBuilder` arity.
+internal protocol TupleElements {
+    /// `value` must be the tuple type the conforming type was declared for.
+    static func makeViewList<T>(_ value: T, inputs: _ViewInputs)
+}
+
+internal enum TupleElements2<C0: View, C1: View>: TupleElements {
+    static func makeViewList<T>(_ value: T, inputs: _ViewInputs) {
+        let (c0, c1) = unsafeBitCast(value, to: (C0, C1).self)
+        C0._makeViewList(c0, inputs: inputs)
+        C1._makeViewList(c1, inputs: inputs)
+    }
+}
+
+internal enum TupleElements3<C0: View, C1: View, C2: View>: TupleElements {
+    static func makeViewList<T>(_ value: T, inputs: _ViewInputs) {
+        let (c0, c1, c2) = unsafeBitCast(value, to: (C0, C1, C2).self)
+        C0._makeViewList(c0, inputs: inputs)
+        C1._makeViewList(c1, inputs: inputs)
+        C2._makeViewList(c2, inputs: inputs)
+    }
+}
+
+internal enum TupleElements4<C0: View, C1: View, C2: View, C3: View>: TupleElements {
+    static func makeViewList<T>(_ value: T, inputs: _ViewInputs) {
+        let (c0, c1, c2, c3) = unsafeBitCast(value, to: (C0, C1, C2, C3).self)
+        C0._makeViewList(c0, inputs: inputs)
+        C1._makeViewList(c1, inputs: inputs)
+        C2._makeViewList(c2, inputs: inputs)
+        C3._makeViewList(c3, inputs: inputs)
+    }
+}
+
+internal enum TupleElements5<C0: View, C1: View, C2: View, C3: View, C4: View>: TupleElements {
+    static func makeViewList<T>(_ value: T, inputs: _ViewInputs) {
+        let (c0, c1, c2, c3, c4) = unsafeBitCast(value, to: (C0, C1, C2, C3, C4).self)
+        C0._makeViewList(c0, inputs: inputs)
+        C1._makeViewList(c1, inputs: inputs)
+        C2._makeViewList(c2, inputs: inputs)
+        C3._makeViewList(c3, inputs: inputs)
+        C4._makeViewList(c4, inputs: inputs)
+    }
+}
+
+internal enum TupleElements6<C0: View, C1: View, C2: View, C3: View, C4: View, C5: View>: TupleElements {
+    static func makeViewList<T>(_ value: T, inputs: _ViewInputs) {
+        let (c0, c1, c2, c3, c4, c5) = unsafeBitCast(value, to: (C0, C1, C2, C3, C4, C5).self)
+        C0._makeViewList(c0, inputs: inputs)
+        C1._makeViewList(c1, inputs: inputs)
+        C2._makeViewList(c2, inputs: inputs)
+        C3._makeViewList(c3, inputs: inputs)
+        C4._makeViewList(c4, inputs: inputs)
+        C5._makeViewList(c5, inputs: inputs)
+    }
+}
+
+internal enum TupleElements7<C0: View, C1: View, C2: View, C3: View, C4: View, C5: View, C6: View>: TupleElements {
+    static func makeViewList<T>(_ value: T, inputs: _ViewInputs) {
+        let (c0, c1, c2, c3, c4, c5, c6) = unsafeBitCast(value, to: (C0, C1, C2, C3, C4, C5, C6).self)
+        C0._makeViewList(c0, inputs: inputs)
+        C1._makeViewList(c1, inputs: inputs)
+        C2._makeViewList(c2, inputs: inputs)
+        C3._makeViewList(c3, inputs: inputs)
+        C4._makeViewList(c4, inputs: inputs)
+        C5._makeViewList(c5, inputs: inputs)
+        C6._makeViewList(c6, inputs: inputs)
+    }
+}
+
+internal enum TupleElements8<C0: View, C1: View, C2: View, C3: View, C4: View, C5: View, C6: View, C7: View>: TupleElements {
+    static func makeViewList<T>(_ value: T, inputs: _ViewInputs) {
+        let (c0, c1, c2, c3, c4, c5, c6, c7) = unsafeBitCast(value, to: (C0, C1, C2, C3, C4, C5, C6, C7).self)
+        C0._makeViewList(c0, inputs: inputs)
+        C1._makeViewList(c1, inputs: inputs)
+        C2._makeViewList(c2, inputs: inputs)
+        C3._makeViewList(c3, inputs: inputs)
+        C4._makeViewList(c4, inputs: inputs)
+        C5._makeViewList(c5, inputs: inputs)
+        C6._makeViewList(c6, inputs: inputs)
+        C7._makeViewList(c7, inputs: inputs)
+    }
+}
+
+internal enum TupleElements9<C0: View, C1: View, C2: View, C3: View, C4: View, C5: View, C6: View, C7: View, C8: View>: TupleElements {
+    static func makeViewList<T>(_ value: T, inputs: _ViewInputs) {
+        let (c0, c1, c2, c3, c4, c5, c6, c7, c8) = unsafeBitCast(value, to: (C0, C1, C2, C3, C4, C5, C6, C7, C8).self)
+        C0._makeViewList(c0, inputs: inputs)
+        C1._makeViewList(c1, inputs: inputs)
+        C2._makeViewList(c2, inputs: inputs)
+        C3._makeViewList(c3, inputs: inputs)
+        C4._makeViewList(c4, inputs: inputs)
+        C5._makeViewList(c5, inputs: inputs)
+        C6._makeViewList(c6, inputs: inputs)
+        C7._makeViewList(c7, inputs: inputs)
+        C8._makeViewList(c8, inputs: inputs)
+    }
+}
+
+internal enum TupleElements10<C0: View, C1: View, C2: View, C3: View, C4: View, C5: View, C6: View, C7: View, C8: View, C9: View>: TupleElements {
+    static func makeViewList<T>(_ value: T, inputs: _ViewInputs) {
+        let (c0, c1, c2, c3, c4, c5, c6, c7, c8, c9) = unsafeBitCast(value, to: (C0, C1, C2, C3, C4, C5, C6, C7, C8, C9).self)
+        C0._makeViewList(c0, inputs: inputs)
+        C1._makeViewList(c1, inputs: inputs)
+        C2._makeViewList(c2, inputs: inputs)
+        C3._makeViewList(c3, inputs: inputs)
+        C4._makeViewList(c4, inputs: inputs)
+        C5._makeViewList(c5, inputs: inputs)
+        C6._makeViewList(c6, inputs: inputs)
+        C7._makeViewList(c7, inputs: inputs)
+        C8._makeViewList(c8, inputs: inputs)
+        C9._makeViewList(c9, inputs: inputs)
     }
 }
@@ -1,10 +1,35 @@
 /// A type that represents part of your app's user interface
 /// and provides modifiers that you use to configure views.
+///
+/// When a parent is rebuilt, a child view whose node has no invalidated
+/// state keeps its controls, without evaluating its `body`, if it is
+/// unchanged: equal by `==` if the view conforms to `Equatable`, or
+/// identical byte for byte if it is plain data (no strings, arrays,
+/// closures or class references). Any other view is rebuilt every time
+/// its parent is. Conform a view to `Equatable` to let it be skipped.
 public protocol View {
     /// The type of view representing the body of this view.
     associatedtype Body: View
     /// The content and behavior of the view.
     @ViewBuilder var body: Body { get }
+
+    /// Builds the control for a view. Primitive views implement this;
+    /// the default evaluates `body`.
+    static func _makeView(_ view: Self, inputs: _ViewInputs)
+
+    /// Adds a view to its container's children. The default adds one
+    /// child; `TupleView` adds each of its elements.
+    static func _makeViewList(_ view: Self, inputs: _ViewInputs)
+}
+
+extension View {
+    public static func _makeView(_ view: Self, inputs: _ViewInputs) {
+        ViewGraph.makeBody(of: view, inputs: inputs)
+    }
+
+    public static func _makeViewList(_ view: Self, inputs: _ViewInputs) {
+        ViewGraph.makeChild(view, inputs: inputs)
+    }
 }
 
 // Never conforms to View as a terminal type for leaf views.
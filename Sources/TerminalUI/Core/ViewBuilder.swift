@@ -15,55 +15,55 @@ public struct ViewBuilder {
     public static func buildBlock<C0: View, C1: View>(
         _ c0: C0, _ c1: C1
     ) -> TupleView<(C0, C1)> {
-        TupleView((c0, c1))
+        TupleView((c0, c1), elements: TupleElements2<C0, C1>.self)
     }
 
     public static func buildBlock<C0: View, C1: View, C2: View>(
         _ c0: C0, _ c1: C1, _ c2: C2
     ) -> TupleView<(C0, C1, C2)> {
-        TupleView((c0, c1, c2))
+        TupleView((c0, c1, c2), elements: TupleElements3<C0, C1, C2>.self)
     }
 
     public static func buildBlock<C0: View, C1: View, C2: View, C3: View>(
         _ c0: C0, _ c1: C1, _ c2: C2, _ c3: C3
     ) -> TupleView<(C0, C1, C2, C3)> {
-        TupleView((c0, c1, c2, c3))
+        TupleView((c0, c1, c2, c3), elements: TupleElements4<C0, C1, C2, C3>.self)
     }
 
     public static func buildBlock<C0: View, C1: View, C2: View, C3: View, C4: View>(
         _ c0: C0, _ c1: C1, _ c2: C2, _ c3: C3, _ c4: C4
     ) -> TupleView<(C0, C1, C2, C3, C4)> {
-        TupleView((c0, c1, c2, c3, c4))
+        TupleView((c0, c1, c2, c3, c4), elements: TupleElements5<C0, C1, C2, C3, C4>.self)
     }
 
     public static func buildBlock<C0: View, C1: View, C2: View, C3: View, C4: View, C5: View>(
         _ c0: C0, _ c1: C1, _ c2: C2, _ c3: C3, _ c4: C4, _ c5: C5
     ) -> TupleView<(C0, C1, C2, C3, C4, C5)> {
-        TupleView((c0, c1, c2, c3, c4, c5))
+        TupleView((c0, c1, c2, c3, c4, c5), elements: TupleElements6<C0, C1, C2, C3, C4, C5>.self)
     }
 
     public static func buildBlock<C0: View, C1: View, C2: View, C3: View, C4: View, C5: View, C6: View>(
         _ c0: C0, _ c1: C1, _ c2: C2, _ c3: C3, _ c4: C4, _ c5: C5, _ c6: C6
     ) -> TupleView<(C0, C1, C2, C3, C4, C5, C6)> {
-        TupleView((c0, c1, c2, c3, c4, c5, c6))
+        TupleView((c0, c1, c2, c3, c4, c5, c6), elements: TupleElements7<C0, C1, C2, C3, C4, C5, C6>.self)
     }
 
     public static func buildBlock<C0: View, C1: View, C2: View, C3: View, C4: View, C5: View, C6: View, C7: View>(
         _ c0: C0, _ c1: C1, _ c2: C2, _ c3: C3, _ c4: C4, _ c5: C5, _ c6: C6, _ c7: C7
     ) -> TupleView<(C0, C1, C2, C3, C4, C5, C6, C7)> {
-        TupleView((c0, c1, c2, c3, c4, c5, c6, c7))
+        TupleView((c0, c1, c2, c3, c4, c5, c6, c7), elements: TupleElements8<C0, C1, C2, C3, C4, C5, C6, C7>.self)
     }
 
     public static func buildBlock<C0: View, C1: View, C2: View, C3: View, C4: View, C5: View, C6: View, C7: View, C8: View>(
         _ c0: C0, _ c1: C1, _ c2: C2, _ c3: C3, _ c4: C4, _ c5: C5, _ c6: C6, _ c7: C7, _ c8: C8
     ) -> TupleView<(C0, C1, C2, C3, C4, C5, C6, C7, C8)> {
-        TupleView((c0, c1, c2, c3, c4, c5, c6, c7, c8))
+        TupleView((c0, c1, c2, c3, c4, c5, c6, c7, c8), elements: TupleElements9<C0, C1, C2, C3, C4, C5, C6, C7, C8>.self)
     }
 
     public static func buildBlock<C0: View, C1: View, C2: View, C3: View, C4: View, C5: View, C6: View, C7: View, C8: View, C9: View>(
         _ c0: C0, _ c1: C1, _ c2: C2, _ c3: C3, _ c4: C4, _ c5: C5, _ c6: C6, _ c7: C7, _ c8: C8, _ c9: C9
     ) -> TupleView<(C0, C1, C2, C3, C4, C5, C6, C7, C8, C9)> {
-        TupleView((c0, c1, c2, c3, c4, c5, c6, c7, c8, c9))
+        TupleView((c0, c1, c2, c3, c4, c5, c6, c7, c8, c9), elements: TupleElements10<C0, C1, C2, C3, C4, C5, C6, C7, C8, C9>.self)
     }
 
     // MARK: - Conditional support
@@ -92,4 +92,11 @@ extension Optional: View where Wrapped: View {
             self
         }
     }
+
+    public static func _makeView(_ view: Optional, inputs: _ViewInputs) {
+        inputs.control.kind = .container
+        if let view {
+            ViewGraph.makeChild(view, inputs: inputs)
+        }
+    }
 }
@@ -17,3 +17,12 @@ public struct HStack<Content: View>: View {
         self.content = content()
     }
 }
+
+// MARK: - Primitive view
+
+extension HStack {
+    public static func _makeView(_ view: HStack, inputs: _ViewInputs) {
+        inputs.control.kind = .hstack(alignment: view.alignment, spacing: view.spacing)
+        Content._makeViewList(view.content, inputs: inputs)
+    }
+}
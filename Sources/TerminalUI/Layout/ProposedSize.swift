@@ -1,6 +1,6 @@
 /// A size proposal for layout computation.
 /// nil width/height means "use ideal size".
-internal struct ProposedSize {
+internal struct ProposedSize: Equatable {
     var width: Int?
     var height: Int?
 
@@ -17,3 +17,12 @@ public struct VStack<Content: View>: View {
         self.content = content()
     }
 }
+
+// MARK: - Primitive view
+
+extension VStack {
+    public static func _makeView(_ view: VStack, inputs: _ViewInputs) {
+        inputs.control.kind = .vstack(alignment: view.alignment, spacing: view.spacing)
+        Content._makeViewList(view.content, inputs: inputs)
+    }
+}
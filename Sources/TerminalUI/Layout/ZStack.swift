@@ -14,3 +14,12 @@ public struct ZStack<Content: View>: View {
         self.content = content()
     }
 }
+
+// MARK: - Primitive view
+
+extension ZStack {
+    public static func _makeView(_ view: ZStack, inputs: _ViewInputs) {
+        inputs.control.kind = .zstack(alignment: view.alignment)
+        Content._makeViewList(view.content, inputs: inputs)
+    }
+}
@@ -0,0 +1,32 @@
+/// Internal modifier that draws its content through a cached raster.
+internal struct DrawingGroupModifier: ViewModifier {
+    func body(content: Content) -> some View {
+        content
+    }
+
+    static func _makeView(modifier: DrawingGroupModifier, inputs: _ViewInputs) {
+        // The raster outlives rebuilds of the group itself
+        let cache: RasterCache
+        if let existing = inputs.node.viewState as? RasterCache {
+            cache = existing
+        } else {
+            cache = RasterCache()
+            inputs.node.viewState = cache
+        }
+        cache.control = inputs.control
+        inputs.control.kind = .group(cache)
+    }
+}
+
+extension View {
+    /// Draws this view into an offscreen raster, which later frames copy
+    /// onto the screen instead of drawing the view again.
+    ///
+    /// The raster is redrawn only when this view, or state inside it,
+    /// changes, or when it is given a different size. Use it for large
+    /// subtrees that rarely change. The group is opaque: cells inside its
+    /// frame that it leaves blank cover whatever is drawn beneath it.
+    public func drawingGroup() -> some View {
+        modifier(DrawingGroupModifier())
+    }
+}
@@ -7,6 +7,10 @@ internal struct FrameModifier: ViewModifier {
     func body(content: Content) -> some View {
         content
     }
+
+    static func _makeView(modifier: FrameModifier, inputs: _ViewInputs) {
+        inputs.control.kind = .frame(width: modifier.width, height: modifier.height, alignment: modifier.alignment)
+    }
 }
 
 extension View {
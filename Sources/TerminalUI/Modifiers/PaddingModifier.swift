@@ -6,6 +6,10 @@ internal struct PaddingModifier: ViewModifier {
     func body(content: Content) -> some View {
         content
     }
+
+    static func _makeView(modifier: PaddingModifier, inputs: _ViewInputs) {
+        inputs.control.kind = .padding(edges: modifier.edges, length: modifier.length)
+    }
 }
 
 extension View {
@@ -3,6 +3,16 @@ public protocol ViewModifier {
     associatedtype Body: View
     @ViewBuilder func body(content: Content) -> Body
     typealias Content = _ViewModifierContent<Self>
+
+    /// Sets the control kind for a view with this modifier applied.
+    /// The default is a pass-through container.
+    static func _makeView(modifier: Self, inputs: _ViewInputs)
+}
+
+extension ViewModifier {
+    public static func _makeView(modifier: Self, inputs: _ViewInputs) {
+        inputs.control.kind = .container
+    }
 }
 
 /// A placeholder view representing the content a modifier is applied to.
@@ -21,6 +31,11 @@ public struct ModifiedContent<Content: View, Modifier: ViewModifier>: View {
         self.content = content
         self.modifier = modifier
     }
+
+    public static func _makeView(_ view: ModifiedContent, inputs: _ViewInputs) {
+        Modifier._makeView(modifier: view.modifier, inputs: inputs)
+        Content._makeViewList(view.content, inputs: inputs)
+    }
 }
 
 // Extension on View for .modifier()
@@ -3,23 +3,97 @@ import Foundation
 
 /// The main application run loop that drives the terminal UI.
 public final class Application {
-    private var terminal: Terminal?
+    private var terminal: Terminal? {
+        get { terminalLock.withLock { _terminal } }
+        set { terminalLock.withLock { _terminal = newValue } }
+    }
+    private var _terminal: Terminal?
+    private let terminalLock = NSLock()
     private var canvas: TerminalCanvas?
     private var rootNode: Node?
     private var rootControl: Control?
-    private var needsUpdate = true
+    private var scheduler: FrameScheduler
     private var isRunning = false
+    private let clock = ContinuousClock()
+
+    // Nodes invalidated since the run loop last looked, from any thread
+    private let invalidations = MPSCQueue<Node>()
 
     // Focused button index for keyboard navigation
     private var focusedButtonIndex = 0
-    private var buttonActions: [() -> Void] = []
+    // The button the primary mouse button went down on
+    private var pressedButtonIndex: Int?
+    // Buttons and lists on screen as of the last frame; paging keys scroll
+    // the first list, the wheel the one under the pointer
+    private let hitTestIndex = HitTestIndex()
+    // The controls of the frame being drawn, flattened
+    private let controlArena = ControlArena()
+    // Threads building and laying out large subtrees; nil for one thread
+    private let workPool: WorkPool?
+    // Frames are written by the terminal's render thread
+    private let pipelined: Bool
+    // Mouse events the terminal reports while the application runs
+    private let mouseEvents: MouseEvents
+    // Rows one wheel step scrolls
+    private let wheelRows = 3
+
+    /// Phase timings of the most recently rendered frame.
+    public private(set) var lastFrameTimings: FrameTimings?
+
+    /// Called after every rendered frame with its phase timings.
+    public var onFrame: ((FrameTimings) -> Void)?
+
+    /// How input has been batched and merged since the application started.
+    public private(set) var inputMetrics = InputMetrics()
 
-    public init() {}
+    /// How often drawing groups were copied from their cached raster
+    /// rather than drawn, since the application started.
+    public private(set) var drawingGroupMetrics = DrawingGroupMetrics()
+
+    /// Create an application that renders at most `maximumFramesPerSecond`
+    /// frames per second; 0 renders every invalidation immediately.
+    ///
+    /// With more than one of `threads`, view bodies of large subtrees are
+    /// evaluated, and sibling subtrees measured, on that many threads. The
+    /// result is the same as with one; bodies must then be safe to
+    /// evaluate concurrently with those of other subtrees.
+    ///
+    /// When `pipelined`, the terminal encodes and writes each frame on a
+    /// render thread while the run loop handles input and builds the next
+    /// one; otherwise frames are written before the loop goes on.
+    ///
+    /// While it runs, the application has the terminal report mouse
+    /// buttons, drags and the wheel. With `focusesOnHover`, pointer motion
+    /// is reported too and hovering a button focuses it; terminals then
+    /// send a report for every move.
+    public init(maximumFramesPerSecond: Int = 60, threads: Int = 1, pipelined: Bool = false,
+                focusesOnHover: Bool = false) {
+        scheduler = FrameScheduler(maximumFramesPerSecond: maximumFramesPerSecond)
+        workPool = threads > 1 ? WorkPool(threads: threads) : nil
+        self.pipelined = pipelined
+        mouseEvents = focusesOnHover ? [.buttons, .drags, .motion] : [.buttons, .drags]
+    }
 
     /// Run an application with the given root view.
     public func run<V: View>(_ rootView: V) throws {
         let terminal = try Terminal(flags: TerminalOptions.suppressBanners.rawValue)
+        run(rootView, on: terminal)
+    }
+
+    /// Run an application on an existing terminal until it stops, for
+    /// example a headless terminal whose input was injected beforehand.
+    public func run<V: View>(_ rootView: V, on terminal: Terminal) {
         self.terminal = terminal
+        let wasPipelined = terminal.isPipelined
+        let previousMouseEvents = terminal.mouseEvents
+        terminal.isPipelined = pipelined
+        terminal.mouseEvents = mouseEvents
+        defer {
+            terminal.mouseEvents = previousMouseEvents
+            terminal.isPipelined = wasPipelined
+            self.terminal = nil
+            self.canvas = nil
+        }
 
         let plane = terminal.standardPlane
         let canvas = TerminalCanvas(plane: plane)
@@ -32,79 +106,153 @@ public final class Application {
         rootNode.application = self
         self.rootNode = rootNode
 
-        // Initial render
-        updateAndRender(rootView, terminal: terminal, canvas: canvas, rootNode: rootNode)
-
-        // Main run loop
+        // Main run loop: block on input until the next frame is due, or
+        // indefinitely while nothing is invalidated
         while isRunning {
-            if let event = terminal.getInput(timeout: 50) {
-                switch event.key {
-                case .character("q"), .escape:
-                    isRunning = false
-                case .up:
-                    focusedButtonIndex = max(0, focusedButtonIndex - 1)
-                    needsUpdate = true
-                case .down:
-                    focusedButtonIndex += 1
-                    needsUpdate = true
-                case .enter:
-                    if focusedButtonIndex < buttonActions.count {
-                        buttonActions[focusedButtonIndex]()
-                    }
-                case .resize:
-                    needsUpdate = true
-                default:
-                    break
-                }
+            processInvalidations()
+            if scheduler.isFrameDue(at: clock.now) {
+                updateAndRender(rootView, terminal: terminal, canvas: canvas, rootNode: rootNode)
             }
 
-            if needsUpdate {
-                rootNode.children.removeAll()
-                updateAndRender(rootView, terminal: terminal, canvas: canvas, rootNode: rootNode)
-                needsUpdate = false
+            // Apply everything pending before the next frame, so a burst
+            // of input costs one frame instead of one each
+            let events = terminal.getInputs(timeout: scheduler.inputTimeout(at: clock.now))
+            if !events.isEmpty {
+                apply(InputCoalescer.commands(for: events, metrics: &inputMetrics))
+            }
+        }
+    }
+
+    private func apply(_ commands: [InputCommand]) {
+        for command in commands {
+            switch command {
+            case .quit:
+                isRunning = false
+            case .moveFocus(let offset):
+                focusedButtonIndex = max(0, focusedButtonIndex + offset)
+                scheduler.setNeedsFrame()
+            case .activate:
+                activateButton(at: focusedButtonIndex)
+            case .scroll(let pages):
+                scrollList { $0.scroll(pages: pages) }
+            case .scrollToTop:
+                scrollList { $0.scrollToTop() }
+            case .scrollToBottom:
+                scrollList { $0.scrollToBottom() }
+            case .resize:
+                scheduler.setNeedsFrame()
+            case .point(let position):
+                // Hovering a button focuses it
+                if let button = hitTestIndex.button(atRow: position.y, column: position.x),
+                   button != focusedButtonIndex {
+                    focusedButtonIndex = button
+                    scheduler.setNeedsFrame()
+                }
+            case .press(let position):
+                pressedButtonIndex = hitTestIndex.button(atRow: position.y, column: position.x)
+                if let button = pressedButtonIndex, button != focusedButtonIndex {
+                    focusedButtonIndex = button
+                    scheduler.setNeedsFrame()
+                }
+            case .release(let position):
+                // A click activates a button when it is released over the
+                // button it started on
+                if let button = pressedButtonIndex,
+                   hitTestIndex.button(atRow: position.y, column: position.x) == button {
+                    activateButton(at: button)
+                }
+                pressedButtonIndex = nil
+            case .wheel(let steps, let position):
+                if let list = hitTestIndex.list(atRow: position.y, column: position.x) {
+                    list.scroll(by: steps * wheelRows)
+                    scheduler.setNeedsFrame()
+                }
             }
         }
     }
 
     private func updateAndRender<V: View>(_ rootView: V, terminal: Terminal, canvas: TerminalCanvas, rootNode: Node) {
-        // Build the control tree
-        let control = ViewGraph.buildControl(from: rootView, node: rootNode)
+        var phaseStart = clock.now
+        scheduler.beginFrame(at: phaseStart)
+        var timings = FrameTimings()
+
+        // Build the control tree, reusing unchanged subtrees
+        let control = onWorkPool { ViewGraph.buildControl(from: rootView, node: rootNode, isSameView: true) }
         self.rootControl = control
+        timings.build = lap(&phaseStart)
 
         // Layout
         let dims = terminal.dimensions
         let proposed = ProposedSize.fixed(width: dims.cols, height: dims.rows)
-        control.size = control.sizeThatFits(proposed)
+        control.size = onWorkPool { control.sizeThatFits(proposed) }
+        timings.layout = lap(&phaseStart)
 
-        // Collect button actions
-        buttonActions = collectButtonActions(from: control)
-
-        // Draw
+        // Draw, indexing buttons and lists by where they land on screen
         canvas.clear()
-        let renderer = RenderContext(canvas: canvas)
+        hitTestIndex.reset(rows: dims.rows)
+        let renderer = RenderContext(canvas: canvas, arena: controlArena, hitTestIndex: hitTestIndex)
         renderer.render(control: control)
+        renderer.finish()
+        hitTestIndex.finish()
+        drawingGroupMetrics.add(renderer.drawingGroupMetrics)
+        timings.draw = lap(&phaseStart)
+
+        // Flush the changed cells to the terminal, or queue the frame for
+        // its render thread
         _ = try? terminal.render()
+        timings.flush = lap(&phaseStart)
+
+        lastFrameTimings = timings
+        onFrame?(timings)
+    }
+
+    // Run a build or layout pass, spreading large subtrees over the work
+    // pool when there is one.
+    private func onWorkPool<R>(_ body: () -> R) -> R {
+        guard let workPool else { return body() }
+        return workPool.run(body)
+    }
+
+    // Time elapsed since `start`, which is advanced to now.
+    private func lap(_ start: inout ContinuousClock.Instant) -> Duration {
+        let now = clock.now
+        defer { start = now }
+        return now - start
     }
 
-    /// Invalidate a node (triggers re-render on next loop iteration).
+    /// Invalidate a node from any thread. The node is queued and the run
+    /// loop woken; invalidations are coalesced into the next frame.
     func invalidateNode(_ node: Node) {
-        needsUpdate = true
+        invalidations.push(node)
+        terminal?.wake()
+    }
+
+    /// Mark the queued nodes dirty and request a frame for them.
+    func processInvalidations() {
+        while let node = invalidations.pop() {
+            node.markNeedsUpdate()
+            scheduler.setNeedsFrame()
+        }
     }
 
     /// Stop the application.
     public func stop() {
         isRunning = false
+        terminal?.wake()
     }
 
-    // Collect all button actions from the control tree.
-    private func collectButtonActions(from control: Control) -> [() -> Void] {
-        var actions: [() -> Void] = []
-        if case .button(_, let action) = control.kind {
-            actions.append(action)
-        }
-        for child in control.children {
-            actions.append(contentsOf: collectButtonActions(from: child))
+    // Run the action of a button on screen, in focus order.
+    private func activateButton(at index: Int) {
+        let buttons = hitTestIndex.buttons
+        if index < buttons.count {
+            buttons[index].action()
         }
-        return actions
+    }
+
+    // Scroll the first list on screen and render the result.
+    private func scrollList(_ scroll: (ListContent) -> Void) {
+        guard let list = hitTestIndex.lists.first?.content else { return }
+        scroll(list)
+        scheduler.setNeedsFrame()
     }
 }
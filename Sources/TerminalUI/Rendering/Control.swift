@@ -5,28 +5,116 @@ import NotcursesSwift
 internal class Control {
     var position: Position = .zero
     var size: Size = .zero
-    var children: [Control] = []
+    private(set) var children: [Control] = []
     weak var node: Node?
+    /// The control this one was added to.
+    private(set) weak var parent: Control?
 
     /// The kind of drawing this control performs.
-    var kind: ControlKind = .container
+    var kind: ControlKind = .container {
+        didSet {
+            switch kind {
+            case .text(let content, _, _, _): textWidth = content.count
+            case .button(let label, _): textWidth = label.count + 4
+            default: textWidth = 0
+            }
+            setNeedsLayout()
+        }
+    }
+
+    // Columns taken by the text of a text or button control, counted once
+    // when the kind is set instead of on every layout
+    private var textWidth = 0
+
+    // Result of the last layout pass. It stays valid until the kind or
+    // children of this control or of a descendant change, and is reused
+    // whenever the same size is proposed again.
+    private var needsLayout = true
+    private var cachedProposal: ProposedSize?
+    private var cachedSize: Size = .zero
+
+    /// Number of times this control computed its layout rather than
+    /// answering from the cache.
+    private(set) var layoutCount = 0
+
+    /// Whether the last layout is still valid.
+    var isLaidOut: Bool { !needsLayout }
+
+    /// Where the last `ControlArena` build stored this control's subtree.
+    var arenaSlot = ControlArena.Slot()
+
+    /// Controls in this subtree as of the last build, which tells whether
+    /// building or measuring it is worth spreading over a `WorkPool`.
+    private(set) var subtreeSize = 1
+
+    func updateSubtreeSize() {
+        var size = 1
+        for child in children {
+            size += child.subtreeSize
+        }
+        subtreeSize = size
+    }
 
     func addChild(_ child: Control) {
+        child.parent = self
         children.append(child)
+        setNeedsLayout()
+    }
+
+    /// Replace the child at `index`, e.g. after rebuilding its subtree.
+    func replaceChild(at index: Int, with child: Control) {
+        child.parent = self
+        if children[index] !== child {
+            children[index] = child
+        }
+        setNeedsLayout()
+    }
+
+    /// Clear kind and children so a reused control can be rebuilt.
+    func reset() {
+        kind = .container
+        children.removeAll(keepingCapacity: true)
+    }
+
+    /// Discard the cached layout of this control and of every ancestor.
+    ///
+    /// Walking stops at an ancestor that is already dirty: layout visits
+    /// every child a parent's size depends on, so the ancestors of a dirty
+    /// control are dirty as well.
+    func setNeedsLayout() {
+        needsLayout = true
+        var ancestor = parent
+        while let control = ancestor, !control.needsLayout {
+            control.needsLayout = true
+            ancestor = control.parent
+        }
     }
 
     /// Compute the size this control needs, given a proposal.
+    ///
+    /// Children are positioned as a side effect, so a cached result is only
+    /// returned when the proposal matches the one the current child layout
+    /// was computed for.
     func sizeThatFits(_ proposed: ProposedSize) -> Size {
+        if !needsLayout, cachedProposal == proposed {
+            return cachedSize
+        }
+        let size = computeSize(proposed)
+        layoutCount += 1
+        needsLayout = false
+        cachedProposal = proposed
+        cachedSize = size
+        return size
+    }
+
+    private func computeSize(_ proposed: ProposedSize) -> Size {
         switch kind {
         case .container:
             // Propagate layout to children so their positions get computed
-            for child in children {
-                let childSize = child.sizeThatFits(proposed)
-                child.size = childSize
-            }
+            measureChildren(proposed)
             return Size(width: proposed.width ?? 0, height: proposed.height ?? 0)
-        case .text(let content, _, _, _):
-            return Size(width: content.count, height: 1)
+        case .text:
+            return Size(width: textWidth, height: 1)
         case .spacer(let minLength):
             // Spacers report their minimum length; actual expansion handled by stack
             let min = Int(minLength ?? 0)
@@ -43,9 +131,29 @@ internal class Control {
             let w = width.map { Int($0) } ?? (proposed.width ?? 0)
             let h = height.map { Int($0) } ?? (proposed.height ?? 0)
             return Size(width: w, height: h)
-        case .button(let label, _):
+        case .button:
             // Button renders as "[ label ]"
-            return Size(width: label.count + 4, height: 1)
+            return Size(width: textWidth, height: 1)
+        case .list(let content):
+            return layoutList(content, proposed: proposed)
+        case .group(let cache):
+            // The layout of a group is invalidated by any change inside it,
+            // and only recomputed for such a change or a new proposal; the
+            // raster drawn for the old layout is stale either way
+            cache.invalidate()
+            return layoutZStack(proposed: proposed)
+        }
+    }
+
+    // Size every child for the same proposal. Children are measured
+    // independently of each other, so large ones are spread over the
+    // current `WorkPool`, if any; each writes only its own subtree.
+    private func measureChildren(_ proposed: ProposedSize, skippingSpacers: Bool = false) {
+        let children = self.children
+        WorkPool.forEach(children.count, weight: { children[$0].subtreeSize }) { index in
+            let child = children[index]
+            if skippingSpacers, case .spacer = child.kind { return }
+            child.size = child.sizeThatFits(proposed)
         }
     }
 
@@ -55,9 +163,9 @@ internal class Control {
         let gap = Int(spacing ?? 1)
         var totalHeight = 0
         var maxWidth = 0
+        measureChildren(proposed)
         for (i, child) in children.enumerated() {
-            let childSize = child.sizeThatFits(proposed)
-            child.size = childSize
+            let childSize = child.size
             child.position = Position(x: 0, y: totalHeight)
             totalHeight += childSize.height
             if i < children.count - 1 { totalHeight += gap }
@@ -85,14 +193,13 @@ internal class Control {
         // First pass: measure non-spacer children
         var spacerIndices: [Int] = []
         var fixedWidth = 0
+        measureChildren(proposed, skippingSpacers: true)
         for (i, child) in children.enumerated() {
             if case .spacer = child.kind {
                 spacerIndices.append(i)
             } else {
-                let childSize = child.sizeThatFits(proposed)
-                child.size = childSize
-                fixedWidth += childSize.width
-                maxHeight = max(maxHeight, childSize.height)
+                fixedWidth += child.size.width
+                maxHeight = max(maxHeight, child.size.height)
             }
         }
 
@@ -128,9 +235,9 @@ internal class Control {
     private func layoutZStack(proposed: ProposedSize) -> Size {
         var maxWidth = 0
         var maxHeight = 0
+        measureChildren(proposed)
         for child in children {
-            let childSize = child.sizeThatFits(proposed)
-            child.size = childSize
+            let childSize = child.size
             child.position = .zero
             maxWidth = max(maxWidth, childSize.width)
             maxHeight = max(maxHeight, childSize.height)
@@ -138,6 +245,40 @@ internal class Control {
         return Size(width: maxWidth, height: maxHeight)
     }
 
+    /// Build and stack only the rows that fit in the proposed height,
+    /// starting at the list's scroll position. Every row occupies at least
+    /// one line.
+    private func layoutList(_ content: ListContent, proposed: ProposedSize) -> Size {
+        let viewportHeight = proposed.height ?? 24
+        let rowProposal = ProposedSize(width: proposed.width, height: nil)
+        content.beginLayout()
+        let first = content.firstVisibleRow
+        var rows: [Control] = []
+        var totalHeight = 0
+        var maxWidth = 0
+        var index = first
+        while index < content.count && totalHeight < viewportHeight {
+            let row = content.rowControl(at: index)
+            let rowSize = row.sizeThatFits(rowProposal)
+            row.size = rowSize
+            row.position = Position(x: 0, y: totalHeight)
+            rows.append(row)
+            totalHeight += max(1, rowSize.height)
+            maxWidth = max(maxWidth, rowSize.width)
+            index += 1
+        }
+        content.endLayout(visible: first..<index)
+
+        // Rows are replaced as part of this layout; re-parenting them must
+        // not invalidate the layout being computed
+        for row in rows {
+            row.parent = self
+        }
+        children = rows
+        updateSubtreeSize()
+        return Size(width: maxWidth, height: min(totalHeight, viewportHeight))
+    }
+
     private func layoutPadding(edges: Edge.Set, length: CGFloat?, proposed: ProposedSize) -> Size {
         let pad = Int(length ?? 1)
         let topPad = edges.contains(.top) ? pad : 0
@@ -176,4 +317,6 @@ internal enum ControlKind {
     case padding(edges: Edge.Set, length: CGFloat?)
     case frame(width: CGFloat?, height: CGFloat?, alignment: Alignment)
     case button(label: String, action: () -> Void)
+    case list(ListContent)
+    case group(RasterCache)
 }
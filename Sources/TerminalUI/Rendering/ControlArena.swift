@@ -0,0 +1,382 @@
+import NotcursesSwift
+
+/// The controls of one laid-out frame, flattened into parallel arrays.
+///
+/// Controls are stored in draw order (a control before its children,
+/// children in order), with screen positions already resolved, so drawing
+/// is a single pass over plain values instead of a walk through reference
+/// counted objects. Tree structure is kept as parent, first-child and
+/// next-sibling indices. The text of every control lives in one byte
+/// arena. The arrays keep their storage across `reset()`, so a frame
+/// allocates nothing once the arena has grown to the size of the screen.
+///
+/// Building only visits the controls laid out again since the last build.
+/// A subtree whose layout was answered from the cache is copied from the
+/// previous frame's arrays as one slice, without touching its controls.
+internal final class ControlArena {
+    /// What a control draws.
+    enum Kind: UInt8 {
+        /// Draws nothing itself: stacks, padding, frames, spacers.
+        case container
+        case text
+        case button
+        case list
+        /// A drawing group, copied from its raster. Its subtree is not in
+        /// the arena.
+        case group
+    }
+
+    /// Where a control's subtree was stored by the build that last wrote
+    /// it, relative to its parent's, which stays true while the parent's
+    /// subtree is copied unchanged from frame to frame.
+    struct Slot {
+        fileprivate var arena: ObjectIdentifier?
+        // The parent, nil for the root of a build, and its version then
+        fileprivate var parent: ObjectIdentifier?
+        fileprivate var parentVersion = 0
+        // Bumped each time the control's children are visited, which
+        // moves them within its subtree
+        fileprivate var version = 0
+        // The control's layout count when stored; a higher one means its
+        // subtree was laid out again since
+        fileprivate var layoutCount = 0
+        fileprivate var offset = Location()
+        fileprivate var extent = Location()
+    }
+
+    // Positions in, or counts of, each array a subtree takes a range of
+    fileprivate struct Location {
+        var control = 0
+        var text = 0
+        var action = 0
+        var list = 0
+        var group = 0
+
+        static func + (lhs: Location, rhs: Location) -> Location {
+            Location(control: lhs.control + rhs.control, text: lhs.text + rhs.text,
+                     action: lhs.action + rhs.action, list: lhs.list + rhs.list,
+                     group: lhs.group + rhs.group)
+        }
+
+        static func - (lhs: Location, rhs: Location) -> Location {
+            Location(control: lhs.control - rhs.control, text: lhs.text - rhs.text,
+                     action: lhs.action - rhs.action, list: lhs.list - rhs.list,
+                     group: lhs.group - rhs.group)
+        }
+    }
+
+    // The control whose children are being appended
+    private struct Parent {
+        var index: Int32
+        var id: ObjectIdentifier?
+        var version: Int
+        var location: Location
+        // Where its subtree was in the last frame, if it was there, and
+        // its version then
+        var previousLocation: Location?
+        var previousVersion: Int
+    }
+
+    // The arrays of a frame, kept for the next build to copy from
+    private struct Columns {
+        var kinds: [Kind] = []
+        var offsets: [Position] = []
+        var positions: [Position] = []
+        var sizes: [Size] = []
+        var parents: [Int32] = []
+        var firstChild: [Int32] = []
+        var nextSibling: [Int32] = []
+        var textStart: [Int32] = []
+        var textLength: [Int32] = []
+        var foregrounds: [RGBColor?] = []
+        var attributes: [TextAttribute] = []
+        var text: [UInt8] = []
+        var actions: [() -> Void] = []
+        var lists: [ListContent] = []
+        var groups: [RasterCache] = []
+
+        mutating func removeAll() {
+            kinds.removeAll(keepingCapacity: true)
+            offsets.removeAll(keepingCapacity: true)
+            positions.removeAll(keepingCapacity: true)
+            sizes.removeAll(keepingCapacity: true)
+            parents.removeAll(keepingCapacity: true)
+            firstChild.removeAll(keepingCapacity: true)
+            nextSibling.removeAll(keepingCapacity: true)
+            textStart.removeAll(keepingCapacity: true)
+            textLength.removeAll(keepingCapacity: true)
+            foregrounds.removeAll(keepingCapacity: true)
+            attributes.removeAll(keepingCapacity: true)
+            text.removeAll(keepingCapacity: true)
+            actions.removeAll(keepingCapacity: true)
+            lists.removeAll(keepingCapacity: true)
+            groups.removeAll(keepingCapacity: true)
+        }
+    }
+
+    /// No control; the end of a sibling chain.
+    static let none: Int32 = -1
+
+    private(set) var kinds: [Kind] = []
+    /// Top-left corner relative to the parent's.
+    private(set) var offsets: [Position] = []
+    /// Top-left corner in screen coordinates.
+    private(set) var positions: [Position] = []
+    private(set) var sizes: [Size] = []
+    private(set) var parents: [Int32] = []
+    private(set) var firstChild: [Int32] = []
+    private(set) var nextSibling: [Int32] = []
+    /// Where each control's text starts in `text`, and its length in bytes.
+    private(set) var textStart: [Int32] = []
+    private(set) var textLength: [Int32] = []
+    private(set) var foregrounds: [RGBColor?] = []
+    private(set) var attributes: [TextAttribute] = []
+    /// UTF-8 text of every control, back to back.
+    private(set) var text: [UInt8] = []
+
+    /// Button actions, list contents and drawing group rasters, in draw
+    /// order.
+    private(set) var actions: [() -> Void] = []
+    private(set) var lists: [ListContent] = []
+    private(set) var groups: [RasterCache] = []
+
+    /// Controls the last build copied from the frame before instead of
+    /// visiting them.
+    private(set) var reusedCount = 0
+
+    private var lastFrame = Columns()
+    // Counts builds; a root stored by the last one can be copied
+    private var revision = 0
+
+    /// Number of controls in the frame.
+    var count: Int { kinds.count }
+
+    /// Forget the last frame, keeping the storage.
+    func reset() {
+        removeAllColumns()
+        lastFrame.removeAll()
+        reusedCount = 0
+        // Nothing stored before matches the next build's root
+        revision += 2
+    }
+
+    /// Replace the contents with the laid-out tree under `root`.
+    func build(from root: Control) {
+        beginBuild()
+        append(root, offset: root.position, parent: rootParent)
+        resolvePositions()
+    }
+
+    /// Replace the contents with the subtree of a drawing group, placed
+    /// relative to the group's top-left corner.
+    func build(groupContents group: Control) {
+        beginBuild()
+        append(group, offset: .zero, parent: rootParent, expandingGroup: true)
+        resolvePositions()
+    }
+
+    /// The text of a control as UTF-8.
+    func text(of index: Int) -> String {
+        let start = Int(textStart[index])
+        return String(decoding: text[start ..< start + Int(textLength[index])], as: UTF8.self)
+    }
+
+    /// Indices of the children of a control, in order.
+    func children(of index: Int) -> [Int] {
+        var result: [Int] = []
+        var child = firstChild[index]
+        while child != ControlArena.none {
+            result.append(Int(child))
+            child = nextSibling[Int(child)]
+        }
+        return result
+    }
+
+    // Keep the last frame to copy from, and build the next one in the
+    // storage of the frame before it
+    private func beginBuild() {
+        swapColumns(&lastFrame)
+        removeAllColumns()
+        reusedCount = 0
+        revision += 1
+    }
+
+    // The root of a build has no parent; it can be copied if it was the
+    // root of the last one
+    private var rootParent: Parent {
+        Parent(index: ControlArena.none, id: nil, version: revision, location: Location(),
+               previousLocation: Location(), previousVersion: revision - 1)
+    }
+
+    private var location: Location {
+        Location(control: kinds.count, text: text.count, action: actions.count,
+                 list: lists.count, group: groups.count)
+    }
+
+    private func removeAllColumns() {
+        var columns = Columns()
+        swapColumns(&columns)
+        columns.removeAll()
+        swapColumns(&columns)
+    }
+
+    private func swapColumns(_ columns: inout Columns) {
+        swap(&kinds, &columns.kinds)
+        swap(&offsets, &columns.offsets)
+        swap(&positions, &columns.positions)
+        swap(&sizes, &columns.sizes)
+        swap(&parents, &columns.parents)
+        swap(&firstChild, &columns.firstChild)
+        swap(&nextSibling, &columns.nextSibling)
+        swap(&textStart, &columns.textStart)
+        swap(&textLength, &columns.textLength)
+        swap(&foregrounds, &columns.foregrounds)
+        swap(&attributes, &columns.attributes)
+        swap(&text, &columns.text)
+        swap(&actions, &columns.actions)
+        swap(&lists, &columns.lists)
+        swap(&groups, &columns.groups)
+    }
+
+    // Screen positions from the offsets, parents first
+    private func resolvePositions() {
+        for i in 0 ..< kinds.count {
+            let parent = parents[i]
+            if parent == ControlArena.none {
+                positions[i] = offsets[i]
+            } else {
+                let origin = positions[Int(parent)]
+                positions[i] = Position(x: origin.x + offsets[i].x, y: origin.y + offsets[i].y)
+            }
+        }
+    }
+
+    // Append a control and its subtree at `offset` from its parent,
+    // copying the subtree from the last frame if it has not been laid out
+    // since. A drawing group is appended without its subtree unless
+    // `expandingGroup`. Returns the control's index.
+    @discardableResult
+    private func append(_ control: Control, offset: Position, parent: Parent,
+                        expandingGroup: Bool = false) -> Int32 {
+        let id = ObjectIdentifier(self)
+        let slot = control.arenaSlot
+        let start = location
+        var previousLocation: Location?
+        if let parentLocation = parent.previousLocation, slot.arena == id,
+           slot.parent == parent.id, slot.parentVersion == parent.previousVersion {
+            previousLocation = parentLocation + slot.offset
+        }
+        if let previousLocation, slot.layoutCount == control.layoutCount, control.isLaidOut {
+            copy(from: previousLocation, extent: slot.extent)
+            let index = start.control
+            offsets[index] = offset
+            sizes[index] = control.size
+            parents[index] = parent.index
+            nextSibling[index] = ControlArena.none
+            control.arenaSlot = Slot(arena: id, parent: parent.id, parentVersion: parent.version,
+                                     version: slot.version, layoutCount: slot.layoutCount,
+                                     offset: start - parent.location, extent: slot.extent)
+            return Int32(index)
+        }
+
+        let index = Int32(kinds.count)
+        let firstByte = Int32(text.count)
+        var kind = Kind.container
+        var foreground: RGBColor?
+        var styles: TextAttribute = []
+
+        switch control.kind {
+        case .text(let content, let color, let isBold, let isItalic):
+            kind = .text
+            appendText(content)
+            foreground = color?.rgbColor
+            if isBold { styles.insert(.bold) }
+            if isItalic { styles.insert(.italic) }
+        case .button(let label, let action):
+            // Drawn as "[ label ]" with highlight
+            kind = .button
+            text.append(contentsOf: "[ ".utf8)
+            appendText(label)
+            text.append(contentsOf: " ]".utf8)
+            foreground = Color.cyan.rgbColor
+            styles = .bold
+            actions.append(action)
+        case .list(let content):
+            kind = .list
+            lists.append(content)
+        case .group(let cache) where !expandingGroup:
+            kind = .group
+            groups.append(cache)
+        case .group, .container, .vstack, .hstack, .zstack, .padding, .frame, .spacer:
+            break
+        }
+
+        kinds.append(kind)
+        offsets.append(offset)
+        positions.append(.zero)
+        sizes.append(control.size)
+        parents.append(parent.index)
+        firstChild.append(ControlArena.none)
+        nextSibling.append(ControlArena.none)
+        textStart.append(firstByte)
+        textLength.append(Int32(text.count) - firstByte)
+        foregrounds.append(foreground)
+        attributes.append(styles)
+
+        let version = slot.version + 1
+        if kind != .group {
+            let this = Parent(index: index, id: ObjectIdentifier(control), version: version,
+                              location: start, previousLocation: previousLocation,
+                              previousVersion: slot.version)
+            var previous = ControlArena.none
+            for child in control.children {
+                let childIndex = append(child, offset: child.position, parent: this)
+                if previous == ControlArena.none {
+                    firstChild[Int(index)] = childIndex
+                } else {
+                    nextSibling[Int(previous)] = childIndex
+                }
+                previous = childIndex
+            }
+        }
+
+        control.arenaSlot = Slot(arena: id, parent: parent.id, parentVersion: parent.version,
+                                 version: version, layoutCount: control.layoutCount,
+                                 offset: start - parent.location, extent: location - start)
+        return index
+    }
+
+    // Append a subtree stored in the last frame, moving its indices and
+    // text ranges to where it now lands
+    private func copy(from source: Location, extent: Location) {
+        let controls = source.control ..< source.control + extent.control
+        let shift = Int32(kinds.count - source.control)
+        let textShift = Int32(text.count - source.text)
+
+        kinds.append(contentsOf: lastFrame.kinds[controls])
+        offsets.append(contentsOf: lastFrame.offsets[controls])
+        positions.append(contentsOf: lastFrame.positions[controls])
+        sizes.append(contentsOf: lastFrame.sizes[controls])
+        parents.append(contentsOf: lastFrame.parents[controls].lazy.map { $0 + shift })
+        firstChild.append(contentsOf: lastFrame.firstChild[controls].lazy.map {
+            $0 == ControlArena.none ? $0 : $0 + shift
+        })
+        nextSibling.append(contentsOf: lastFrame.nextSibling[controls].lazy.map {
+            $0 == ControlArena.none ? $0 : $0 + shift
+        })
+        textStart.append(contentsOf: lastFrame.textStart[controls].lazy.map { $0 + textShift })
+        textLength.append(contentsOf: lastFrame.textLength[controls])
+        foregrounds.append(contentsOf: lastFrame.foregrounds[controls])
+        attributes.append(contentsOf: lastFrame.attributes[controls])
+        text.append(contentsOf: lastFrame.text[source.text ..< source.text + extent.text])
+        actions.append(contentsOf: lastFrame.actions[source.action ..< source.action + extent.action])
+        lists.append(contentsOf: lastFrame.lists[source.list ..< source.list + extent.list])
+        groups.append(contentsOf: lastFrame.groups[source.group ..< source.group + extent.group])
+        reusedCount += extent.control
+    }
+
+    private func appendText(_ string: String) {
+        var string = string
+        string.withUTF8 { text.append(contentsOf: $0) }
+    }
+}
@@ -0,0 +1,15 @@
+/// Counters describing how drawing groups were drawn.
+public struct DrawingGroupMetrics: Equatable, Sendable {
+    /// Groups copied onto the screen from the raster of an earlier frame.
+    public var hits = 0
+    /// Groups drawn into their raster: the first time they were on screen,
+    /// and after each change to their view, their state or their size.
+    public var misses = 0
+
+    public init() {}
+
+    mutating func add(_ other: DrawingGroupMetrics) {
+        hits += other.hits
+        misses += other.misses
+    }
+}
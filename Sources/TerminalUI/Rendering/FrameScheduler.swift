@@ -0,0 +1,52 @@
+/// Decides when the run loop renders a frame.
+///
+/// Invalidations only mark a frame as pending, so any number of them between
+/// two ticks produce a single frame, and frames are spaced at least
+/// `minimumFrameInterval` apart. With nothing pending the run loop blocks on
+/// input indefinitely instead of polling.
+internal struct FrameScheduler {
+    /// Shortest time between the starts of two frames; zero is uncapped.
+    let minimumFrameInterval: Duration
+    /// Some view was invalidated since the last frame started.
+    private(set) var needsFrame = true
+    private var lastFrame: ContinuousClock.Instant?
+
+    init(maximumFramesPerSecond: Int) {
+        minimumFrameInterval = maximumFramesPerSecond > 0
+            ? .seconds(1) / maximumFramesPerSecond
+            : .zero
+    }
+
+    /// Request a frame at the next tick.
+    mutating func setNeedsFrame() {
+        needsFrame = true
+    }
+
+    /// Whether the pending frame may be rendered now.
+    func isFrameDue(at now: ContinuousClock.Instant) -> Bool {
+        guard needsFrame else { return false }
+        guard let lastFrame else { return true }
+        return now - lastFrame >= minimumFrameInterval
+    }
+
+    /// Milliseconds to wait for input before the pending frame is due:
+    /// 0 if it is due already, -1 (wait indefinitely) when idle.
+    func inputTimeout(at now: ContinuousClock.Instant) -> Int {
+        guard needsFrame else { return -1 }
+        guard let lastFrame else { return 0 }
+        let remaining = lastFrame + minimumFrameInterval - now
+        guard remaining > .zero else { return 0 }
+        // Round up so the wait never ends just short of the deadline
+        let (seconds, attoseconds) = remaining.components
+        let attosecondsPerMillisecond: Int64 = 1_000_000_000_000_000
+        return Int(seconds) * 1000
+            + Int((attoseconds + attosecondsPerMillisecond - 1) / attosecondsPerMillisecond)
+    }
+
+    /// Record that a frame starts now; invalidations from here on request
+    /// the next one.
+    mutating func beginFrame(at now: ContinuousClock.Instant) {
+        needsFrame = false
+        lastFrame = now
+    }
+}
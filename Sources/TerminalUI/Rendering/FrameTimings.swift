@@ -0,0 +1,25 @@
+/// Time spent in each phase of one rendered frame.
+public struct FrameTimings: Equatable, Sendable {
+    /// Re-evaluating invalidated views into the control tree.
+    public var build: Duration
+    /// Measuring and positioning controls.
+    public var layout: Duration
+    /// Drawing controls onto the terminal plane.
+    public var draw: Duration
+    /// Diffing the plane and writing the changes to the terminal, or with
+    /// a pipelined terminal, handing the frame to its render thread.
+    public var flush: Duration
+
+    public init(build: Duration = .zero, layout: Duration = .zero,
+                draw: Duration = .zero, flush: Duration = .zero) {
+        self.build = build
+        self.layout = layout
+        self.draw = draw
+        self.flush = flush
+    }
+
+    /// Time spent on the whole frame.
+    public var total: Duration {
+        build + layout + draw + flush
+    }
+}
@@ -0,0 +1,125 @@
+/// Where the interactive controls of the last frame landed on screen.
+///
+/// The index is filled in while a frame is drawn, since drawing already
+/// visits every control at its absolute position, so input never walks the
+/// control tree. Buttons are kept in focus order and, for each screen row,
+/// sorted by left edge. Finding the button under a cell is then a binary
+/// search plus a step back over any buttons that overlap it.
+internal final class HitTestIndex {
+    /// A rectangle of cells in screen coordinates.
+    struct Region: Equatable {
+        var x: Int
+        var y: Int
+        var width: Int
+        var height: Int
+
+        func contains(row: Int, column: Int) -> Bool {
+            column >= x && column < x + width && row >= y && row < y + height
+        }
+    }
+
+    struct Button {
+        var region: Region
+        var action: () -> Void
+    }
+
+    struct List {
+        var region: Region
+        var content: ListContent
+    }
+
+    /// Buttons in focus order, which is the order they were drawn.
+    private(set) var buttons: [Button] = []
+    /// Lists in the order they were drawn.
+    private(set) var lists: [List] = []
+
+    // One button crossing one row. `reach` is the largest right edge of
+    // this span and every span before it in the row, which bounds how far
+    // back a search has to look for spans covering a column.
+    private struct Span {
+        var start: Int
+        var end: Int
+        var reach: Int
+        var button: Int
+    }
+    // Spans per screen row, sorted by start once the frame is drawn
+    private var rows: [[Span]] = []
+
+    /// Forget the last frame and prepare for a screen `rows` tall.
+    func reset(rows count: Int) {
+        buttons.removeAll(keepingCapacity: true)
+        lists.removeAll(keepingCapacity: true)
+        if rows.count != count {
+            rows = Array(repeating: [], count: max(0, count))
+        } else {
+            for row in rows.indices {
+                rows[row].removeAll(keepingCapacity: true)
+            }
+        }
+    }
+
+    /// Record a button drawn at `position` with `size`, both in screen cells.
+    func addButton(at position: Position, size: Size, action: @escaping () -> Void) {
+        let region = Region(x: position.x, y: position.y, width: size.width, height: size.height)
+        let index = buttons.count
+        buttons.append(Button(region: region, action: action))
+        let top = max(0, region.y)
+        let bottom = min(rows.count, region.y + region.height)
+        guard region.width > 0, top < bottom else { return }
+        let end = region.x + region.width
+        for row in top ..< bottom {
+            rows[row].append(Span(start: region.x, end: end, reach: end, button: index))
+        }
+    }
+
+    /// Record a list drawn at `position` with `size`, both in screen cells.
+    func addList(_ content: ListContent, at position: Position, size: Size) {
+        let region = Region(x: position.x, y: position.y, width: size.width, height: size.height)
+        lists.append(List(region: region, content: content))
+    }
+
+    /// Sort the rows for searching once every control has been added.
+    func finish() {
+        for row in rows.indices where !rows[row].isEmpty {
+            // Buttons in a row are usually added left to right already
+            rows[row].sort { ($0.start, $0.button) < ($1.start, $1.button) }
+            var reach = Int.min
+            for i in rows[row].indices {
+                reach = max(reach, rows[row][i].end)
+                rows[row][i].reach = reach
+            }
+        }
+    }
+
+    /// The index of the button at a cell; where buttons overlap, the one
+    /// drawn last.
+    func button(atRow row: Int, column: Int) -> Int? {
+        guard rows.indices.contains(row) else { return nil }
+        let spans = rows[row]
+        // First span starting right of the column
+        var low = 0
+        var high = spans.count
+        while low < high {
+            let mid = (low + high) / 2
+            if spans[mid].start <= column {
+                low = mid + 1
+            } else {
+                high = mid
+            }
+        }
+        var found: Int?
+        var i = low - 1
+        while i >= 0 && spans[i].reach > column {
+            if spans[i].end > column {
+                found = max(found ?? spans[i].button, spans[i].button)
+            }
+            i -= 1
+        }
+        return found
+    }
+
+    /// The list at a cell; where lists nest, the innermost.
+    func list(atRow row: Int, column: Int) -> ListContent? {
+        lists.last { $0.region.contains(row: row, column: column) }?.content
+    }
+}
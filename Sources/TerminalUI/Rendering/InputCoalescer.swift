@@ -0,0 +1,133 @@
+import NotcursesSwift
+
+/// What the run loop does for a batch of input.
+internal enum InputCommand: Equatable {
+    case quit
+    /// Move keyboard focus by a number of buttons; negative moves up.
+    case moveFocus(Int)
+    /// Activate the focused button.
+    case activate
+    /// Scroll the list by a number of pages; negative scrolls up.
+    case scroll(pages: Int)
+    case scrollToTop
+    case scrollToBottom
+    case resize
+    /// The mouse pointer moved to a cell.
+    case point(Position)
+    /// The primary mouse button went down or up at a cell.
+    case press(Position)
+    case release(Position)
+    /// The wheel turned by a number of steps over a cell; negative is up.
+    case wheel(Int, at: Position)
+}
+
+/// Turns the events pending at the start of a loop iteration into
+/// commands, merging runs that only need their net effect.
+///
+/// A held arrow key delivers many events between two frames. Merged, they
+/// cost one state change and the batch renders once, so the UI keeps up
+/// with the key repeat instead of falling behind it.
+internal enum InputCoalescer {
+    static func commands(for events: [InputEvent], metrics: inout InputMetrics) -> [InputCommand] {
+        metrics.eventsReceived += events.count
+        metrics.batches += 1
+        metrics.lastQueueDepth = events.count
+        metrics.maximumQueueDepth = max(metrics.maximumQueueDepth, events.count)
+
+        var commands: [InputCommand] = []
+        var resized = false
+        for (index, event) in events.enumerated() {
+            switch event.key {
+            case .character("q"), .escape:
+                commands.append(.quit)
+                metrics.eventsDropped += events.count - index - 1
+                return commands
+            case .up:
+                merge(.moveFocus(-1), into: &commands, metrics: &metrics)
+            case .down:
+                merge(.moveFocus(1), into: &commands, metrics: &metrics)
+            case .pageUp:
+                merge(.scroll(pages: -1), into: &commands, metrics: &metrics)
+            case .pageDown:
+                merge(.scroll(pages: 1), into: &commands, metrics: &metrics)
+            case .home:
+                merge(.scrollToTop, into: &commands, metrics: &metrics)
+            case .end:
+                merge(.scrollToBottom, into: &commands, metrics: &metrics)
+            case .enter:
+                commands.append(.activate)
+            case .mouse(let mouse):
+                let position = Position(x: mouse.column, y: mouse.row)
+                switch (mouse.action, mouse.button) {
+                case (.move, _):
+                    merge(.point(position), into: &commands, metrics: &metrics)
+                case (.press, .left):
+                    commands.append(.press(position))
+                case (.release, .left):
+                    commands.append(.release(position))
+                case (.press, .scrollUp):
+                    merge(.wheel(-1, at: position), into: &commands, metrics: &metrics)
+                case (.press, .scrollDown):
+                    merge(.wheel(1, at: position), into: &commands, metrics: &metrics)
+                default:
+                    break
+                }
+            case .resize:
+                // One frame at the new size covers every resize in the batch
+                if resized {
+                    metrics.eventsDropped += 1
+                } else {
+                    commands.append(.resize)
+                    resized = true
+                }
+            default:
+                break
+            }
+        }
+        return commands
+    }
+
+    // Append a command, folding it into the previous one when only their
+    // combined effect matters.
+    private static func merge(_ command: InputCommand, into commands: inout [InputCommand],
+                              metrics: inout InputMetrics) {
+        guard let last = commands.last else {
+            commands.append(command)
+            return
+        }
+        let merged: InputCommand?
+        switch (last, command) {
+        // Steps are clamped one at a time when applied, so only steps in the
+        // same direction add up to the same result; Up then Down on the
+        // first button ends on the second
+        case (.moveFocus(let a), .moveFocus(let b)) where sameDirection(a, b):
+            merged = .moveFocus(a + b)
+        case (.scroll(pages: let a), .scroll(pages: let b)) where sameDirection(a, b):
+            merged = .scroll(pages: a + b)
+        case (.scroll, .scrollToTop), (.scroll, .scrollToBottom),
+             (.scrollToTop, .scrollToTop), (.scrollToTop, .scrollToBottom),
+             (.scrollToBottom, .scrollToTop), (.scrollToBottom, .scrollToBottom):
+            // Jumping to an end overrides the scrolling before it
+            merged = command
+        case (.point, .point):
+            // Only where the pointer ended up matters
+            merged = command
+        case (.wheel(let a, let previous), .wheel(let b, let position))
+            where previous == position && sameDirection(a, b):
+            // Over another cell the wheel may be over another list
+            merged = .wheel(a + b, at: position)
+        default:
+            merged = nil
+        }
+        if let merged {
+            commands[commands.count - 1] = merged
+            metrics.eventsMerged += 1
+        } else {
+            commands.append(command)
+        }
+    }
+
+    private static func sameDirection(_ a: Int, _ b: Int) -> Bool {
+        (a < 0) == (b < 0)
+    }
+}
@@ -0,0 +1,18 @@
+/// Counters describing how the run loop consumed input.
+public struct InputMetrics: Equatable, Sendable {
+    /// Events read from the terminal.
+    public var eventsReceived = 0
+    /// Events folded into a neighbouring event of the same kind, such as
+    /// repeated arrow keys becoming one focus move.
+    public var eventsMerged = 0
+    /// Events discarded: repeated resizes and input after a quit key.
+    public var eventsDropped = 0
+    /// Batches of input read, each applied before at most one frame.
+    public var batches = 0
+    /// Events pending when the most recent batch was read.
+    public var lastQueueDepth = 0
+    /// Most events pending at once.
+    public var maximumQueueDepth = 0
+
+    public init() {}
+}
@@ -0,0 +1,110 @@
+/// Scroll state and row storage for a `List`, kept on the list's node.
+///
+/// Rows are not children of the list node: they are built during layout,
+/// only for the visible range, and their nodes are recycled as the list
+/// scrolls. Row nodes still point at the list node as their parent so
+/// state changes inside a row invalidate the list.
+internal final class ListContent {
+    /// Number of rows in the data.
+    private(set) var count = 0
+    /// Index of the topmost visible row.
+    private(set) var firstVisibleRow = 0
+    /// Rows that fit in the viewport at the last layout.
+    private(set) var visibleRowCount = 0
+    /// The control presenting the list.
+    weak var control: Control?
+
+    private weak var node: Node?
+    private let rowType: Any.Type
+    private var makeRow: ((Int, Node) -> Control)?
+    // Nodes of the rows laid out last, by row index
+    private var rowNodes: [Int: Node] = [:]
+    // Nodes of rows scrolled out of view, ready for reuse
+    private var recycledNodes: [Node] = []
+
+    init(node: Node, rowType: Any.Type) {
+        self.node = node
+        self.rowType = rowType
+    }
+
+    /// Install the row count and row builder of the current list view.
+    func update(count: Int, makeRow: @escaping (Int, Node) -> Control) {
+        self.count = count
+        self.makeRow = makeRow
+        firstVisibleRow = clamped(firstVisibleRow)
+    }
+
+    /// Start a layout pass. Rows expected to scroll out of view, judging by
+    /// the last viewport, hand their nodes to the rows scrolling in.
+    func beginLayout() {
+        let expected = firstVisibleRow..<(firstVisibleRow + max(1, visibleRowCount))
+        recycleRows(outside: expected)
+    }
+
+    /// Build the control for a row, reusing its node if it was visible in
+    /// the last layout or a recycled node otherwise.
+    func rowControl(at index: Int) -> Control {
+        let node: Node
+        if let visible = rowNodes[index] {
+            node = visible
+        } else {
+            node = recycledNodes.popLast() ?? makeRowNode()
+            rowNodes[index] = node
+        }
+        return makeRow?(index, node) ?? Control()
+    }
+
+    /// Finish a layout pass that presented the rows in `visible`.
+    func endLayout(visible: Range<Int>) {
+        visibleRowCount = visible.count
+        recycleRows(outside: visible)
+    }
+
+    private func recycleRows(outside range: Range<Int>) {
+        for (index, node) in rowNodes where !range.contains(index) {
+            rowNodes[index] = nil
+            recycledNodes.append(node)
+        }
+    }
+
+    // MARK: - Scrolling
+
+    /// Scroll by a number of rows; negative values scroll up.
+    func scroll(by rows: Int) {
+        scroll(to: firstVisibleRow + rows)
+    }
+
+    /// Scroll by whole pages; negative values scroll up.
+    func scroll(pages: Int) {
+        scroll(by: pages * max(1, visibleRowCount))
+    }
+
+    /// Scroll to the first row.
+    func scrollToTop() {
+        scroll(to: 0)
+    }
+
+    /// Scroll so the last row is at the bottom of the viewport.
+    func scrollToBottom() {
+        scroll(to: count)
+    }
+
+    private func scroll(to row: Int) {
+        let row = clamped(row)
+        guard row != firstVisibleRow else { return }
+        firstVisibleRow = row
+        control?.setNeedsLayout()
+    }
+
+    // Keep the last page full once the viewport height is known.
+    private func clamped(_ row: Int) -> Int {
+        max(0, min(row, count - max(1, visibleRowCount)))
+    }
+
+    private func makeRowNode() -> Node {
+        let row = Node(viewType: rowType)
+        row.parent = node
+        row.application = node?.application
+        return row
+    }
+}
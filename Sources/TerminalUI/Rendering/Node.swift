@@ -1,4 +1,10 @@
+import Foundation
+
 /// A node in the view tree that manages state and structural identity.
+///
+/// Nodes persist across updates. Children are matched by position and view
+/// type, so a node keeps its control as long as the view it was built from
+/// is unchanged and none of its state was invalidated.
 public final class Node {
     /// The view type this node represents.
     internal var viewType: Any.Type
@@ -10,28 +16,74 @@ public final class Node {
     internal weak var application: Application?
     /// Layout control associated with this node.
     internal var control: Control?
+    /// The view this node was last built from.
+    internal var view: Any?
+    /// State owned by this node changed; its body must be re-evaluated.
+    internal var needsUpdate = false
+    /// Some descendant needs an update.
+    internal var hasDirtyDescendant = false
+    /// Per-node storage a primitive view keeps across rebuilds, such as a
+    /// list's scroll position.
+    internal var viewState: AnyObject?
+
+    // Position of the next child to match while rebuilding.
+    private var reconcileIndex = 0
 
     init(viewType: Any.Type) {
         self.viewType = viewType
     }
 
-    /// Mark this node as needing a re-render.
-    func setNeedsUpdate() {
-        application?.invalidateNode(self)
+    /// Mark this node as needing a re-render. Safe to call from any thread
+    /// with the application the node belongs to, captured on the build
+    /// thread: the node is queued and marked by the application's run loop.
+    /// Without one the node is marked at once, on the build thread.
+    func setNeedsUpdate(in application: Application?) {
+        if let application {
+            application.invalidateNode(self)
+        } else {
+            markNeedsUpdate()
+        }
+    }
+
+    /// Flag this node dirty and record it on every ancestor. Runs on the
+    /// thread that builds the view graph.
+    func markNeedsUpdate() {
+        needsUpdate = true
+        var ancestor = parent
+        while let node = ancestor, !node.hasDirtyDescendant {
+            node.hasDirtyDescendant = true
+            ancestor = node.parent
+        }
     }
 
+    // View types found to have no dynamic properties; reflection is skipped
+    // for them on later builds. Locked, as bodies may be evaluated on
+    // several threads at once.
+    private static var typesWithoutDynamicProperties = Set<ObjectIdentifier>()
+    private static let typesLock = NSLock()
+
     /// Install dynamic properties (like @State) on a view.
     func installDynamicProperties<V: View>(_ view: inout V) {
+        if MemoryLayout<V>.size == 0 { return }
+        let type = ObjectIdentifier(V.self)
+        if Node.typesLock.withLock({ Node.typesWithoutDynamicProperties.contains(type) }) { return }
+
+        var found = false
         let mirror = Mirror(reflecting: view)
         for child in mirror.children {
             if var state = child.value as? (any DynamicProperty) {
                 state.update()
+                found = true
             }
             // Install State's node reference
             if let stateInstallable = child.value as? any StateInstallable {
                 stateInstallable.install(on: self)
+                found = true
             }
         }
+        if !found {
+            _ = Node.typesLock.withLock { Node.typesWithoutDynamicProperties.insert(type) }
+        }
     }
 
     /// Add a child node.
@@ -39,6 +91,45 @@ public final class Node {
         child.parent = self
         children.append(child)
     }
+
+    // MARK: - Reconciliation
+
+    /// Start matching children against a fresh evaluation of this node's view.
+    func beginReconcile() {
+        reconcileIndex = 0
+    }
+
+    /// The child at the next position if it was built from the same view
+    /// type; otherwise a new node that replaces it.
+    func reconcileChild(viewType: Any.Type) -> Node {
+        defer { reconcileIndex += 1 }
+        if reconcileIndex < children.count {
+            let existing = children[reconcileIndex]
+            if ObjectIdentifier(existing.viewType) == ObjectIdentifier(viewType) {
+                return existing
+            }
+            let replacement = makeChild(viewType: viewType)
+            children[reconcileIndex] = replacement
+            return replacement
+        }
+        let child = makeChild(viewType: viewType)
+        children.append(child)
+        return child
+    }
+
+    /// Drop children that were not matched by the last evaluation.
+    func endReconcile() {
+        if reconcileIndex < children.count {
+            children.removeSubrange(reconcileIndex...)
+        }
+    }
+
+    private func makeChild(viewType: Any.Type) -> Node {
+        let child = Node(viewType: viewType)
+        child.parent = self
+        child.application = application
+        return child
+    }
 }
 
 /// Internal protocol for State to install itself on a Node.
@@ -0,0 +1,80 @@
+import NotcursesSwift
+
+/// The cells of a drawing group as last drawn, kept on an offscreen plane.
+///
+/// A group is drawn into its raster once and copied onto the screen on
+/// later frames, one row at a time, without visiting its controls. The
+/// raster is drawn again after the group's layout is invalidated, which
+/// happens when the group's view or state inside it changes, and when a
+/// different size is proposed. Buttons and lists in the group are recorded
+/// with the raster and added to the frame's hit-test index on every copy.
+internal final class RasterCache {
+    /// The control presenting the group.
+    weak var control: Control?
+
+    // Offscreen plane the group is drawn into, as large as the group
+    private var raster: TerminalCanvas?
+    private var rasterSize: Size = .zero
+    private var isValid = false
+    // The group's controls, relative to its top-left corner
+    private let arena = ControlArena()
+    // Buttons and lists drawn into the raster, relative to its corner
+    private let hitTargets = HitTestIndex()
+
+    /// Mark the raster stale; the group is drawn again when next on screen.
+    func invalidate() {
+        isValid = false
+    }
+
+    /// Copy the group onto `canvas` at `position`, first drawing it into
+    /// the raster if that is stale or of another size.
+    func draw(at position: Position, size: Size, on canvas: TerminalCanvas,
+              hitTestIndex: HitTestIndex?, metrics: inout DrawingGroupMetrics) {
+        guard size.width > 0, size.height > 0 else { return }
+        if isValid, rasterSize == size, raster != nil {
+            metrics.hits += 1
+        } else {
+            guard let control, rasterize(control, size: size, for: canvas, metrics: &metrics) else { return }
+            metrics.misses += 1
+        }
+        guard let raster else { return }
+        canvas.blit(raster, at: position)
+
+        guard let hitTestIndex else { return }
+        for button in hitTargets.buttons {
+            let region = button.region
+            hitTestIndex.addButton(at: Position(x: position.x + region.x, y: position.y + region.y),
+                                   size: Size(width: region.width, height: region.height),
+                                   action: button.action)
+        }
+        for list in hitTargets.lists {
+            let region = list.region
+            hitTestIndex.addList(list.content, at: Position(x: position.x + region.x, y: position.y + region.y),
+                                 size: Size(width: region.width, height: region.height))
+        }
+    }
+
+    // Draw the group's subtree into the raster, replacing the plane when
+    // the size changed. Groups nested in this one are copied from their
+    // own rasters.
+    private func rasterize(_ control: Control, size: Size, for canvas: TerminalCanvas,
+                           metrics: inout DrawingGroupMetrics) -> Bool {
+        if raster == nil || rasterSize != size {
+            guard let plane = try? canvas.plane.createOffscreen(rows: size.height, cols: size.width) else {
+                return false
+            }
+            raster = TerminalCanvas(plane: plane)
+            rasterSize = size
+        }
+        guard let raster else { return false }
+        raster.clear()
+        arena.build(groupContents: control)
+        hitTargets.reset(rows: size.height)
+        let context = RenderContext(canvas: raster, arena: arena, hitTestIndex: hitTargets)
+        context.render(arena)
+        context.finish()
+        metrics.add(context.drawingGroupMetrics)
+        isValid = true
+        return true
+    }
+}
@@ -1,36 +1,64 @@
 import NotcursesSwift
 
-/// Walks the Control tree and issues draw commands to the TerminalCanvas.
+/// Flattens a laid-out Control tree into a ControlArena and issues its
+/// draw commands to the TerminalCanvas, which collects them into a draw
+/// list written out by `finish()`.
 internal class RenderContext {
     let canvas: TerminalCanvas
+    /// The frame's controls in draw order; reused from frame to frame.
+    let arena: ControlArena
+    /// Receives the screen regions of buttons and lists as they are drawn.
+    let hitTestIndex: HitTestIndex?
+    /// Drawing groups copied from their raster or drawn again so far.
+    private(set) var drawingGroupMetrics = DrawingGroupMetrics()
 
-    init(canvas: TerminalCanvas) {
+    init(canvas: TerminalCanvas, arena: ControlArena = ControlArena(), hitTestIndex: HitTestIndex? = nil) {
         self.canvas = canvas
+        self.arena = arena
+        self.hitTestIndex = hitTestIndex
     }
 
     /// Render a control tree to the canvas.
-    func render(control: Control, offset: Position = .zero) {
-        let absX = offset.x + control.position.x
-        let absY = offset.y + control.position.y
-        let absPosition = Position(x: absX, y: absY)
-
-        switch control.kind {
-        case .text(let content, let foreground, let isBold, let isItalic):
-            canvas.drawText(content, at: absPosition, foreground: foreground, bold: isBold, italic: isItalic)
-
-        case .button(let label, _):
-            // Render button as "[ label ]" with highlight
-            let buttonText = "[ \(label) ]"
-            canvas.drawText(buttonText, at: absPosition, foreground: .cyan, bold: true, italic: false)
+    func render(control: Control) {
+        arena.build(from: control)
+        render(arena)
+    }
 
-        case .container, .vstack, .hstack, .zstack, .padding, .frame, .spacer:
-            // Layout containers just recurse into children
-            break
+    /// Draw every control of a flattened frame, in order.
+    func render(_ arena: ControlArena) {
+        var action = 0
+        var list = 0
+        var group = 0
+        arena.text.withUnsafeBufferPointer { text in
+            for i in 0 ..< arena.count {
+                let kind = arena.kinds[i]
+                if kind == .container { continue }
+                let position = arena.positions[i]
+                if kind == .group {
+                    arena.groups[group].draw(at: position, size: arena.sizes[i], on: canvas,
+                                             hitTestIndex: hitTestIndex, metrics: &drawingGroupMetrics)
+                    group += 1
+                    continue
+                }
+                if kind == .list {
+                    hitTestIndex?.addList(arena.lists[list], at: position, size: arena.sizes[i])
+                    list += 1
+                    continue
+                }
+                let start = Int(arena.textStart[i])
+                let utf8 = UnsafeBufferPointer(rebasing: text[start ..< start + Int(arena.textLength[i])])
+                canvas.drawText(utf8: utf8, at: position,
+                                foreground: arena.foregrounds[i], styles: arena.attributes[i])
+                if kind == .button {
+                    hitTestIndex?.addButton(at: position, size: arena.sizes[i], action: arena.actions[action])
+                    action += 1
+                }
+            }
         }
+    }
 
-        // Render children
-        for child in control.children {
-            render(control: child, offset: absPosition)
-        }
+    /// Write everything drawn since the last call to the plane at once.
+    func finish() {
+        canvas.submit()
     }
 }
@@ -3,48 +3,57 @@ import NotcursesSwift
 /// A drawing surface that wraps a NotcursesSwift Plane.
 internal class TerminalCanvas {
     let plane: Plane
+    // Text drawn this frame, reused across frames
+    private var drawList = DrawList()
 
     init(plane: Plane) {
         self.plane = plane
     }
 
-    /// Draw text at the given position.
+    /// Queue text at the given position. Queued text reaches the plane in
+    /// one call when the frame is submitted.
     func drawText(_ text: String, at position: Position, foreground: Color?, bold: Bool, italic: Bool) {
-        plane.moveCursor(y: position.y, x: position.x)
-
-        // Apply styles
-        var styles: UInt32 = 0
-        if bold { styles |= TextAttribute.bold.rawValue }
-        if italic { styles |= TextAttribute.italic.rawValue }
-        if styles != 0 {
-            plane.setStyles(styles)
-        }
-
-        // Apply color
-        if let color = foreground {
-            plane.setForeground(color.rgbColor)
-        }
-
-        plane.putString(text)
-
-        // Reset styles
-        if styles != 0 {
-            plane.setStyles(0)
-        }
+        var styles: TextAttribute = []
+        if bold { styles.insert(.bold) }
+        if italic { styles.insert(.italic) }
+        drawList.append(text, y: position.y, x: position.x,
+                        foreground: foreground?.rgbColor, styles: styles)
+    }
+
+    /// Queue UTF-8 text at the given position.
+    func drawText(utf8: UnsafeBufferPointer<UInt8>, at position: Position,
+                  foreground: RGBColor?, styles: TextAttribute) {
+        drawList.append(utf8: utf8, y: position.y, x: position.x,
+                        foreground: foreground, styles: styles)
+    }
+
+    /// Write the queued text to the plane.
+    func submit() {
+        guard !drawList.isEmpty else { return }
+        plane.draw(&drawList)
+        drawList.removeAll()
     }
 
     /// Fill a rectangular region with a color.
     func fillRect(at position: Position, size: Size, color: Color) {
+        // Keep the drawing order: text queued so far goes underneath
+        submit()
         plane.setBackground(color.rgbColor)
-        for row in position.y..<(position.y + size.height) {
-            plane.moveCursor(y: row, x: position.x)
-            plane.putString(String(repeating: " ", count: size.width))
-        }
+        plane.fill(y: position.y, x: position.x, rows: size.height, cols: size.width)
         plane.setBackground(r: 0, g: 0, b: 0) // reset
     }
 
+    /// Copy every cell of another canvas, such as an offscreen raster,
+    /// onto this one with its top-left corner at `position`.
+    func blit(_ source: TerminalCanvas, at position: Position) {
+        // Keep the drawing order, as for fills
+        submit()
+        plane.blit(source.plane, y: position.y, x: position.x)
+    }
+
     /// Clear the entire canvas.
     func clear() {
+        drawList.removeAll()
         plane.erase()
     }
 }
@@ -1,212 +1,164 @@
 /// Builds a Control tree from a View hierarchy.
+///
+/// Building is incremental: a node whose view is unchanged and whose state
+/// was not invalidated keeps its previous control, and only subtrees under
+/// nodes flagged by `Node.setNeedsUpdate(in:)` are re-evaluated.
+///
+/// Each view type builds its own control through `View._makeView`, so
+/// dispatch is resolved by the type system: primitives (stacks, `Text`,
+/// `Button`, modifiers, tuples) set their control kind and children, and
+/// every other view falls back to evaluating its `body`.
 internal struct ViewGraph {
 
     /// Build a control tree from any View.
-    static func buildControl<V: View>(from view: V, node: Node) -> Control {
-        let control = Control()
-        control.node = node
-
-        // Install dynamic properties
-        var mutableView = view
-        node.installDynamicProperties(&mutableView)
-
-        // Dispatch based on concrete view type
-        if let text = mutableView as? Text {
-            control.kind = .text(
-                content: text.content,
-                foregroundColor: text._foregroundColor,
-                isBold: text._bold,
-                isItalic: text._italic
-            )
-        } else if let spacer = mutableView as? Spacer {
-            control.kind = .spacer(minLength: spacer.minLength)
-        } else if let button = mutableView as? Button<Text> {
-            control.kind = .button(label: button.label.content, action: button.action)
-        } else if mutableView is EmptyView {
-            control.kind = .container
-        } else {
-            // Composite view — evaluate body and recurse
-            buildCompositeControl(from: mutableView, control: control, node: node)
+    ///
+    /// `isSameView` says `view` is the very value the node was last built
+    /// from, as with the run loop's root view and the stored views of nodes
+    /// on the way to invalidated state, so it is not compared.
+    static func buildControl<V: View>(from view: V, node: Node, isSameView: Bool = false) -> Control {
+        if let control = node.control, !node.needsUpdate,
+           let previous = node.view as? V, isSameView || isUnchanged(previous, view) {
+            if node.hasDirtyDescendant {
+                updateDirtyChildren(of: node, control: control)
+                control.updateSubtreeSize()
+            }
+            return control
         }
 
+        let control = node.control ?? Control()
+        control.reset()
+        control.node = node
+        node.control = control
+        node.view = view
+        node.needsUpdate = false
+        node.hasDirtyDescendant = false
+        node.beginReconcile()
+        defer { node.endReconcile() }
+
+        // Children of a large container are built after it, possibly in
+        // parallel; sizes are those of the last build
+        let deferred = control.subtreeSize >= WorkPool.minimumWeight && WorkPool.current != nil
+            ? DeferredBuilds() : nil
+        V._makeView(view, inputs: _ViewInputs(node: node, control: control, deferred: deferred))
+        deferred?.run()
+        control.updateSubtreeSize()
         return control
     }
 
-    // MARK: - Existential opening helper
+    // MARK: - Building blocks for `_makeView`
 
-    /// Open an `any View` existential and call `buildControl` with the concrete type.
-    private static func openAndBuildControl(_ view: some View, node: Node) -> Control {
-        return buildControl(from: view, node: node)
+    /// Evaluate a composite view's body as its only child.
+    static func makeBody<V: View>(of view: V, inputs: _ViewInputs) {
+        var view = view
+        inputs.node.installDynamicProperties(&view)
+        inputs.control.kind = .container
+        makeChild(view.body, inputs: inputs)
     }
 
-    // MARK: - Composite view handling
-
-    private static func buildCompositeControl<V: View>(from view: V, control: Control, node: Node) {
-        let typeName = String(describing: type(of: view))
-
-        if typeName.hasPrefix("VStack") {
-            buildVStackControl(from: view, control: control, node: node)
-        } else if typeName.hasPrefix("HStack") {
-            buildHStackControl(from: view, control: control, node: node)
-        } else if typeName.hasPrefix("ZStack") {
-            buildZStackControl(from: view, control: control, node: node)
-        } else if typeName.hasPrefix("ModifiedContent") {
-            buildModifiedControl(from: view, control: control, node: node)
-        } else if typeName.hasPrefix("TupleView") {
-            buildTupleViewControl(from: view, control: control, node: node)
-        } else if typeName.hasPrefix("ConditionalContent") {
-            buildConditionalControl(from: view, control: control, node: node)
-        } else if typeName.hasPrefix("Optional") {
-            buildOptionalControl(from: view, control: control, node: node)
-        } else {
-            // User-defined composite view — evaluate its body
-            let childNode = Node(viewType: V.Body.self)
-            node.addChild(childNode)
-            childNode.application = node.application
-            let childControl = buildControl(from: view.body, node: childNode)
-            control.addChild(childControl)
-            control.kind = .container
+    /// Build a view as the next child node and control of a container.
+    static func makeChild<V: View>(_ view: V, inputs: _ViewInputs) {
+        let childNode = inputs.node.reconcileChild(viewType: V.self)
+        if let deferred = inputs.deferred {
+            // buildControl fills in the node's control, so it can be placed
+            // among the children before it is built
+            let control = childNode.control ?? Control()
+            childNode.control = control
+            inputs.control.addChild(control)
+            deferred.add(weight: control.subtreeSize) {
+                _ = buildControl(from: view, node: childNode)
+            }
+            return
         }
+        inputs.control.addChild(buildControl(from: view, node: childNode))
     }
 
-    private static func buildVStackControl<V: View>(from view: V, control: Control, node: Node) {
-        let mirror = Mirror(reflecting: view)
-        let alignment = mirror.descendant("alignment") as? HorizontalAlignment ?? .center
-        let spacing = mirror.descendant("spacing") as? CGFloat?
-        control.kind = .vstack(alignment: alignment, spacing: spacing ?? nil)
-
-        if let content = mirror.descendant("content") {
-            buildChildrenFromContent(content, into: control, node: node)
+    /// Build the elements of a tuple that was not produced by `ViewBuilder`,
+    /// discovering them by reflection.
+    static func makeReflectedChildren(_ value: Any, inputs: _ViewInputs) {
+        for child in Mirror(reflecting: value).children {
+            if let view = child.value as? any View {
+                makeViewList(view, inputs: inputs)
+            } else {
+                makeReflectedChildren(child.value, inputs: inputs)
+            }
         }
     }
 
-    private static func buildHStackControl<V: View>(from view: V, control: Control, node: Node) {
-        let mirror = Mirror(reflecting: view)
-        let alignment = mirror.descendant("alignment") as? VerticalAlignment ?? .center
-        let spacing = mirror.descendant("spacing") as? CGFloat?
-        control.kind = .hstack(alignment: alignment, spacing: spacing ?? nil)
-
-        if let content = mirror.descendant("content") {
-            buildChildrenFromContent(content, into: control, node: node)
-        }
+    private static func makeViewList<V: View>(_ view: V, inputs: _ViewInputs) {
+        V._makeViewList(view, inputs: inputs)
     }
 
-    private static func buildZStackControl<V: View>(from view: V, control: Control, node: Node) {
-        let mirror = Mirror(reflecting: view)
-        let alignment = mirror.descendant("alignment") as? Alignment ?? .center
-        control.kind = .zstack(alignment: alignment)
+    // MARK: - Parallel build
 
-        if let content = mirror.descendant("content") {
-            buildChildrenFromContent(content, into: control, node: node)
-        }
-    }
+    /// Child subtrees collected while a container is built. Each builds
+    /// only its own nodes and controls, so they can be built in any order
+    /// and on any thread; the container's children are already in place.
+    final class DeferredBuilds {
+        private var builds: [() -> Void] = []
+        private var weights: [Int] = []
 
-    private static func buildModifiedControl<V: View>(from view: V, control: Control, node: Node) {
-        let mirror = Mirror(reflecting: view)
-
-        // Extract the modifier
-        if let modifier = mirror.descendant("modifier") {
-            let modMirror = Mirror(reflecting: modifier)
-            let modType = String(describing: type(of: modifier))
-
-            if modType == "PaddingModifier" {
-                let edges = modMirror.descendant("edges") as? Edge.Set ?? .all
-                let length = modMirror.descendant("length") as? CGFloat?
-                control.kind = .padding(edges: edges, length: length ?? nil)
-            } else if modType == "FrameModifier" {
-                let width = modMirror.descendant("width") as? CGFloat?
-                let height = modMirror.descendant("height") as? CGFloat?
-                let alignment = modMirror.descendant("alignment") as? Alignment ?? .center
-                control.kind = .frame(width: width ?? nil, height: height ?? nil, alignment: alignment)
-            } else {
-                // ForegroundColor, Background, Bold, Font — pass-through containers
-                control.kind = .container
-            }
-        } else {
-            control.kind = .container
+        func add(weight: Int, _ build: @escaping () -> Void) {
+            builds.append(build)
+            weights.append(weight)
         }
 
-        // Build the content child
-        if let content = mirror.descendant("content") {
-            buildChildrenFromContent(content, into: control, node: node)
+        func run() {
+            let builds = self.builds
+            let weights = self.weights
+            WorkPool.forEach(builds.count, weight: { weights[$0] }) { builds[$0]() }
         }
     }
 
-    private static func buildTupleViewControl<V: View>(from view: V, control: Control, node: Node) {
-        control.kind = .container
-        let mirror = Mirror(reflecting: view)
-        if let value = mirror.descendant("value") {
-            let valueMirror = Mirror(reflecting: value)
-            for child in valueMirror.children {
-                buildChildrenFromContent(child.value, into: control, node: node)
-            }
-        }
-    }
+    // MARK: - Incremental update
 
-    private static func buildConditionalControl<V: View>(from view: V, control: Control, node: Node) {
-        control.kind = .container
-        let mirror = Mirror(reflecting: view)
-        // ConditionalContent is an enum — extract the associated value
-        for child in mirror.children {
-            if let anyView = child.value as? any View {
-                let childNode = Node(viewType: type(of: anyView))
-                node.addChild(childNode)
-                childNode.application = node.application
-                let childControl = openAndBuildControl(anyView, node: childNode)
-                control.addChild(childControl)
-            }
+    /// Rebuild the children of an unchanged node that lead to invalidated
+    /// state. Child nodes and child controls correspond one to one.
+    private static func updateDirtyChildren(of node: Node, control: Control) {
+        node.hasDirtyDescendant = false
+        if case .list = control.kind {
+            // Rows are built during layout, which rebuilds the dirty ones
+            control.setNeedsLayout()
+            return
+        }
+        for (index, child) in node.children.enumerated()
+        where child.needsUpdate || child.hasDirtyDescendant {
+            guard index < control.children.count,
+                  let view = child.view as? any View else { continue }
+            control.replaceChild(at: index, with: openAndBuildStoredView(view, node: child))
         }
     }
 
-    private static func buildOptionalControl<V: View>(from view: V, control: Control, node: Node) {
-        control.kind = .container
-        let mirror = Mirror(reflecting: view)
-        for child in mirror.children {
-            if let anyView = child.value as? any View {
-                let childNode = Node(viewType: type(of: anyView))
-                node.addChild(childNode)
-                childNode.application = node.application
-                let childControl = openAndBuildControl(anyView, node: childNode)
-                control.addChild(childControl)
+    /// Whether a view is known to equal the one its node was last built
+    /// from: by `==` when it is `Equatable`, byte for byte when it is plain
+    /// data, and never otherwise. The bytes of a view holding references
+    /// say nothing about what they point to, such as an object that was
+    /// mutated in place, so such a view is always rebuilt.
+    private static func isUnchanged<V: View>(_ previous: V, _ view: V) -> Bool {
+        if let previous = previous as? any Equatable {
+            return isEqual(previous, view)
+        }
+        guard _isPOD(V.self) else { return false }
+        // Identical bytes imply equal values; differing padding only costs
+        // a rebuild
+        var lhs = previous
+        var rhs = view
+        return withUnsafeBytes(of: &lhs) { lhsBytes in
+            withUnsafeBytes(of: &rhs) { rhsBytes in
+                lhsBytes.elementsEqual(rhsBytes)
             }
         }
     }
 
-    // MARK: - Child content helpers
-
-    /// Resolve `Any` content (from Mirror reflection) into Control children.
-    /// Uses existential opening via `any View` cast to handle all View types generically.
-    private static func buildChildrenFromContent(_ content: Any, into parentControl: Control, node: Node) {
-        let typeName = String(describing: type(of: content))
-
-        // TupleView: decompose its value tuple into individual children (don't wrap as single child)
-        if typeName.hasPrefix("TupleView") {
-            let mirror = Mirror(reflecting: content)
-            if let value = mirror.descendant("value") {
-                let valueMirror = Mirror(reflecting: value)
-                for child in valueMirror.children {
-                    buildChildrenFromContent(child.value, into: parentControl, node: node)
-                }
-            }
-            return
-        }
+    private static func isEqual<E: Equatable>(_ lhs: E, _ rhs: Any) -> Bool {
+        guard let rhs = rhs as? E else { return false }
+        return lhs == rhs
+    }
 
-        // All other View types: open existential and build recursively
-        if let anyView = content as? any View {
-            let childNode = Node(viewType: type(of: anyView))
-            node.addChild(childNode)
-            childNode.application = node.application
-            let childControl = openAndBuildControl(anyView, node: childNode)
-            parentControl.addChild(childControl)
-            return
-        }
+    // MARK: - Existential opening helper
 
-        // Raw tuple (from Mirror of a tuple, not a TupleView) — decompose children
-        let mirror = Mirror(reflecting: content)
-        if mirror.displayStyle == .tuple {
-            for child in mirror.children {
-                buildChildrenFromContent(child.value, into: parentControl, node: node)
-            }
-        }
+    /// Open the `any View` a node was last built from and call
+    /// `buildControl` with the concrete type.
+    private static func openAndBuildStoredView(_ view: some View, node: Node) -> Control {
+        return buildControl(from: view, node: node, isSameView: true)
     }
 }
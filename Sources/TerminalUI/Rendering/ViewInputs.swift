@@ -0,0 +1,11 @@
+/// The node and control a view builds into.
+///
+/// Passed to `View._makeView` so each view type builds its own control,
+/// with dispatch resolved through the protocol rather than at runtime.
+public struct _ViewInputs {
+    internal let node: Node
+    internal let control: Control
+    /// Collects child builds to run once the container's children are
+    /// known, when building in parallel.
+    internal var deferred: ViewGraph.DeferredBuilds? = nil
+}
@@ -0,0 +1,226 @@
+import Foundation
+
+/// A fixed set of threads running fork-join loops, used to build and lay
+/// out large independent subtrees in parallel.
+///
+/// Every thread taking part, workers and the thread that entered the pool
+/// with `run(_:)`, pushes the tasks it forks onto its own deque and takes
+/// them back newest first. An idle thread steals the oldest task of
+/// another deque, which for nested loops is the largest piece of work
+/// left. A thread waiting for a loop to finish runs other tasks meanwhile,
+/// so loops nest without tying up threads. Tasks are whole subtrees, so a
+/// single lock guarding every deque is not contended.
+internal final class WorkPool {
+    /// Threads running tasks, counting the one that enters the pool.
+    let threadCount: Int
+
+    /// Loops whose indices weigh less than this in total run on the
+    /// calling thread; a weight is roughly a number of controls.
+    static let minimumWeight = 512
+    /// Indices are handed out in runs weighing about this much.
+    static let grain = 128
+
+    private let scheduler: Scheduler
+    // Identifies the thread that entered the pool; workers have their own
+    private let callerSlot: Slot
+
+    /// Create a pool of `threads` threads, all but one of them started
+    /// here; the last is the thread that calls `run(_:)`.
+    init(threads: Int) {
+        threadCount = max(1, threads)
+        scheduler = Scheduler(deques: threadCount)
+        callerSlot = Slot(deque: threadCount - 1)
+        callerSlot.pool = self
+        for index in 0 ..< threadCount - 1 {
+            let slot = Slot(deque: index)
+            slot.pool = self
+            let scheduler = self.scheduler
+            let thread = Thread {
+                setCurrentSlot(slot)
+                scheduler.work(deque: index)
+            }
+            // View bodies recurse as deep on workers as on the main thread
+            thread.stackSize = 8 << 20
+            thread.start()
+        }
+    }
+
+    deinit {
+        scheduler.stop()
+    }
+
+    /// The pool the calling thread is running tasks for, if any.
+    static var current: WorkPool? {
+        currentSlot()?.pool
+    }
+
+    /// Run `body` with the calling thread taking part in the pool, so
+    /// loops inside it spread over the pool's threads.
+    func run<R>(_ body: () throws -> R) rethrows -> R {
+        let previous = currentSlot()
+        setCurrentSlot(callerSlot)
+        defer { setCurrentSlot(previous) }
+        return try body()
+    }
+
+    /// Call `body` for every index in `0..<count`, on the current pool's
+    /// threads when the weights add up to `minimumWeight` and on the
+    /// calling thread otherwise. Returns once every call has.
+    static func forEach(_ count: Int, weight: (Int) -> Int, _ body: (Int) -> Void) {
+        guard count > 1, let slot = currentSlot(), let pool = slot.pool, pool.threadCount > 1 else {
+            for index in 0 ..< count { body(index) }
+            return
+        }
+        // Cut the indices into runs of about `grain`
+        var ends: [Int] = []
+        var total = 0
+        var run = 0
+        for index in 0 ..< count {
+            let w = max(1, weight(index))
+            total += w
+            run += w
+            if run >= grain {
+                ends.append(index + 1)
+                run = 0
+            }
+        }
+        guard total >= minimumWeight else {
+            for index in 0 ..< count { body(index) }
+            return
+        }
+        if ends.last != count { ends.append(count) }
+        pool.scheduler.forEach(ends.count, deque: slot.deque) { chunk in
+            for index in (chunk == 0 ? 0 : ends[chunk - 1]) ..< ends[chunk] {
+                body(index)
+            }
+        }
+    }
+}
+
+// MARK: - Scheduling
+
+private final class WorkItem {
+    let body: (Int) -> Void
+    let index: Int
+    let join: Join
+
+    init(body: @escaping (Int) -> Void, index: Int, join: Join) {
+        self.body = body
+        self.index = index
+        self.join = join
+    }
+}
+
+// Tasks of one loop still to finish; guarded by the scheduler's lock
+private final class Join {
+    var pending: Int
+
+    init(pending: Int) {
+        self.pending = pending
+    }
+}
+
+private final class Scheduler {
+    private let condition = NSCondition()
+    private var deques: [[WorkItem]]
+    private var stopped = false
+
+    init(deques count: Int) {
+        deques = Array(repeating: [], count: count)
+    }
+
+    func stop() {
+        condition.withLock {
+            stopped = true
+            condition.broadcast()
+        }
+    }
+
+    /// Worker loop: run tasks until the pool stops.
+    func work(deque: Int) {
+        while true {
+            condition.lock()
+            var task = take(deque)
+            while task == nil && !stopped {
+                condition.wait()
+                task = take(deque)
+            }
+            condition.unlock()
+            guard let task else { return }
+            execute(task)
+        }
+    }
+
+    func forEach(_ count: Int, deque: Int, _ body: (Int) -> Void) {
+        withoutActuallyEscaping(body) { body in
+            let join = Join(pending: count - 1)
+            condition.withLock {
+                // Pushed last to first, so the owner takes index 1 next
+                for index in stride(from: count - 1, to: 0, by: -1) {
+                    deques[deque].append(WorkItem(body: body, index: index, join: join))
+                }
+                condition.broadcast()
+            }
+            body(0)
+            // Help with any work until the loop's own tasks are done
+            while true {
+                condition.lock()
+                var task: WorkItem?
+                while join.pending > 0 {
+                    task = take(deque)
+                    if task != nil { break }
+                    condition.wait()
+                }
+                condition.unlock()
+                guard let task else { return }
+                execute(task)
+            }
+        }
+    }
+
+    private func execute(_ task: WorkItem) {
+        task.body(task.index)
+        condition.withLock {
+            task.join.pending -= 1
+            if task.join.pending == 0 { condition.broadcast() }
+        }
+    }
+
+    // The newest task of the thread's own deque, or the oldest of another.
+    // Called with the lock held.
+    private func take(_ deque: Int) -> WorkItem? {
+        if let task = deques[deque].popLast() { return task }
+        for offset in 1 ..< max(1, deques.count) {
+            let victim = (deque + offset) % deques.count
+            if !deques[victim].isEmpty { return deques[victim].removeFirst() }
+        }
+        return nil
+    }
+}
+
+// MARK: - Thread identity
+
+// The pool and deque of a thread taking part in a pool
+private final class Slot {
+    weak var pool: WorkPool?
+    let deque: Int
+
+    init(deque: Int) {
+        self.deque = deque
+    }
+}
+
+private let slotKey: pthread_key_t = {
+    var key = pthread_key_t()
+    pthread_key_create(&key, nil)
+    return key
+}()
+
+// Slots are kept alive by their pool and by worker threads' closures
+private func currentSlot() -> Slot? {
+    pthread_getspecific(slotKey).map { Unmanaged<Slot>.fromOpaque($0).takeUnretainedValue() }
+}
+
+private func setCurrentSlot(_ slot: Slot?) {
+    pthread_setspecific(slotKey, slot.map { UnsafeRawPointer(Unmanaged.passUnretained($0).toOpaque()) })
+}
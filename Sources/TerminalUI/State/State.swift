@@ -1,14 +1,41 @@
+import Foundation
+
 /// A property wrapper type that can read and write a value managed by the framework.
 @propertyWrapper
 public struct State<Value>: DynamicProperty {
     // Internal storage — actual state lives on the Node.
     // This class box allows the property wrapper to be mutated in a struct context.
-    private final class Storage {
-        var value: Value
-        var node: Node?
+    // Access is locked so state can be written from any thread. The node's
+    // application is captured here on the build thread, so a write never
+    // reads the node's own references.
+    private final class Storage: @unchecked Sendable {
+        private let lock = NSLock()
+        private var _value: Value
+        private var _node: Node?
+        private weak var _application: Application?
 
         init(value: Value) {
-            self.value = value
+            self._value = value
+        }
+
+        var value: Value {
+            lock.withLock { _value }
+        }
+
+        func install(on node: Node, application: Application?) {
+            lock.withLock {
+                _node = node
+                _application = application
+            }
+        }
+
+        /// Store a new value and return the node to invalidate, with the
+        /// application it belonged to when installed.
+        func store(_ newValue: Value) -> (node: Node, application: Application?)? {
+            lock.withLock {
+                _value = newValue
+                return _node.map { ($0, _application) }
+            }
         }
     }
 
@@ -23,8 +50,8 @@ public struct State<Value>: DynamicProperty {
     public var wrappedValue: Value {
         get { storage.value }
         nonmutating set {
-            storage.value = newValue
-            storage.node?.setNeedsUpdate()
+            guard let target = storage.store(newValue) else { return }
+            target.node.setNeedsUpdate(in: target.application)
         }
     }
 
@@ -36,8 +63,9 @@ public struct State<Value>: DynamicProperty {
         )
     }
 
-    /// Install this state on a node.
+    /// Install this state on a node. Runs on the thread that builds the
+    /// view graph.
     internal func install(on node: Node) {
-        storage.node = node
+        storage.install(on: node, application: node.application)
     }
 }
@@ -20,3 +20,13 @@ extension Button where Label == Text {
         self.label = Text(title)
     }
 }
+
+// MARK: - Primitive view
+
+extension Button {
+    public static func _makeView(_ view: Button, inputs: _ViewInputs) {
+        // Buttons render their title as "[ title ]"; only Text labels have one.
+        let title = (view.label as? Text)?.content ?? ""
+        inputs.control.kind = .button(label: title, action: view.action)
+    }
+}
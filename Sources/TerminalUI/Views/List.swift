@@ -0,0 +1,44 @@
+/// A container that presents rows of data arranged in a single column.
+///
+/// Rows are built lazily: each frame only the rows that fit in the proposed
+/// height are evaluated, so the cost of a frame depends on the viewport,
+/// not on the size of `data`. Rows scrolled out of view give their nodes
+/// and controls to rows scrolling in. Page Up, Page Down, Home, and End
+/// scroll the list.
+public struct List<Data: RandomAccessCollection, RowContent: View>: View {
+    public var body: Never { fatalError() }
+
+    internal let data: Data
+    internal let rowContent: (Data.Element) -> RowContent
+
+    /// Creates a list that computes its rows on demand from a collection.
+    public init(_ data: Data, @ViewBuilder rowContent: @escaping (Data.Element) -> RowContent) {
+        self.data = data
+        self.rowContent = rowContent
+    }
+
+    /// The view for the row at an offset from the start of `data`.
+    internal func row(at offset: Int) -> RowContent {
+        rowContent(data[data.index(data.startIndex, offsetBy: offset)])
+    }
+}
+
+// MARK: - Primitive view
+
+extension List {
+    public static func _makeView(_ view: List, inputs: _ViewInputs) {
+        // Scroll position and row nodes outlive rebuilds of the list itself
+        let content: ListContent
+        if let existing = inputs.node.viewState as? ListContent {
+            content = existing
+        } else {
+            content = ListContent(node: inputs.node, rowType: RowContent.self)
+            inputs.node.viewState = content
+        }
+        content.update(count: view.data.count) { offset, node in
+            ViewGraph.buildControl(from: view.row(at: offset), node: node)
+        }
+        inputs.control.kind = .list(content)
+        content.control = inputs.control
+    }
+}
@@ -11,3 +11,11 @@ public struct Spacer: View {
         self.minLength = minLength
     }
 }
+
+// MARK: - Primitive view
+
+extension Spacer {
+    public static func _makeView(_ view: Spacer, inputs: _ViewInputs) {
+        inputs.control.kind = .spacer(minLength: view.minLength)
+    }
+}
@@ -77,3 +77,16 @@ extension Text {
         self.content = "\(value)"
     }
 }
+
+// MARK: - Primitive view
+
+extension Text {
+    public static func _makeView(_ view: Text, inputs: _ViewInputs) {
+        inputs.control.kind = .text(
+            content: view.content,
+            foregroundColor: view._foregroundColor,
+            isBold: view._bold,
+            isItalic: view._italic
+        )
+    }
+}
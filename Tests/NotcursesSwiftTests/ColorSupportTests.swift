@@ -0,0 +1,58 @@
+import Testing
+@testable import NotcursesSwift
+
+@Suite("Color Support Tests")
+struct ColorSupportTests {
+    @Test("Support is detected from TERM and COLORTERM")
+    func detection() {
+        #expect(ColorSupport.detected(term: "xterm-256color", colorTerm: nil) == .palette256)
+        #expect(ColorSupport.detected(term: "screen-256color", colorTerm: "truecolor") == .trueColor)
+        #expect(ColorSupport.detected(term: "xterm-direct", colorTerm: nil) == .trueColor)
+        #expect(ColorSupport.detected(term: "linux", colorTerm: nil) == .ansi16)
+        #expect(ColorSupport.detected(term: nil, colorTerm: nil) == .ansi16)
+    }
+
+    // Render one red-on-gray cell and return the output and the screen.
+    private func render(_ support: ColorSupport, foreground: RGBColor,
+                        background: RGBColor) throws -> (output: String, cell: VirtualScreen.Cell) {
+        let terminal = try Terminal(headlessRows: 1, cols: 2)
+        terminal.colorSupport = support
+        #expect(terminal.colorSupport == support)
+        let plane = terminal.standardPlane
+        plane.setForeground(foreground)
+        plane.setBackground(background)
+        plane.putString("x", y: 0, x: 0)
+        try terminal.render()
+
+        let output = terminal.takeOutput()
+        var screen = VirtualScreen(matching: terminal)
+        screen.feed(output)
+        return (String(decoding: output, as: UTF8.self), screen[0, 0])
+    }
+
+    @Test("Colors are written exactly with true color support")
+    func trueColor() throws {
+        let (output, cell) = try render(.trueColor, foreground: RGBColor(r: 255, g: 0, b: 0),
+                                        background: RGBColor(r: 128, g: 128, b: 128))
+        #expect(output.contains("38;2;255;0;0;48;2;128;128;128m"))
+        #expect(cell.foreground == RGBColor(r: 255, g: 0, b: 0))
+    }
+
+    @Test("Colors become the nearest palette entry with 256 colors")
+    func palette() throws {
+        let (output, cell) = try render(.palette256, foreground: RGBColor(r: 250, g: 5, b: 0),
+                                        background: RGBColor(r: 128, g: 128, b: 128))
+        #expect(output.contains("38;5;196;48;5;244m"))
+        #expect(cell.foreground == RGBColor(r: 255, g: 0, b: 0))
+        #expect(cell.background == RGBColor(r: 128, g: 128, b: 128))
+    }
+
+    @Test("Colors become the nearest ANSI color with 16 colors")
+    func ansi() throws {
+        let (output, cell) = try render(.ansi16, foreground: RGBColor(r: 250, g: 10, b: 10),
+                                        background: RGBColor(r: 0, g: 0, b: 192))
+        #expect(output.contains("91;44m"))
+        #expect(cell.foreground == RGBColor(r: 255, g: 0, b: 0))
+        #expect(cell.background == RGBColor(r: 0, g: 0, b: 238))
+    }
+}
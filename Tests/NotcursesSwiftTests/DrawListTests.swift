@@ -0,0 +1,53 @@
+import Testing
+@testable import NotcursesSwift
+
+@Suite("Draw List Tests")
+struct DrawListTests {
+    @Test("Spans are written with their own position, colors and styles")
+    func spans() throws {
+        let terminal = try Terminal(headlessRows: 3, cols: 12)
+        let plane = terminal.standardPlane
+        plane.setForeground(.green)
+
+        var list = DrawList()
+        list.append("héllo", y: 0, x: 1, foreground: .red, styles: .bold)
+        list.append("clipped here", y: 1, x: 6, background: .blue)
+        list.append("off", y: 5, x: 0)
+        #expect(list.count == 3)
+        #expect(plane.draw(&list) == 11)
+
+        // The plane's own drawing state is untouched
+        plane.putString("ok", y: 2, x: 0)
+        try terminal.render()
+
+        var screen = VirtualScreen(matching: terminal)
+        screen.update(from: terminal)
+        #expect(screen.lines == [" héllo", "      clippe", "ok"])
+        #expect(screen[0, 2].character == "é")
+        #expect(screen[0, 1].foreground == .red)
+        #expect(screen[0, 1].styles == .bold)
+        #expect(screen[1, 6].foreground == nil)
+        #expect(screen[1, 6].background == .blue)
+        #expect(screen[2, 0].foreground == .green)
+    }
+
+    @Test("A cleared list is refilled for the next frame")
+    func reuse() throws {
+        let terminal = try Terminal(headlessRows: 1, cols: 8)
+        let plane = terminal.standardPlane
+
+        var list = DrawList()
+        list.append("first", y: 0, x: 0)
+        plane.draw(&list)
+        list.removeAll()
+        #expect(list.isEmpty)
+
+        list.append("X", y: 0, x: 2)
+        #expect(plane.draw(&list) == 1)
+        try terminal.render()
+
+        var screen = VirtualScreen(matching: terminal)
+        screen.update(from: terminal)
+        #expect(screen.text(ofRow: 0) == "fiXst")
+    }
+}
@@ -0,0 +1,135 @@
+import Testing
+@testable import NotcursesSwift
+
+// SplitMix64, so a failing replay can be run again
+private struct SeededGenerator: RandomNumberGenerator {
+    var state: UInt64
+
+    mutating func next() -> UInt64 {
+        state &+= 0x9E37_79B9_7F4A_7C15
+        var z = state
+        z = (z ^ (z >> 30)) &* 0xBF58_476D_1CE4_E5B9
+        z = (z ^ (z >> 27)) &* 0x94D0_49BB_1331_11EB
+        return z ^ (z >> 31)
+    }
+}
+
+@Suite("Grapheme Tests")
+struct GraphemeTests {
+    // "e" and `count` copies of a combining mark
+    private func stacked(_ count: Int, mark: Unicode.Scalar = "\u{301}") -> String {
+        "e" + String(repeating: String(Character(mark)), count: count)
+    }
+
+    @Test("Random frames of long and short clusters replay to the plane")
+    func replay() throws {
+        // Each cluster as written and as the cell keeps it: inline ones of
+        // up to four bytes, pooled ones, and one past NC_EGC_MAX
+        let clusters: [(written: String, shown: Character)] = [
+            ("a", "a"), ("Z", "Z"), ("\u{F1}", "\u{F1}"), ("e\u{301}", "e\u{301}"),
+            ("e\u{301}\u{323}", "e\u{301}\u{323}"), ("👍🏽", "👍🏽"),
+            ("👨‍👩‍👧", "👨‍👩‍👧"), ("🇫🇷", "🇫🇷"),
+            (stacked(20), Character(stacked(15))),
+        ]
+        let rows = 8
+        let cols = 24
+        let terminal = try Terminal(headlessRows: rows, cols: cols)
+        let plane = terminal.standardPlane
+        var screen = VirtualScreen(matching: terminal)
+        var model = Array(repeating: Array(repeating: Character(" "), count: cols), count: rows)
+        var random = SeededGenerator(state: 11)
+
+        for frame in 0..<400 {
+            switch Int.random(in: 0..<8, using: &random) {
+            case 0, 1:
+                // Pooled clusters of the last frame are gone from the plane
+                // and must still be diffed against by content
+                plane.erase()
+                model = Array(repeating: Array(repeating: " ", count: cols), count: rows)
+            case 2:
+                plane.scrollUp(by: 1)
+                model.removeFirst()
+                model.append(Array(repeating: " ", count: cols))
+            default:
+                break
+            }
+            for _ in 0..<Int.random(in: 1...6, using: &random) {
+                let y = Int.random(in: 0..<rows, using: &random)
+                let x = Int.random(in: 0..<cols, using: &random)
+                let run = (0..<Int.random(in: 1...8, using: &random)).map { _ in
+                    clusters.randomElement(using: &random)!
+                }
+                plane.putString(run.map(\.written).joined(), y: y, x: x)
+                // One cluster per column, stopping at the end of the row
+                for (offset, cluster) in run.enumerated() where x + offset < cols {
+                    model[y][x + offset] = cluster.shown
+                }
+            }
+
+            try terminal.render()
+            screen.update(from: terminal)
+            for row in 0..<rows {
+                let shown = (0..<cols).map { screen[row, $0].character }
+                #expect(shown == model[row], "frame \(frame), row \(row)")
+            }
+        }
+    }
+
+    @Test("A cluster longer than NC_EGC_MAX is cut at a codepoint")
+    func truncation() throws {
+        let terminal = try Terminal(headlessRows: 1, cols: 4)
+        // 41 bytes; 32 would end inside a mark, so 31 are kept
+        terminal.standardPlane.putString(stacked(20) + "x", y: 0, x: 0)
+        try terminal.render()
+        var screen = VirtualScreen(matching: terminal)
+        screen.update(from: terminal)
+        #expect(screen[0, 0].character == Character(stacked(15)))
+        #expect(screen[0, 1].character == "x")
+    }
+
+    @Test("A pooled cluster written after an erase is diffed by content")
+    func eraseReusesPool() throws {
+        let terminal = try Terminal(headlessRows: 1, cols: 4)
+        let plane = terminal.standardPlane
+        var screen = VirtualScreen(matching: terminal)
+        plane.putString("👨‍👩‍👧", y: 0, x: 0)
+        try terminal.render()
+        screen.update(from: terminal)
+
+        // Stored at the same pool offset as the cluster it replaces
+        plane.erase()
+        plane.putString("👍🏽", y: 0, x: 0)
+        try terminal.render()
+        screen.update(from: terminal)
+        #expect(screen[0, 0].character == "👍🏽")
+
+        plane.erase()
+        plane.putString("👍🏽", y: 0, x: 0)
+        try terminal.render()
+        #expect(terminal.takeOutput().isEmpty, "Nothing changed on screen")
+    }
+
+    @Test("A full pool is compacted to the clusters still on the plane")
+    func poolCompaction() throws {
+        let terminal = try Terminal(headlessRows: 4, cols: 50)
+        let plane = terminal.standardPlane
+        // Every pass pools 200 clusters of 32 bytes without freeing the
+        // last pass's, so the 16 MiB pool fills after about 2600 passes
+        let passes = 3000
+        for pass in 0..<passes {
+            let mark = Unicode.Scalar(0x300 + UInt32(pass % 16))!
+            let row = String(repeating: stacked(15, mark: mark), count: 50)
+            for y in 0..<4 {
+                plane.putString(row, y: y, x: 0)
+            }
+        }
+        try terminal.render()
+        var screen = VirtualScreen(matching: terminal)
+        screen.update(from: terminal)
+
+        let last = Character(stacked(15, mark: Unicode.Scalar(0x300 + UInt32((passes - 1) % 16))!))
+        for y in 0..<4 {
+            #expect((0..<50).allSatisfy { screen[y, $0].character == last }, "row \(y)")
+        }
+    }
+}
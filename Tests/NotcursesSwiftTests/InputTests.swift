@@ -0,0 +1,107 @@
+import Testing
+@testable import NotcursesSwift
+
+@Suite("Input Tests")
+struct InputTests {
+    @Test("A burst of keys is decoded in one batch")
+    func burst() throws {
+        let terminal = try Terminal(headlessRows: 2, cols: 2)
+        for _ in 0..<100 {
+            terminal.inject(.down)
+        }
+        terminal.inject(text: "x")
+
+        var keys: [KeyEvent] = []
+        var batch = terminal.getInputs(timeout: 0, limit: 64)
+        while !batch.isEmpty {
+            #expect(batch.count <= 64)
+            keys += batch.map(\.key)
+            batch = terminal.getInputs(timeout: 0, limit: 64)
+        }
+        #expect(keys == Array(repeating: .down, count: 100) + [.character("x")])
+    }
+
+    @Test("Modifiers, Alt prefix and unknown sequences")
+    func sequences() throws {
+        let terminal = try Terminal(headlessRows: 2, cols: 2)
+        terminal.inject(Array("\u{1B}[1;5C\u{1B}[99q\u{1B}a\u{1B}[Z".utf8))
+
+        let events = terminal.getInputs(timeout: 0)
+        #expect(events.map(\.key) == [.right, .character("a"), .tab])
+        #expect(events[0].ctrl && !events[0].shift)
+        #expect(events[1].alt)
+        #expect(events[2].shift)
+    }
+
+    @Test("A bracketed paste arrives as one event")
+    func paste() throws {
+        let terminal = try Terminal(headlessRows: 2, cols: 2)
+        let text = String(repeating: "line with \u{1B}[A inside\n", count: 500)
+        terminal.inject(.paste(text), .enter)
+
+        var keys: [KeyEvent] = []
+        while let event = terminal.getInput(timeout: 0) {
+            keys.append(event.key)
+        }
+        #expect(keys == [.paste(text), .enter])
+    }
+
+    @Test("A paste that does not fit arrives cut short and marked")
+    func truncatedPaste() throws {
+        let terminal = try Terminal(headlessRows: 2, cols: 2)
+        terminal.setPasteLimit(64)
+        let text = String(repeating: "0123456789", count: 20)
+        terminal.inject(.paste(text), .enter)
+
+        let long = try #require(terminal.getInput(timeout: 0))
+        #expect(long.key == .paste(String(text.prefix(64))))
+        #expect(long.isPasteTruncated)
+        #expect(terminal.getInput(timeout: 0)?.key == .enter, "Input after the paste is kept")
+
+        // Room is made again once the paste is read
+        terminal.inject(.paste("short"))
+        let short = try #require(terminal.getInput(timeout: 0))
+        #expect(short.key == .paste("short"))
+        #expect(!short.isPasteTruncated)
+    }
+
+    @Test("A lone escape is the Escape key after the escape delay")
+    func escapeDelay() throws {
+        let terminal = try Terminal(headlessRows: 2, cols: 2)
+        #expect(terminal.escapeDelay == .milliseconds(50))
+        terminal.escapeDelay = .milliseconds(5)
+        #expect(terminal.escapeDelay == .milliseconds(5))
+
+        terminal.inject(.escape)
+        #expect(terminal.getInput(timeout: 0)?.key == .escape)
+        terminal.inject(.escape, .up)
+        #expect(terminal.getInput(timeout: 0)?.key == .escape, "Escape directly followed by a sequence")
+        #expect(terminal.getInput(timeout: 0)?.key == .up)
+    }
+
+    @Test("SGR mouse reports carry the button, action and cell")
+    func mouse() throws {
+        let terminal = try Terminal(headlessRows: 2, cols: 2)
+        terminal.inject(Array("\u{1B}[<0;5;3M\u{1B}[<0;5;3m\u{1B}[<35;12;7M\u{1B}[<65;1;1M\u{1B}[<20;2;2M".utf8))
+
+        let events = terminal.getInputs(timeout: 0)
+        #expect(events.map(\.key) == [
+            .mouse(MouseEvent(.press, button: .left, row: 2, column: 4)),
+            .mouse(MouseEvent(.release, button: .left, row: 2, column: 4)),
+            .mouse(MouseEvent(.move, row: 6, column: 11)),
+            .mouse(MouseEvent(.press, button: .scrollDown, row: 0, column: 0)),
+            .mouse(MouseEvent(.press, button: .left, row: 1, column: 1)),
+        ])
+        #expect(events[4].shift && events[4].ctrl && !events[4].alt)
+
+        let injected: [KeyEvent] = [
+            .mouse(MouseEvent(.press, button: .other(9), row: 3, column: 8)),
+            .mouse(MouseEvent(.release, button: .right, row: 0, column: 1)),
+            .character("x"),
+        ]
+        for key in injected {
+            terminal.inject(key)
+        }
+        #expect(terminal.getInputs(timeout: 0).map(\.key) == injected)
+    }
+}
@@ -0,0 +1,51 @@
+import Foundation
+import Testing
+@testable import NotcursesSwift
+
+@Suite("MPSCQueue Tests")
+struct MPSCQueueTests {
+    final class Item {
+        let producer: Int
+        let sequence: Int
+
+        init(producer: Int, sequence: Int) {
+            self.producer = producer
+            self.sequence = sequence
+        }
+    }
+
+    @Test("Pops in push order and reports empty")
+    func fifo() {
+        let queue = MPSCQueue<Item>()
+        #expect(queue.pop() == nil)
+        for n in 0..<3 {
+            queue.push(Item(producer: 0, sequence: n))
+        }
+        #expect(queue.pop()?.sequence == 0)
+        #expect(queue.pop()?.sequence == 1)
+        #expect(queue.pop()?.sequence == 2)
+        #expect(queue.pop() == nil)
+    }
+
+    @Test("Concurrent producers keep their own order")
+    func concurrentProducers() {
+        let queue = MPSCQueue<Item>()
+        let producers = 8
+        let count = 20_000
+
+        DispatchQueue.concurrentPerform(iterations: producers) { producer in
+            for n in 0..<count {
+                queue.push(Item(producer: producer, sequence: n))
+            }
+        }
+
+        var next = [Int](repeating: 0, count: producers)
+        var popped = 0
+        while let item = queue.pop() {
+            #expect(item.sequence == next[item.producer])
+            next[item.producer] += 1
+            popped += 1
+        }
+        #expect(popped == producers * count)
+    }
+}
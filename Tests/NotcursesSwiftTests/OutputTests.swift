@@ -0,0 +1,236 @@
+import Foundation
+import Testing
+@testable import NotcursesSwift
+
+@Suite("Output Tests")
+struct OutputTests {
+    @Test("Frames are wrapped in a synchronized update")
+    func synchronizedUpdate() throws {
+        let terminal = try Terminal(headlessRows: 2, cols: 10)
+        terminal.standardPlane.putString("hello", y: 0, x: 0)
+        try terminal.render()
+
+        let output = String(decoding: terminal.takeOutput(), as: UTF8.self)
+        #expect(output.hasPrefix("\u{1B}[?2026h"))
+        #expect(output.hasSuffix("\u{1B}[?2026l"))
+    }
+
+    @Test("Renders are dropped while the terminal lags and the latest state follows")
+    func backpressure() throws {
+        let terminal = try Terminal(headlessRows: 4, cols: 20)
+        let plane = terminal.standardPlane
+        try terminal.render()
+        var output = terminal.takeOutput()
+
+        terminal.setOutputLimit(8)
+        plane.putString("first", y: 0, x: 0)
+        try terminal.render()
+        output += terminal.takeOutput()
+        #expect(terminal.pendingOutputBytes > 0)
+
+        // The link is still busy with the first frame
+        plane.putString("second", y: 1, x: 0)
+        try terminal.render()
+        plane.putString("third", y: 2, x: 0)
+        try terminal.render()
+        #expect(terminal.statistics.framesDropped == 2)
+        #expect(terminal.statistics.renders == 2)
+
+        // Waiting for input sends the rest, then the state as it is now
+        terminal.setOutputLimit(nil)
+        #expect(terminal.getInput(timeout: 0) == nil)
+        #expect(terminal.pendingOutputBytes == 0)
+        #expect(terminal.statistics.renders == 3)
+        output += terminal.takeOutput()
+
+        var screen = VirtualScreen(matching: terminal)
+        screen.feed(output)
+        #expect(screen.lines == ["first", "second", "third", ""])
+    }
+
+    @Test("A frame the terminal lost is repainted in full")
+    func lostOutput() throws {
+        func present(threads: Int) throws {
+            let terminal = try Terminal(headlessRows: 100, cols: 200)
+            terminal.encodeThreads = threads
+            let plane = terminal.standardPlane
+            for row in 0..<100 {
+                plane.putString("row \(row)", y: row, x: 0)
+            }
+
+            // The sink takes the start of the frame and the rest cannot be kept
+            terminal.setOutputLimit(8)
+            terminal.setPendingLimit(16)
+            try terminal.render()
+            #expect(terminal.pendingOutputBytes == 0)
+            var output = terminal.takeOutput()
+            #expect(output.count == 8)
+
+            // The same planes again: a diff would send nothing
+            terminal.setOutputLimit(nil)
+            try terminal.render()
+            #expect(terminal.statistics.fullRepaints == 2)
+            output += terminal.takeOutput()
+
+            var screen = VirtualScreen(matching: terminal)
+            screen.feed(output)
+            #expect(screen.lines[0] == "row 0")
+            #expect(screen.lines[99] == "row 99")
+        }
+
+        try present(threads: 1)
+        try present(threads: 4)
+    }
+
+    @Test("Rows shifted by a scroll are moved with a scroll region")
+    func scrollRegion() throws {
+        let terminal = try Terminal(headlessRows: 24, cols: 40)
+        let plane = terminal.standardPlane
+        for row in 0..<24 {
+            plane.putString("line \(row)", y: row, x: 0)
+        }
+        try terminal.render()
+        var output = terminal.takeOutput()
+        let repaint = output.count
+
+        plane.scrollUp(by: 1)
+        plane.putString("line 24", y: 23, x: 0)
+        try terminal.render()
+        let frame = terminal.takeOutput()
+        #expect(terminal.statistics.scrolls == 1)
+        let text = String(decoding: frame, as: UTF8.self)
+        #expect(text.contains("\u{1B}[1;24r\u{1B}[1S\u{1B}[r"))
+        #expect(frame.count * 4 < repaint, "The scroll and one new row, not 24 rows")
+
+        output += frame
+        var screen = VirtualScreen(matching: terminal)
+        screen.feed(output)
+        #expect(screen.lines == (1...24).map { "line \($0)" })
+    }
+
+    @Test("Shifts too short or of part of each row are diffed")
+    func scrollFallback() throws {
+        // Two changed rows are cheaper to rewrite than to scroll
+        let short = try Terminal(headlessRows: 6, cols: 20)
+        short.standardPlane.putString("first", y: 0, x: 0)
+        short.standardPlane.putString("second", y: 1, x: 0)
+        try short.render()
+        var output = short.takeOutput()
+        short.standardPlane.scrollUp(by: 1)
+        try short.render()
+        output += short.takeOutput()
+        #expect(short.statistics.scrolls == 0)
+        var screen = VirtualScreen(matching: short)
+        screen.feed(output)
+        #expect(screen.lines == ["second", "", "", "", "", ""])
+
+        // Only the left half moved, so no row of the last frame reappears
+        let partial = try Terminal(headlessRows: 8, cols: 40)
+        for row in 0..<8 {
+            partial.standardPlane.putString("left \(row)", y: row, x: 0)
+            partial.standardPlane.putString("right \(row)", y: row, x: 20)
+        }
+        try partial.render()
+        output = partial.takeOutput()
+        for row in 0..<8 {
+            partial.standardPlane.putString("left \(row + 1)", y: row, x: 0)
+        }
+        try partial.render()
+        let frame = partial.takeOutput()
+        #expect(partial.statistics.scrolls == 0)
+        #expect(!String(decoding: frame, as: UTF8.self).contains("S\u{1B}[r"))
+        output += frame
+        screen = VirtualScreen(matching: partial)
+        screen.feed(output)
+        #expect(screen.lines == (0..<8).map {
+            "left \($0 + 1)" + String(repeating: " ", count: 15 - "\($0 + 1)".count) + "right \($0)"
+        })
+    }
+
+    @Test("A repaint encoded in bands shows what a serial one does")
+    func bandEncoding() throws {
+        func repaint(threads: Int) throws -> VirtualScreen {
+            let terminal = try Terminal(headlessRows: 100, cols: 200)
+            terminal.encodeThreads = threads
+            #expect(terminal.encodeThreads == threads)
+            let plane = terminal.standardPlane
+            for row in 0..<100 {
+                plane.setForeground(r: UInt8(row * 2), g: 128, b: UInt8(255 - row))
+                    .setStyles(row.isMultiple(of: 3) ? TextAttribute.bold.rawValue : 0)
+                plane.putString(String(repeating: "row \(row) ", count: 20), y: row, x: 0)
+            }
+            try terminal.render()
+            var screen = VirtualScreen(matching: terminal)
+            screen.update(from: terminal)
+            return screen
+        }
+
+        let serial = try repaint(threads: 1)
+        let banded = try repaint(threads: 4)
+        #expect(banded.cells == serial.cells)
+        #expect(banded.text(ofRow: 99).hasPrefix("row 99 row 99"))
+        #expect(banded[99, 0].styles == .bold)
+    }
+
+    @Test("A pipelined terminal writes what a synchronous one does")
+    func pipelined() throws {
+        func frames(pipelined: Bool) throws -> (output: [UInt8], statistics: RenderStatistics) {
+            let terminal = try Terminal(headlessRows: 10, cols: 40)
+            terminal.isPipelined = pipelined
+            #expect(terminal.isPipelined == pipelined)
+            var output: [UInt8] = []
+            for frame in 0..<20 {
+                terminal.standardPlane.putString("frame \(frame)", y: frame % 10, x: frame)
+                try terminal.render()
+                // Taking the output waits for the render thread
+                output += terminal.takeOutput()
+            }
+            return (output, terminal.statistics)
+        }
+
+        let synchronous = try frames(pipelined: false)
+        let pipelined = try frames(pipelined: true)
+        #expect(pipelined.output == synchronous.output)
+        #expect(pipelined.statistics.renders == 20)
+    }
+
+    @Test("Output taken while the render thread writes loses no bytes")
+    func pipelinedTake() throws {
+        let terminal = try Terminal(headlessRows: 4, cols: 20)
+        terminal.isPipelined = true
+        let frames = 200
+        var taken: [UInt8] = []
+
+        DispatchQueue.concurrentPerform(iterations: 2) { thread in
+            for frame in 0..<frames {
+                if thread == 0 {
+                    terminal.standardPlane.putString("frame \(frame)  ", y: frame % 4, x: 0)
+                    try? terminal.render()
+                } else {
+                    taken += terminal.takeOutput()
+                }
+            }
+        }
+        taken += terminal.takeOutput()
+
+        var screen = VirtualScreen(matching: terminal)
+        screen.feed(taken)
+        #expect(screen.lines == ["frame 196", "frame 197", "frame 198", "frame 199"])
+    }
+
+    @Test("A pipelined terminal replaces frames it has not started on")
+    func pipelinedLatestFrame() throws {
+        let terminal = try Terminal(headlessRows: 4, cols: 20)
+        terminal.isPipelined = true
+        for frame in 0..<50 {
+            terminal.standardPlane.putString("frame \(frame)", y: 0, x: 0)
+            try terminal.render()
+        }
+        let statistics = terminal.statistics
+        #expect(statistics.renders + statistics.framesDropped == 50)
+
+        var screen = VirtualScreen(matching: terminal)
+        screen.update(from: terminal)
+        #expect(screen.lines[0] == "frame 49")
+    }
+}
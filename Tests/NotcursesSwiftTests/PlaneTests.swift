@@ -0,0 +1,110 @@
+import Testing
+@testable import NotcursesSwift
+
+@Suite("Plane Tests")
+struct PlaneTests {
+    @Test("An offscreen plane is only seen where it is blitted")
+    func offscreenBlit() throws {
+        let terminal = try Terminal(headlessRows: 4, cols: 12)
+        let plane = terminal.standardPlane
+        let offscreen = try plane.createOffscreen(rows: 2, cols: 4)
+        #expect(offscreen.dimensions.rows == 2 && offscreen.dimensions.cols == 4)
+        offscreen.setForeground(.red)
+        offscreen.putString("ab", y: 0, x: 0)
+        // A cluster too long to store in a cell
+        offscreen.putString("👨‍👩‍👧", y: 1, x: 1)
+
+        plane.putString("xxxxxxxxxxxx", y: 0, x: 0)
+        plane.putString("yyyyyyyyyyyy", y: 1, x: 0)
+        try terminal.render()
+        var screen = VirtualScreen(matching: terminal)
+        screen.update(from: terminal)
+        #expect(screen.text(ofRow: 0) == "xxxxxxxxxxxx")
+
+        // Opaque: cells the offscreen plane never wrote blank those beneath
+        plane.blit(offscreen, y: 0, x: 2)
+        // Clipped at the right edge
+        plane.blit(offscreen, y: 2, x: 10)
+        try terminal.render()
+        screen.update(from: terminal)
+        #expect(screen.text(ofRow: 0) == "xxab  xxxxxx")
+        #expect(screen[0, 2].foreground == .red)
+        #expect(screen[1, 3].character == "👨‍👩‍👧")
+        #expect(screen[1, 2].character == " ")
+        #expect(screen[2, 10].character == "a" && screen[2, 11].character == "b")
+    }
+
+    @Test("Child planes are composited in z-order, offset from and clipped to their parent")
+    func compositing() throws {
+        let terminal = try Terminal(headlessRows: 6, cols: 20)
+        let plane = terminal.standardPlane
+        plane.fill(y: 0, x: 0, rows: 6, cols: 20, with: ".")
+        let parent = try plane.createChild(rows: 4, cols: 10, y: 1, x: 2)
+        parent.fill(y: 0, x: 0, rows: 4, cols: 10, with: "p")
+        // Cells between the two As are never written and show the parent
+        let a = try parent.createChild(rows: 2, cols: 4, y: 1, x: 1)
+        a.putString("A", y: 0, x: 0)
+        a.putString("A", y: 0, x: 3)
+        a.putString("AAAA", y: 1, x: 0)
+        let b = try parent.createChild(rows: 2, cols: 4, y: 2, x: 3)
+        b.putString("BBBB", y: 0, x: 0)
+        b.putString("BBBB", y: 1, x: 0)
+        // Hangs over the parent's right and bottom edges
+        let c = try parent.createChild(rows: 2, cols: 4, y: 3, x: 8)
+        c.putString("CCCC", y: 0, x: 0)
+        c.putString("CCCC", y: 1, x: 0)
+
+        try terminal.render()
+        var screen = VirtualScreen(matching: terminal)
+        screen.update(from: terminal)
+        #expect(screen.lines == [
+            "....................",
+            "..pppppppppp........",
+            "..pAppAppppp........",
+            "..pAABBBBppp........",
+            "..pppBBBBpCC........",
+            "....................",
+        ])
+
+        a.moveToTop()
+        b.move(y: 0, x: -2)
+        #expect(b.position.y == 0 && b.position.x == -2)
+        try terminal.render()
+        screen.update(from: terminal)
+        #expect(screen.lines == [
+            "....................",
+            "..BBpppppppp........",
+            "..BAppAppppp........",
+            "..pAAAAppppp........",
+            "..ppppppppCC........",
+            "....................",
+        ])
+
+        // Stacking is by plane, not by tree: the children stay above the
+        // standard plane when their parent goes beneath it
+        parent.moveToBottom()
+        try terminal.render()
+        screen.update(from: terminal)
+        #expect(screen.lines == [
+            "....................",
+            "..BB................",
+            "..BA..A.............",
+            "...AAAA.............",
+            "..........CC........",
+            "....................",
+        ])
+
+        // Children move with their parent and are clipped to the screen
+        parent.move(y: 3, x: 12)
+        try terminal.render()
+        screen.update(from: terminal)
+        #expect(screen.lines == [
+            "....................",
+            "....................",
+            "....................",
+            "............BB......",
+            "............BA..A...",
+            ".............AAAA...",
+        ])
+    }
+}
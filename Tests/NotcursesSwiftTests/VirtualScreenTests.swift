@@ -0,0 +1,104 @@
+import Testing
+@testable import NotcursesSwift
+
+@Suite("VirtualScreen Tests")
+struct VirtualScreenTests {
+    private func esc(_ sequence: String) -> [UInt8] {
+        Array("\u{1B}[\(sequence)".utf8)
+    }
+
+    @Test("Text is written at the cursor and wraps at the last column")
+    func textAndWrap() {
+        var screen = VirtualScreen(rows: 3, cols: 4)
+        screen.feed(Array("abcdef".utf8))
+        #expect(screen.lines == ["abcd", "ef", ""])
+        #expect(screen.cursorY == 1 && screen.cursorX == 2)
+    }
+
+    @Test("Cursor positioning and relative moves")
+    func cursorMoves() {
+        var screen = VirtualScreen(rows: 3, cols: 8)
+        screen.feed(esc("2;3H") + Array("x".utf8) + esc("2C") + Array("y".utf8))
+        screen.feed(Array("\r\n".utf8) + Array("z".utf8))
+        #expect(screen.lines == ["", "  x  y", "z"])
+    }
+
+    @Test("SGR sets true colors, palette colors and styles")
+    func graphicRendition() {
+        var screen = VirtualScreen(rows: 1, cols: 4)
+        screen.feed(esc("0;1;3;38;2;1;2;3;48;5;196m") + Array("a".utf8) + esc("0m") + Array("b".utf8))
+        #expect(screen[0, 0] == VirtualScreen.Cell(character: "a",
+                                                     foreground: RGBColor(r: 1, g: 2, b: 3),
+                                                     background: RGBColor(r: 255, g: 0, b: 0),
+                                                     styles: [.bold, .italic]))
+        #expect(screen[0, 1] == VirtualScreen.Cell(character: "b"))
+    }
+
+    @Test("Scroll region shifts only its rows")
+    func scrollRegion() {
+        var screen = VirtualScreen(rows: 4, cols: 2)
+        screen.feed(Array("a\r\nb\r\nc\r\nd".utf8))
+        screen.feed(esc("2;3r") + esc("1S") + esc("r"))
+        #expect(screen.lines == ["a", "c", "", "d"])
+        #expect(screen.cursorY == 0 && screen.cursorX == 0)
+    }
+
+    @Test("Erase and cursor visibility")
+    func eraseAndCursor() {
+        var screen = VirtualScreen(rows: 2, cols: 4)
+        screen.feed(Array("abcd".utf8) + esc("1;3H") + esc("K") + esc("?25l"))
+        #expect(screen.text(ofRow: 0) == "ab")
+        #expect(!screen.isCursorVisible)
+        screen.feed(esc("2J") + esc("?25h"))
+        #expect(screen.lines == ["", ""])
+        #expect(screen.isCursorVisible)
+    }
+
+    @Test("Grapheme clusters take one cell")
+    func graphemes() {
+        var screen = VirtualScreen(rows: 1, cols: 4)
+        screen.feed(Array("e\u{301}x".utf8))
+        #expect(screen[0, 0].character == "e\u{301}")
+        #expect(screen[0, 1].character == "x")
+    }
+
+    @Test("A headless terminal renders into the virtual screen")
+    func headlessRender() throws {
+        let terminal = try Terminal(headlessRows: 5, cols: 20)
+        #expect(terminal.isHeadless)
+        #expect(terminal.dimensions.rows == 5 && terminal.dimensions.cols == 20)
+
+        let plane = terminal.standardPlane
+        plane.setForeground(.green).setStyles(TextAttribute.bold.rawValue)
+        plane.putString("Hello", y: 1, x: 2)
+        try terminal.render()
+
+        var screen = VirtualScreen(matching: terminal)
+        screen.update(from: terminal)
+        #expect(screen.text(ofRow: 1) == "  Hello")
+        #expect(screen[1, 2].foreground == .green)
+        #expect(screen[1, 2].styles == .bold)
+        #expect(terminal.takeOutput().isEmpty, "Output is discarded once taken")
+
+        // Only the changed cell is sent for the next frame
+        plane.putString("J", y: 1, x: 2)
+        try terminal.render()
+        let output = terminal.takeOutput()
+        screen.feed(output)
+        #expect(screen.text(ofRow: 1) == "  Jello")
+        #expect(output.count < 64)
+    }
+
+    @Test("Injected input is read back as key events")
+    func injectedInput() throws {
+        let terminal = try Terminal(headlessRows: 2, cols: 2)
+        #expect(terminal.inject(.up, .pageDown, .enter))
+        #expect(terminal.inject(text: "é"))
+
+        #expect(terminal.getInput(timeout: 0)?.key == .up)
+        #expect(terminal.getInput(timeout: 0)?.key == .pageDown)
+        #expect(terminal.getInput(timeout: 0)?.key == .enter)
+        #expect(terminal.getInput(timeout: 0)?.key == .character("é"))
+        #expect(terminal.getInput(timeout: 0) == nil)
+    }
+}
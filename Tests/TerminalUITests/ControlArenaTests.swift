@@ -0,0 +1,121 @@
+import Testing
+@testable import TerminalUI
+
+@Suite("Control Arena Tests")
+struct ControlArenaTests {
+    private func layOut<V: View>(_ view: V, width: Int = 40, height: Int = 10) -> Control {
+        let control = ViewGraph.buildControl(from: view, node: Node(viewType: V.self))
+        control.size = control.sizeThatFits(.fixed(width: width, height: height))
+        return control
+    }
+
+    @Test("Controls are flattened in draw order with screen positions")
+    func flatten() {
+        let control = layOut(
+            VStack(alignment: .leading, spacing: 0) {
+                Text("Title").bold()
+                HStack(spacing: 1) {
+                    Text("a")
+                    Button("Go") {}
+                }
+            }
+        )
+        let arena = ControlArena()
+        arena.build(from: control)
+
+        let drawn = (0..<arena.count).filter { arena.kinds[$0] != .container }
+        #expect(drawn.map { arena.kinds[$0] } == [.text, .text, .button])
+        #expect(drawn.map { arena.text(of: $0) } == ["Title", "a", "[ Go ]"])
+        #expect(drawn.map { arena.positions[$0] } == [
+            Position(x: 0, y: 0), Position(x: 0, y: 1), Position(x: 2, y: 1),
+        ])
+        #expect(arena.attributes[drawn[0]] == .bold)
+        #expect(arena.sizes[drawn[2]] == Size(width: 6, height: 1))
+        #expect(arena.actions.count == 1)
+
+        // Every control is reachable from the root through the child links
+        func subtreeCount(_ index: Int) -> Int {
+            arena.children(of: index).reduce(1) { $0 + subtreeCount($1) }
+        }
+        #expect(subtreeCount(0) == arena.count)
+    }
+
+    @Test("Rebuilding replaces the last frame")
+    func rebuild() {
+        let arena = ControlArena()
+        arena.build(from: layOut(List(0..<50) { Text("Row \($0)") }, height: 5))
+        #expect(arena.lists.count == 1)
+        #expect(arena.kinds.filter { $0 == .text }.count == 5)
+
+        arena.build(from: layOut(Text("only")))
+        #expect(arena.lists.isEmpty)
+        #expect((0..<arena.count).map { arena.text(of: $0) }.joined() == "only")
+
+        arena.reset()
+        #expect(arena.count == 0)
+        #expect(arena.text.isEmpty)
+    }
+
+    @Test("Only controls laid out again are visited; the rest is copied")
+    func reuse() {
+        func text(_ content: String) -> ControlKind {
+            .text(content: content, foregroundColor: nil, isBold: false, isItalic: false)
+        }
+        let root = Control()
+        root.kind = .vstack(alignment: .leading, spacing: 0)
+        let rows = (0..<3).map { row -> Control in
+            let stack = Control()
+            stack.kind = .hstack(alignment: .top, spacing: 1)
+            for column in 0..<2 {
+                let cell = Control()
+                cell.kind = text("\(row),\(column)")
+                stack.addChild(cell)
+            }
+            root.addChild(stack)
+            return stack
+        }
+        func layOut() {
+            root.size = root.sizeThatFits(.fixed(width: 30, height: 5))
+        }
+        func expectMatchesFreshBuild(_ arena: ControlArena) {
+            let fresh = ControlArena()
+            fresh.build(from: root)
+            #expect(arena.kinds == fresh.kinds)
+            #expect(arena.positions == fresh.positions)
+            #expect(arena.sizes == fresh.sizes)
+            #expect(arena.parents == fresh.parents)
+            #expect(arena.firstChild == fresh.firstChild)
+            #expect(arena.nextSibling == fresh.nextSibling)
+            #expect((0..<arena.count).map { arena.text(of: $0) } == (0..<fresh.count).map { fresh.text(of: $0) })
+        }
+
+        layOut()
+        let arena = ControlArena()
+        arena.build(from: root)
+        #expect(arena.count == 10)
+        #expect(arena.reusedCount == 0)
+        arena.build(from: root)
+        #expect(arena.reusedCount == 10)
+
+        // The root, the changed row and the changed cell are visited; the
+        // cell beside it moves but keeps its layout
+        rows[1].children[0].kind = text("wide cell")
+        layOut()
+        arena.build(from: root)
+        #expect(arena.reusedCount == 7)
+        expectMatchesFreshBuild(arena)
+        #expect(arena.positions[6] == Position(x: 10, y: 1))
+
+        // A row copied whole last time still has its cells found
+        rows[2].children[1].kind = text("last")
+        layOut()
+        arena.build(from: root)
+        #expect(arena.reusedCount == 7)
+        expectMatchesFreshBuild(arena)
+        #expect(arena.text(of: 9) == "last")
+
+        arena.reset()
+        arena.build(from: root)
+        #expect(arena.reusedCount == 0)
+    }
+}
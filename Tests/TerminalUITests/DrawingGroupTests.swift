@@ -0,0 +1,168 @@
+import Testing
+import NotcursesSwift
+@testable import TerminalUI
+
+@Suite("Drawing Group Tests")
+struct DrawingGroupTests {
+    // Lets a test change a view's state from outside the tree
+    final class Handle {
+        var binding: Binding<Int>?
+
+        func capture(_ binding: Binding<Int>) {
+            self.binding = binding
+        }
+
+        func bump() {
+            binding?.wrappedValue += 1
+        }
+    }
+
+    struct Counter: View {
+        let label: String
+        let handle: Handle
+        @State var value = 0
+
+        var body: some View {
+            let _ = handle.capture($value)
+            Text("\(label) \(value)")
+        }
+    }
+
+    struct Panel: View {
+        let handle: Handle
+        let onReset: () -> Void
+
+        var body: some View {
+            VStack(alignment: .leading, spacing: 0) {
+                Counter(label: "panel", handle: handle)
+                Button("Reset", action: onReset)
+                Text("👨‍👩‍👧 family")
+            }
+        }
+    }
+
+    struct Dashboard: View {
+        let header: Handle
+        let panel: Handle
+        let onReset: () -> Void
+
+        var body: some View {
+            VStack(alignment: .leading, spacing: 0) {
+                Counter(label: "header", handle: header)
+                Panel(handle: panel, onReset: onReset).drawingGroup()
+            }
+        }
+    }
+
+    // Builds, lays out and draws frames of one view tree on a headless
+    // terminal, as the application's run loop does.
+    final class Harness {
+        let terminal: Terminal
+        let canvas: TerminalCanvas
+        let node = Node(viewType: Dashboard.self)
+        let index = HitTestIndex()
+        var screen: VirtualScreen
+
+        init() throws {
+            terminal = try Terminal(headlessRows: 6, cols: 30)
+            canvas = TerminalCanvas(plane: terminal.standardPlane)
+            screen = VirtualScreen(matching: terminal)
+        }
+
+        // Draw a frame and return the groups it copied and redrew
+        func frame(_ view: Dashboard, width: Int = 30) -> DrawingGroupMetrics {
+            let control = ViewGraph.buildControl(from: view, node: node, isSameView: true)
+            control.size = control.sizeThatFits(.fixed(width: width, height: 6))
+            canvas.clear()
+            index.reset(rows: 6)
+            let context = RenderContext(canvas: canvas, hitTestIndex: index)
+            context.render(control: control)
+            context.finish()
+            index.finish()
+            _ = try? terminal.render()
+            screen.update(from: terminal)
+            return context.drawingGroupMetrics
+        }
+    }
+
+    private func metrics(hits: Int, misses: Int) -> DrawingGroupMetrics {
+        var metrics = DrawingGroupMetrics()
+        metrics.hits = hits
+        metrics.misses = misses
+        return metrics
+    }
+
+    @Test("A group is drawn once and copied until state inside it changes")
+    func stateInvalidates() throws {
+        let harness = try Harness()
+        let header = Handle()
+        let panel = Handle()
+        let view = Dashboard(header: header, panel: panel, onReset: {})
+
+        #expect(harness.frame(view) == metrics(hits: 0, misses: 1))
+        #expect(harness.screen.lines[0] == "header 0")
+        #expect(harness.screen.lines[1] == "panel 0")
+        #expect(harness.screen.lines[2] == "[ Reset ]")
+        #expect(harness.screen.lines[3] == "👨‍👩‍👧 family")
+        #expect(harness.screen[2, 0].foreground == RGBColor.cyan)
+
+        // State outside the group leaves its raster valid
+        header.bump()
+        #expect(harness.frame(view) == metrics(hits: 1, misses: 0))
+        #expect(harness.screen.lines[0] == "header 1")
+        #expect(harness.screen.lines[1] == "panel 0")
+        #expect(harness.screen.lines[3] == "👨‍👩‍👧 family")
+
+        panel.bump()
+        #expect(harness.frame(view) == metrics(hits: 0, misses: 1))
+        #expect(harness.screen.lines[1] == "panel 1")
+        #expect(harness.frame(view) == metrics(hits: 1, misses: 0))
+        #expect(harness.screen.lines[1] == "panel 1")
+    }
+
+    @Test("A different proposed size draws the group again")
+    func proposalInvalidates() throws {
+        let harness = try Harness()
+        let view = Dashboard(header: Handle(), panel: Handle(), onReset: {})
+        #expect(harness.frame(view) == metrics(hits: 0, misses: 1))
+        #expect(harness.frame(view, width: 20) == metrics(hits: 0, misses: 1))
+        #expect(harness.frame(view, width: 20) == metrics(hits: 1, misses: 0))
+        #expect(harness.screen.lines[2] == "[ Reset ]")
+    }
+
+    @Test("Buttons in a copied group are hit-tested where they land")
+    func hitTargets() throws {
+        let harness = try Harness()
+        var resets = 0
+        let view = Dashboard(header: Handle(), panel: Handle(), onReset: { resets += 1 })
+        _ = harness.frame(view)
+        #expect(harness.frame(view) == metrics(hits: 1, misses: 0))
+
+        #expect(harness.index.buttons.map(\.region) == [
+            HitTestIndex.Region(x: 0, y: 2, width: 9, height: 1),
+        ])
+        let button = try #require(harness.index.button(atRow: 2, column: 4))
+        harness.index.buttons[button].action()
+        #expect(resets == 1)
+    }
+
+    @Test("The application counts copied and redrawn groups")
+    func applicationMetrics() throws {
+        let terminal = try Terminal(headlessRows: 6, cols: 30)
+        let header = Handle()
+        let view = Dashboard(header: header, panel: Handle(), onReset: {})
+        let application = Application(maximumFramesPerSecond: 0)
+        var frames = 0
+        application.onFrame = { [unowned application] _ in
+            frames += 1
+            if frames < 3 {
+                header.bump()
+            } else {
+                application.stop()
+            }
+        }
+        application.run(view, on: terminal)
+        #expect(frames == 3)
+        #expect(application.drawingGroupMetrics == metrics(hits: 2, misses: 1))
+    }
+}
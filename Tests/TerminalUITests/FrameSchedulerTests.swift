@@ -0,0 +1,61 @@
+import Testing
+@testable import TerminalUI
+
+@Suite("Frame Scheduler Tests")
+struct FrameSchedulerTests {
+
+    @Test("First frame is due immediately")
+    func firstFrame() {
+        let scheduler = FrameScheduler(maximumFramesPerSecond: 60)
+        let now = ContinuousClock.now
+        #expect(scheduler.isFrameDue(at: now))
+        #expect(scheduler.inputTimeout(at: now) == 0)
+    }
+
+    @Test("Idle scheduler waits for input indefinitely")
+    func idle() {
+        var scheduler = FrameScheduler(maximumFramesPerSecond: 60)
+        let now = ContinuousClock.now
+        scheduler.beginFrame(at: now)
+        #expect(!scheduler.isFrameDue(at: now + .seconds(10)))
+        #expect(scheduler.inputTimeout(at: now) == -1)
+    }
+
+    @Test("Invalidations within one tick coalesce into one frame")
+    func coalescing() {
+        var scheduler = FrameScheduler(maximumFramesPerSecond: 50)
+        let start = ContinuousClock.now
+        scheduler.beginFrame(at: start)
+
+        for _ in 0..<100 {
+            scheduler.setNeedsFrame()
+        }
+        #expect(!scheduler.isFrameDue(at: start + .milliseconds(5)))
+        #expect(scheduler.inputTimeout(at: start + .milliseconds(5)) == 15)
+        #expect(scheduler.isFrameDue(at: start + .milliseconds(20)))
+
+        scheduler.beginFrame(at: start + .milliseconds(20))
+        #expect(!scheduler.needsFrame)
+        #expect(scheduler.inputTimeout(at: start + .milliseconds(21)) == -1)
+    }
+
+    @Test("Timeout rounds up to the frame deadline")
+    func roundingUp() {
+        var scheduler = FrameScheduler(maximumFramesPerSecond: 60)
+        let start = ContinuousClock.now
+        scheduler.beginFrame(at: start)
+        scheduler.setNeedsFrame()
+        // 16.67 ms interval: waiting 16 ms would wake just before the deadline
+        #expect(scheduler.inputTimeout(at: start) == 17)
+    }
+
+    @Test("Zero FPS renders every invalidation immediately")
+    func uncapped() {
+        var scheduler = FrameScheduler(maximumFramesPerSecond: 0)
+        let now = ContinuousClock.now
+        scheduler.beginFrame(at: now)
+        scheduler.setNeedsFrame()
+        #expect(scheduler.isFrameDue(at: now))
+        #expect(scheduler.inputTimeout(at: now) == 0)
+    }
+}
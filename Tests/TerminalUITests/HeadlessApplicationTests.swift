@@ -0,0 +1,157 @@
+import Testing
+import NotcursesSwift
+@testable import TerminalUI
+
+@Suite("Headless Application Tests")
+struct HeadlessApplicationTests {
+    struct Counter: View {
+        @State var count = 0
+        var body: some View {
+            VStack {
+                Text("Count \(count)")
+                Button("Inc") { count += 1 }
+            }
+        }
+    }
+
+    struct Pair: View {
+        @State var first = 0
+        @State var second = 0
+        var body: some View {
+            VStack {
+                Text("First \(first) Second \(second)")
+                Button("First") { first += 1 }
+                Button("Second") { second += 1 }
+            }
+        }
+    }
+
+    // Run `view` on a headless terminal over the injected keys, quitting
+    // after the frame that shows their effect, and return the final screen.
+    private func run<V: View>(_ view: V, pipelined: Bool = false, keys: KeyEvent...) throws -> (screen: VirtualScreen, application: Application, frames: Int) {
+        let terminal = try Terminal(headlessRows: 6, cols: 30)
+        var screen = VirtualScreen(matching: terminal)
+        for key in keys {
+            terminal.inject(key)
+        }
+        // Render every frame so the last input's frame is drawn before quitting
+        let application = Application(maximumFramesPerSecond: 0, pipelined: pipelined)
+        var frames = 0
+        application.onFrame = { [unowned application] _ in
+            frames += 1
+            screen.update(from: terminal)
+            if application.inputMetrics.eventsReceived == keys.count {
+                terminal.inject(.character("q"))
+            }
+        }
+        application.run(view, on: terminal)
+        #expect(frames > 0)
+        return (screen, application, frames)
+    }
+
+    @Test("The first frame is drawn")
+    func firstFrame() throws {
+        let screen = try run(Counter()).screen
+        #expect(screen.lines.contains { $0.contains("Count 0") })
+        #expect(screen.lines.contains { $0.contains("[ Inc ]") })
+    }
+
+    @Test("Pressing enter activates the focused button")
+    func buttonPress() throws {
+        let screen = try run(Counter(), keys: .enter, .enter).screen
+        #expect(screen.lines.contains { $0.contains("Count 2") })
+
+        let row = try #require(screen.lines.firstIndex { $0.contains("[ Inc ]") })
+        let column = try #require(Array(screen.lines[row]).firstIndex(of: "["))
+        #expect(screen[row, column].foreground == RGBColor.cyan)
+        #expect(screen[row, column].styles.contains(.bold))
+    }
+
+    @Test("Frames written by a render thread show the same screen")
+    func pipelined() throws {
+        let screen = try run(Counter(), pipelined: true, keys: .enter, .enter).screen
+        #expect(screen.lines.contains { $0.contains("Count 2") })
+        #expect(screen.lines.contains { $0.contains("[ Inc ]") })
+    }
+
+    @Test("Mouse reporting is on only while the application runs")
+    func mouseReporting() throws {
+        let terminal = try Terminal(headlessRows: 6, cols: 30)
+        #expect(terminal.mouseEvents.isEmpty)
+        for (focusesOnHover, expected) in [(false, [.buttons, .drags]), (true, [.buttons, .drags, .motion])] as [(Bool, MouseEvents)] {
+            let application = Application(maximumFramesPerSecond: 0, focusesOnHover: focusesOnHover)
+            var reported: MouseEvents = []
+            application.onFrame = { [unowned application] _ in
+                reported = terminal.mouseEvents
+                application.stop()
+            }
+            application.run(Counter(), on: terminal)
+            #expect(reported == expected)
+            #expect(terminal.mouseEvents.isEmpty)
+        }
+    }
+
+    @Test("Pending input is applied before one frame")
+    func coalescedInput() throws {
+        var keys = Array(repeating: KeyEvent.down, count: 10)
+        keys += Array(repeating: KeyEvent.up, count: 10)
+        let terminal = try Terminal(headlessRows: 6, cols: 30)
+        var screen = VirtualScreen(matching: terminal)
+        for key in keys + [.enter] {
+            terminal.inject(key)
+        }
+
+        let application = Application(maximumFramesPerSecond: 0)
+        var frames = 0
+        application.onFrame = { [unowned application] _ in
+            frames += 1
+            screen.update(from: terminal)
+            if application.inputMetrics.eventsReceived > 0 {
+                terminal.inject(.character("q"))
+            }
+        }
+        application.run(Counter(), on: terminal)
+
+        #expect(screen.lines.contains { $0.contains("Count 1") }, "Focus moves net to the first button")
+        #expect(frames == 2, "The initial frame and one for the whole batch")
+        let metrics = application.inputMetrics
+        #expect(metrics.eventsReceived == 22)
+        #expect(metrics.eventsMerged == 18)
+        #expect(metrics.batches == 2)
+    }
+
+    @Test("Up then Down on the first button moves focus to the second")
+    func focusEdge() throws {
+        let screen = try run(Pair(), keys: .up, .down, .enter).screen
+        #expect(screen.lines.contains { $0.contains("First 0 Second 1") })
+    }
+
+    @Test("Clicking a button activates it when released over it")
+    func click() throws {
+        let terminal = try Terminal(headlessRows: 6, cols: 30)
+        var screen = VirtualScreen(matching: terminal)
+        let application = Application(maximumFramesPerSecond: 0)
+        var frames = 0
+        application.onFrame = { _ in
+            frames += 1
+            screen.update(from: terminal)
+            guard frames == 1,
+                  let row = screen.lines.firstIndex(where: { $0.contains("[ Inc ]") }),
+                  let start = screen.lines[row].firstRange(of: "[ Inc ]")?.lowerBound else {
+                terminal.inject(.character("q"))
+                return
+            }
+            let column = screen.lines[row].distance(from: screen.lines[row].startIndex, to: start)
+            func mouse(_ action: MouseEvent.Action, _ button: MouseEvent.Button?, _ x: Int) -> KeyEvent {
+                .mouse(MouseEvent(action, button: button, row: row, column: x))
+            }
+            // Dragged off the button before release, then a real click
+            terminal.inject(mouse(.move, nil, column + 1),
+                            mouse(.press, .left, column + 1), mouse(.release, .left, 29),
+                            mouse(.press, .left, column + 3), mouse(.release, .left, column + 6))
+        }
+        application.run(Counter(), on: terminal)
+
+        #expect(screen.lines.contains { $0.contains("Count 1") })
+    }
+}
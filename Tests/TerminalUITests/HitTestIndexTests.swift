@@ -0,0 +1,97 @@
+import Testing
+import NotcursesSwift
+@testable import TerminalUI
+
+@Suite("Hit Test Index Tests")
+struct HitTestIndexTests {
+    @Test("Buttons are found by cell and kept in focus order")
+    func buttons() {
+        let index = HitTestIndex()
+        index.reset(rows: 10)
+        // Added out of left-to-right order, as a trailing-aligned stack might
+        index.addButton(at: Position(x: 20, y: 2), size: Size(width: 8, height: 1)) {}
+        index.addButton(at: Position(x: 0, y: 2), size: Size(width: 8, height: 1)) {}
+        index.addButton(at: Position(x: 10, y: 2), size: Size(width: 8, height: 2)) {}
+        index.finish()
+
+        #expect(index.buttons.count == 3)
+        #expect(index.button(atRow: 2, column: 0) == 1)
+        #expect(index.button(atRow: 2, column: 7) == 1)
+        #expect(index.button(atRow: 2, column: 8) == nil)
+        #expect(index.button(atRow: 2, column: 12) == 2)
+        #expect(index.button(atRow: 3, column: 12) == 2)
+        #expect(index.button(atRow: 2, column: 27) == 0)
+        #expect(index.button(atRow: 1, column: 12) == nil)
+        #expect(index.button(atRow: 20, column: 12) == nil)
+    }
+
+    @Test("Buttons off the screen keep their focus order but are not hit")
+    func offscreen() {
+        let index = HitTestIndex()
+        index.reset(rows: 4)
+        // Content overflowing below and scrolled above the screen
+        index.addButton(at: Position(x: 0, y: 6), size: Size(width: 8, height: 1)) {}
+        index.addButton(at: Position(x: 0, y: -3), size: Size(width: 8, height: 2)) {}
+        index.addButton(at: Position(x: 0, y: 3), size: Size(width: 8, height: 3)) {}
+        index.finish()
+
+        #expect(index.buttons.count == 3)
+        #expect(index.button(atRow: 3, column: 0) == 2)
+        #expect(index.button(atRow: 0, column: 0) == nil)
+    }
+
+    @Test("Overlapping buttons resolve to the one drawn last")
+    func overlap() {
+        let index = HitTestIndex()
+        index.reset(rows: 4)
+        index.addButton(at: Position(x: 0, y: 0), size: Size(width: 30, height: 1)) {}
+        index.addButton(at: Position(x: 5, y: 0), size: Size(width: 4, height: 1)) {}
+        index.finish()
+
+        #expect(index.button(atRow: 0, column: 6) == 1)
+        #expect(index.button(atRow: 0, column: 20) == 0, "Covered by the wide button starting further left")
+    }
+
+    @Test("Resetting forgets the last frame")
+    func reset() {
+        let index = HitTestIndex()
+        index.reset(rows: 4)
+        index.addButton(at: Position(x: 0, y: 0), size: Size(width: 4, height: 1)) {}
+        index.finish()
+        index.reset(rows: 4)
+        index.finish()
+
+        #expect(index.buttons.isEmpty)
+        #expect(index.button(atRow: 0, column: 0) == nil)
+    }
+
+    @Test("Drawing a frame indexes its buttons and lists")
+    func drawnFrame() throws {
+        let terminal = try Terminal(headlessRows: 10, cols: 40)
+        let canvas = TerminalCanvas(plane: terminal.standardPlane)
+        let view = VStack(alignment: .leading, spacing: 0) {
+            Button("One") {}
+            HStack(spacing: 1) {
+                Text("x")
+                Button("Two") {}
+            }
+            List(0..<20) { Text("Row \($0)") }
+        }
+        let control = ViewGraph.buildControl(from: view, node: Node(viewType: type(of: view)))
+        control.size = control.sizeThatFits(.fixed(width: 40, height: 10))
+
+        let index = HitTestIndex()
+        index.reset(rows: 10)
+        RenderContext(canvas: canvas, hitTestIndex: index).render(control: control)
+        index.finish()
+
+        #expect(index.buttons.map(\.region) == [
+            HitTestIndex.Region(x: 0, y: 0, width: 7, height: 1),
+            HitTestIndex.Region(x: 2, y: 1, width: 7, height: 1),
+        ])
+        #expect(index.button(atRow: 1, column: 2) == 1)
+        #expect(index.button(atRow: 1, column: 0) == nil)
+        #expect(index.list(atRow: 5, column: 0) != nil)
+        #expect(index.list(atRow: 0, column: 0) == nil)
+    }
+}
@@ -0,0 +1,87 @@
+import Testing
+import NotcursesSwift
+@testable import TerminalUI
+
+@Suite("Input Coalescer Tests")
+struct InputCoalescerTests {
+    private func events(_ keys: KeyEvent...) -> [InputEvent] {
+        keys.map { InputEvent(key: $0) }
+    }
+
+    @Test("Runs of navigation in one direction merge into their net effect")
+    func navigation() {
+        var metrics = InputMetrics()
+        let commands = InputCoalescer.commands(
+            for: events(.down, .down, .down, .up, .enter, .pageDown, .pageDown, .pageUp),
+            metrics: &metrics)
+        #expect(commands == [.moveFocus(3), .moveFocus(-1), .activate, .scroll(pages: 2), .scroll(pages: -1)])
+        #expect(metrics.eventsReceived == 8)
+        #expect(metrics.eventsMerged == 3)
+        #expect(metrics.eventsDropped == 0)
+    }
+
+    @Test("Steps that turn back at an edge are kept apart")
+    func edges() {
+        // From the first button or the top of a list, Up then Down moves one
+        // step: the Up is clamped away, which a merged step of 0 would lose
+        var metrics = InputMetrics()
+        let commands = InputCoalescer.commands(for: events(.up, .up, .down, .pageUp, .pageDown),
+                                               metrics: &metrics)
+        #expect(commands == [.moveFocus(-2), .moveFocus(1), .scroll(pages: -1), .scroll(pages: 1)])
+        #expect(metrics.eventsMerged == 1)
+    }
+
+    @Test("Jumping to an end overrides the scrolling before it")
+    func jumps() {
+        var metrics = InputMetrics()
+        let commands = InputCoalescer.commands(for: events(.pageDown, .pageDown, .end, .home, .pageDown),
+                                               metrics: &metrics)
+        #expect(commands == [.scrollToTop, .scroll(pages: 1)])
+        #expect(metrics.eventsMerged == 3)
+    }
+
+    @Test("Repeated resizes and input after quitting are dropped")
+    func dropped() {
+        var metrics = InputMetrics()
+        let commands = InputCoalescer.commands(for: events(.resize, .down, .resize, .resize, .escape, .enter, .up),
+                                               metrics: &metrics)
+        #expect(commands == [.resize, .moveFocus(1), .quit])
+        #expect(metrics.eventsDropped == 4)
+    }
+
+    @Test("Queue depth is tracked per batch")
+    func queueDepth() {
+        var metrics = InputMetrics()
+        _ = InputCoalescer.commands(for: events(.down, .down, .down), metrics: &metrics)
+        _ = InputCoalescer.commands(for: events(.up), metrics: &metrics)
+        #expect(metrics.batches == 2)
+        #expect(metrics.lastQueueDepth == 1)
+        #expect(metrics.maximumQueueDepth == 3)
+    }
+
+    @Test("Pointer movement keeps the last cell and wheel steps over one cell add up")
+    func mouse() {
+        func mouse(_ action: MouseEvent.Action, _ button: MouseEvent.Button? = nil, x: Int) -> KeyEvent {
+            .mouse(MouseEvent(action, button: button, row: 1, column: x))
+        }
+        var metrics = InputMetrics()
+        let commands = InputCoalescer.commands(
+            for: events(mouse(.move, x: 1), mouse(.move, x: 2), mouse(.move, x: 3),
+                        mouse(.press, .left, x: 3), mouse(.release, .left, x: 3),
+                        mouse(.press, .scrollDown, x: 4), mouse(.press, .scrollDown, x: 4),
+                        mouse(.press, .scrollDown, x: 5), mouse(.press, .scrollUp, x: 5),
+                        mouse(.release, .right, x: 5)),
+            metrics: &metrics)
+        // Steps over another cell may scroll another list, and steps back
+        // up may be clamped at the top
+        #expect(commands == [
+            .point(Position(x: 3, y: 1)),
+            .press(Position(x: 3, y: 1)),
+            .release(Position(x: 3, y: 1)),
+            .wheel(2, at: Position(x: 4, y: 1)),
+            .wheel(1, at: Position(x: 5, y: 1)),
+            .wheel(-1, at: Position(x: 5, y: 1)),
+        ])
+        #expect(metrics.eventsMerged == 3)
+    }
+}
@@ -0,0 +1,54 @@
+import Testing
+@testable import TerminalUI
+
+@Suite("Layout Benchmarks")
+struct LayoutBenchmarkTests {
+
+    /// Alternating VStack/HStack nesting `depth` levels deep; each level holds
+    /// a text leaf next to the next level. Returns the root and deepest leaf.
+    private func makeNestedStacks(depth: Int) -> (root: Control, leaf: Control) {
+        let root = Control()
+        var current = root
+        var leaf = root
+        for level in 0..<depth {
+            current.kind = level % 2 == 0
+                ? .vstack(alignment: .leading, spacing: 0)
+                : .hstack(alignment: .top, spacing: 1)
+            leaf = Control()
+            leaf.kind = .text(content: "level \(level)", foregroundColor: nil, isBold: false, isItalic: false)
+            current.addChild(leaf)
+            let next = Control()
+            current.addChild(next)
+            current = next
+        }
+        current.kind = .text(content: "bottom", foregroundColor: nil, isBold: false, isItalic: false)
+        return (root, leaf)
+    }
+
+    private func totalLayoutCount(_ control: Control) -> Int {
+        control.children.reduce(control.layoutCount) { $0 + totalLayoutCount($1) }
+    }
+
+    @Test("Nested stack layout is linear and re-layout touches one path")
+    func nestedStacks() {
+        let clock = ContinuousClock()
+        let proposed = ProposedSize.fixed(width: 200, height: 60)
+
+        for depth in [100, 200, 400] {
+            let (root, leaf) = makeNestedStacks(depth: depth)
+            let controls = 2 * depth + 1
+
+            let cold = clock.measure { _ = root.sizeThatFits(proposed) }
+            #expect(totalLayoutCount(root) == controls, "Every control is measured once")
+
+            let cached = clock.measure { _ = root.sizeThatFits(proposed) }
+            #expect(totalLayoutCount(root) == controls, "An unchanged tree is answered from the cache")
+
+            leaf.kind = .text(content: "changed", foregroundColor: nil, isBold: false, isItalic: false)
+            let path = clock.measure { _ = root.sizeThatFits(proposed) }
+            #expect(totalLayoutCount(root) == controls + depth + 1, "Only the leaf and its ancestors are recomputed")
+
+            print("Layout depth \(depth) (\(controls) controls): cold \(cold), cached \(cached), one leaf changed \(path)")
+        }
+    }
+}
@@ -0,0 +1,79 @@
+import Testing
+@testable import TerminalUI
+
+@Suite("List Tests")
+struct ListTests {
+
+    private func rowTexts(_ control: Control) -> [String] {
+        control.children.compactMap { row in
+            if case .text(let content, _, _, _) = row.kind { return content }
+            return nil
+        }
+    }
+
+    private func listContent(_ control: Control) -> ListContent? {
+        if case .list(let content) = control.kind { return content }
+        return nil
+    }
+
+    @Test("Only rows inside the viewport are built")
+    func visibleRowsOnly() {
+        final class Counter { var rows = 0 }
+        let built = Counter()
+        let list = List(0..<100_000) { index -> Text in
+            built.rows += 1
+            return Text("Row \(index)")
+        }
+        let node = Node(viewType: type(of: list))
+        let control = ViewGraph.buildControl(from: list, node: node)
+        #expect(built.rows == 0, "Rows are built during layout")
+
+        let size = control.sizeThatFits(.fixed(width: 40, height: 10))
+        #expect(built.rows == 10)
+        #expect(control.children.count == 10)
+        #expect(rowTexts(control).first == "Row 0")
+        #expect(size.height == 10)
+    }
+
+    @Test("Paging recycles row controls")
+    func paging() {
+        let list = List(0..<1_000) { Text("Row \($0)") }
+        let node = Node(viewType: type(of: list))
+        let proposed = ProposedSize.fixed(width: 40, height: 5)
+        let control = ViewGraph.buildControl(from: list, node: node)
+        _ = control.sizeThatFits(proposed)
+        let firstPage = Set(control.children.map(ObjectIdentifier.init))
+
+        listContent(control)?.scroll(pages: 1)
+        _ = control.sizeThatFits(proposed)
+        #expect(rowTexts(control) == ["Row 5", "Row 6", "Row 7", "Row 8", "Row 9"])
+        #expect(Set(control.children.map(ObjectIdentifier.init)) == firstPage)
+
+        listContent(control)?.scrollToBottom()
+        _ = control.sizeThatFits(proposed)
+        #expect(rowTexts(control).last == "Row 999")
+        #expect(control.children.count == 5)
+
+        listContent(control)?.scroll(pages: 1)
+        #expect(listContent(control)?.firstVisibleRow == 995, "Scrolling stops at the end")
+
+        listContent(control)?.scrollToTop()
+        _ = control.sizeThatFits(proposed)
+        #expect(rowTexts(control).first == "Row 0")
+    }
+
+    @Test("Scroll position survives a rebuild with new data")
+    func rebuildKeepsScroll() {
+        let node = Node(viewType: List<[String], Text>.self)
+        let proposed = ProposedSize.fixed(width: 40, height: 3)
+        var lines = (0..<10).map { "Line \($0)" }
+        var control = ViewGraph.buildControl(from: List(lines) { Text($0) }, node: node)
+        _ = control.sizeThatFits(proposed)
+        listContent(control)?.scroll(pages: 1)
+
+        lines.append("Line 10")
+        control = ViewGraph.buildControl(from: List(lines) { Text($0) }, node: node)
+        _ = control.sizeThatFits(proposed)
+        #expect(rowTexts(control) == ["Line 3", "Line 4", "Line 5"])
+    }
+}
@@ -1,3 +1,4 @@
+import Foundation
 import Testing
 @testable import TerminalUI
 
@@ -43,4 +44,69 @@ struct StateTests {
         let binding: Binding<Int> = $count
         #expect(binding.wrappedValue == 10)
     }
+
+    @Test("State written from many threads is queued for the run loop")
+    func concurrentWrites() {
+        struct Meter: View {
+            @State var reading = 0
+            var body: some View {
+                Text("Reading \(reading)")
+            }
+        }
+        let threads = 8
+        let writes = 10_000
+        let application = Application()
+        let meters = (0..<threads).map { _ in Meter() }
+        let nodes = meters.map { meter -> Node in
+            let node = Node(viewType: Meter.self)
+            node.application = application
+            _ = ViewGraph.buildControl(from: meter, node: node)
+            return node
+        }
+
+        // Each thread writes its own meter and reads its neighbour's
+        DispatchQueue.concurrentPerform(iterations: threads) { i in
+            for n in 1...writes {
+                meters[i].reading = n
+                _ = meters[(i + 1) % threads].reading
+            }
+        }
+        #expect(nodes.allSatisfy { !$0.needsUpdate }, "Nodes are only marked by the run loop")
+
+        application.processInvalidations()
+        for (meter, node) in zip(meters, nodes) {
+            #expect(node.needsUpdate)
+            #expect(meter.reading == writes)
+            let control = ViewGraph.buildControl(from: meter, node: node)
+            if case .text(let content, _, _, _) = control.children[0].kind {
+                #expect(content == "Reading \(writes)")
+            } else {
+                Issue.record("Expected .text control, got \(control.children[0].kind)")
+            }
+        }
+    }
+
+    @Test("State invalidates through the application captured when it was installed")
+    func capturedApplication() {
+        struct Meter: View {
+            @State var reading = 0
+            var body: some View {
+                Text("Reading \(reading)")
+            }
+        }
+        let application = Application()
+        let meter = Meter()
+        let node = Node(viewType: Meter.self)
+        node.application = application
+        _ = ViewGraph.buildControl(from: meter, node: node)
+
+        // Writers never look at the node, which only the build thread owns
+        node.application = nil
+        DispatchQueue.concurrentPerform(iterations: 4) { i in
+            meter.reading = i + 1
+        }
+        #expect(!node.needsUpdate)
+        application.processInvalidations()
+        #expect(node.needsUpdate)
+    }
 }
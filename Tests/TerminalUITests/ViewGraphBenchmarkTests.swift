@@ -0,0 +1,214 @@
+import Testing
+@testable import TerminalUI
+
+// A 10,000-Text tree: 10 pages x 10 blocks x 10 rows x 10 texts, plus the
+// stacks and composite views around them.
+
+private struct BenchRow: View {
+    let row: Int
+    var body: some View {
+        HStack(spacing: 1) {
+            Text("0")
+            Text("1")
+            Text("2")
+            Text("3")
+            Text("4")
+            Text("5")
+            Text("6")
+            Text("7")
+            Text("8")
+            Text("9")
+        }
+    }
+}
+
+private struct BenchBlock: View {
+    let block: Int
+    var body: some View {
+        VStack(alignment: .leading, spacing: 0) {
+            BenchRow(row: block * 10 + 0)
+            BenchRow(row: block * 10 + 1)
+            BenchRow(row: block * 10 + 2)
+            BenchRow(row: block * 10 + 3)
+            BenchRow(row: block * 10 + 4)
+            BenchRow(row: block * 10 + 5)
+            BenchRow(row: block * 10 + 6)
+            BenchRow(row: block * 10 + 7)
+            BenchRow(row: block * 10 + 8)
+            BenchRow(row: block * 10 + 9)
+        }
+    }
+}
+
+private struct BenchPage: View {
+    let page: Int
+    var body: some View {
+        VStack(spacing: 0) {
+            BenchBlock(block: page * 10 + 0)
+            BenchBlock(block: page * 10 + 1)
+            BenchBlock(block: page * 10 + 2)
+            BenchBlock(block: page * 10 + 3)
+            BenchBlock(block: page * 10 + 4)
+            BenchBlock(block: page * 10 + 5)
+            BenchBlock(block: page * 10 + 6)
+            BenchBlock(block: page * 10 + 7)
+            BenchBlock(block: page * 10 + 8)
+            BenchBlock(block: page * 10 + 9)
+        }
+        .padding(1)
+    }
+}
+
+private struct BenchScreen: View {
+    var body: some View {
+        VStack(spacing: 0) {
+            BenchPage(page: 0)
+            BenchPage(page: 1)
+            BenchPage(page: 2)
+            BenchPage(page: 3)
+            BenchPage(page: 4)
+            BenchPage(page: 5)
+            BenchPage(page: 6)
+            BenchPage(page: 7)
+            BenchPage(page: 8)
+            BenchPage(page: 9)
+        }
+    }
+}
+
+// The reflection-based dispatch ViewGraph used before `_makeView`, kept as
+// the baseline the benchmark compares against. It classifies each view by
+// casting and by its type name, reads stack and modifier fields and tuple
+// elements through Mirror, and reflects over every view for dynamic
+// properties. Covers the views the benchmark tree uses.
+private enum ReflectionBuilder {
+    static func buildControl<V: View>(from view: V, node: Node) -> Control {
+        let control = node.control ?? Control()
+        control.reset()
+        control.node = node
+        node.control = control
+        node.view = view
+        node.beginReconcile()
+        defer { node.endReconcile() }
+
+        var mutableView = view
+        installDynamicProperties(&mutableView, on: node)
+
+        if let text = mutableView as? Text {
+            control.kind = .text(content: text.content, foregroundColor: text._foregroundColor,
+                                 isBold: text._bold, isItalic: text._italic)
+            return control
+        }
+
+        let typeName = String(describing: type(of: mutableView))
+        let mirror = Mirror(reflecting: mutableView)
+        if typeName.hasPrefix("VStack") {
+            let alignment = mirror.descendant("alignment") as? HorizontalAlignment ?? .center
+            let spacing = mirror.descendant("spacing") as? CGFloat?
+            control.kind = .vstack(alignment: alignment, spacing: spacing ?? nil)
+            if let content = mirror.descendant("content") {
+                buildChildren(from: content, into: control, node: node)
+            }
+        } else if typeName.hasPrefix("HStack") {
+            let alignment = mirror.descendant("alignment") as? VerticalAlignment ?? .center
+            let spacing = mirror.descendant("spacing") as? CGFloat?
+            control.kind = .hstack(alignment: alignment, spacing: spacing ?? nil)
+            if let content = mirror.descendant("content") {
+                buildChildren(from: content, into: control, node: node)
+            }
+        } else if typeName.hasPrefix("ModifiedContent") {
+            control.kind = .container
+            if let modifier = mirror.descendant("modifier"),
+               String(describing: type(of: modifier)) == "PaddingModifier" {
+                let modifierMirror = Mirror(reflecting: modifier)
+                let edges = modifierMirror.descendant("edges") as? Edge.Set ?? .all
+                let length = modifierMirror.descendant("length") as? CGFloat?
+                control.kind = .padding(edges: edges, length: length ?? nil)
+            }
+            if let content = mirror.descendant("content") {
+                buildChildren(from: content, into: control, node: node)
+            }
+        } else {
+            let childNode = node.reconcileChild(viewType: V.Body.self)
+            control.addChild(buildControl(from: mutableView.body, node: childNode))
+            control.kind = .container
+        }
+        return control
+    }
+
+    private static func buildChildren(from content: Any, into control: Control, node: Node) {
+        if String(describing: type(of: content)).hasPrefix("TupleView") {
+            if let value = Mirror(reflecting: content).descendant("value") {
+                for child in Mirror(reflecting: value).children {
+                    buildChildren(from: child.value, into: control, node: node)
+                }
+            }
+            return
+        }
+        if let view = content as? any View {
+            control.addChild(openAndBuild(view, parent: node))
+        }
+    }
+
+    private static func openAndBuild<V: View>(_ view: V, parent: Node) -> Control {
+        buildControl(from: view, node: parent.reconcileChild(viewType: V.self))
+    }
+
+    private static func installDynamicProperties<V: View>(_ view: inout V, on node: Node) {
+        for child in Mirror(reflecting: view).children {
+            if var state = child.value as? (any DynamicProperty) {
+                state.update()
+            }
+            if let stateInstallable = child.value as? any StateInstallable {
+                stateInstallable.install(on: node)
+            }
+        }
+    }
+}
+
+@Suite("ViewGraph Benchmarks")
+struct ViewGraphBenchmarkTests {
+
+    private func countTexts(in control: Control) -> Int {
+        var count = 0
+        if case .text = control.kind { count += 1 }
+        for child in control.children {
+            count += countTexts(in: child)
+        }
+        return count
+    }
+
+    @Test("Build a 10k-view tree")
+    func buildLargeTree() {
+        let clock = ContinuousClock()
+        let iterations = 5
+        var reflected = Duration.zero
+        var cold = Duration.zero
+        var reconciled = Duration.zero
+        var baseline: Control?
+        var control: Control?
+
+        for _ in 0..<iterations {
+            let baselineNode = Node(viewType: BenchScreen.self)
+            reflected += clock.measure {
+                baseline = ReflectionBuilder.buildControl(from: BenchScreen(), node: baselineNode)
+            }
+            let node = Node(viewType: BenchScreen.self)
+            cold += clock.measure {
+                control = ViewGraph.buildControl(from: BenchScreen(), node: node)
+            }
+            reconciled += clock.measure {
+                control = ViewGraph.buildControl(from: BenchScreen(), node: node)
+            }
+        }
+
+        // Before and after come from the same run, so the line can be
+        // recorded as is and compared across machines and builds
+        let speedup = (reflected / cold * 10).rounded() / 10
+        print("ViewGraph 10k views: reflection build \(reflected / iterations), "
+              + "build \(cold / iterations), rebuild unchanged \(reconciled / iterations), "
+              + "speedup \(speedup)x")
+        #expect(baseline.map { countTexts(in: $0) } == 10_000)
+        #expect(control.map { countTexts(in: $0) } == 10_000)
+    }
+}
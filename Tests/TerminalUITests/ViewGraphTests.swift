@@ -198,4 +198,181 @@ struct ViewGraphTests {
         #expect(size.width == 3, "VStack width = max child width")
         #expect(size.height == 2, "VStack height = sum of children (no spacing)")
     }
+
+    @Test("Rebuilding an unchanged view reuses its controls")
+    func reuseUnchanged() {
+        let view = VStack {
+            Text("A")
+            Text("B")
+        }
+        let node = Node(viewType: type(of: view))
+        let first = ViewGraph.buildControl(from: view, node: node)
+        let children = first.children
+        let second = ViewGraph.buildControl(from: view, node: node)
+        #expect(second === first)
+        #expect(second.children.count == 2)
+        #expect(second.children[0] === children[0])
+        #expect(second.children[1] === children[1])
+    }
+
+    @Test("Equatable views are compared with ==")
+    func equatableReuse() {
+        struct Label: View, Equatable {
+            let text: String
+            let revision: Int
+            static func == (lhs: Label, rhs: Label) -> Bool { lhs.text == rhs.text }
+            var body: some View { Text(text) }
+        }
+        let node = Node(viewType: Label.self)
+        _ = ViewGraph.buildControl(from: Label(text: "A", revision: 1), node: node)
+        _ = ViewGraph.buildControl(from: Label(text: "A", revision: 2), node: node)
+        #expect((node.view as? Label)?.revision == 1, "Equal by ==, so not rebuilt")
+        _ = ViewGraph.buildControl(from: Label(text: "B", revision: 3), node: node)
+        #expect((node.view as? Label)?.revision == 3)
+    }
+
+    @Test("Plain data views are compared by bytes, others are rebuilt")
+    func bytewiseReuse() {
+        let gaugeNode = Node(viewType: Gauge.self)
+        Gauge.evaluations = 0
+        _ = ViewGraph.buildControl(from: Gauge(value: 7), node: gaugeNode)
+        _ = ViewGraph.buildControl(from: Gauge(value: 7), node: gaugeNode)
+        #expect(Gauge.evaluations == 1)
+        _ = ViewGraph.buildControl(from: Gauge(value: 8), node: gaugeNode)
+        #expect(Gauge.evaluations == 2)
+
+        // Same reference, same bytes, but the object changed
+        let model = TitleModel()
+        let node = Node(viewType: Title.self)
+        let control = ViewGraph.buildControl(from: Title(model: model), node: node)
+        model.title = "B"
+        _ = ViewGraph.buildControl(from: Title(model: model), node: node)
+        if case .text(let content, _, _, _) = control.children[0].kind {
+            #expect(content == "B")
+        } else {
+            Issue.record("Expected .text control, got \(control.children[0].kind)")
+        }
+    }
+
+    @Test("Invalidated state rebuilds only its own subtree")
+    func rebuildInvalidatedSubtree() {
+        struct Counter: View {
+            @State var count = 0
+            var body: some View {
+                Text("Count \(count)")
+            }
+        }
+        struct Screen: View {
+            let counter: Counter
+            var body: some View {
+                VStack {
+                    Text("Header")
+                    counter
+                }
+            }
+        }
+        let screen = Screen(counter: Counter())
+        let node = Node(viewType: Screen.self)
+        let root = ViewGraph.buildControl(from: screen, node: node)
+        let stack = root.children[0]
+        let header = stack.children[0]
+
+        screen.counter.count = 1
+        #expect(node.hasDirtyDescendant)
+
+        let rebuilt = ViewGraph.buildControl(from: screen, node: node)
+        #expect(rebuilt === root)
+        #expect(rebuilt.children[0] === stack)
+        #expect(stack.children[0] === header)
+        if case .text(let content, _, _, _) = stack.children[1].children[0].kind {
+            #expect(content == "Count 1")
+        } else {
+            Issue.record("Expected .text control, got \(stack.children[1].children[0].kind)")
+        }
+        #expect(!node.hasDirtyDescendant)
+    }
+
+    @Test("Re-layout recomputes only the invalidated path")
+    func cachedLayout() {
+        struct Counter: View {
+            @State var count = 0
+            var body: some View {
+                Text("Count \(count)")
+            }
+        }
+        struct Screen: View {
+            let counter: Counter
+            var body: some View {
+                VStack(spacing: 0) {
+                    Text("Header")
+                    counter
+                }
+            }
+        }
+        let screen = Screen(counter: Counter())
+        let node = Node(viewType: Screen.self)
+        let proposed = ProposedSize.fixed(width: 80, height: 24)
+        let root = ViewGraph.buildControl(from: screen, node: node)
+        _ = root.sizeThatFits(proposed)
+        let stack = root.children[0]
+        let header = stack.children[0]
+        #expect(root.layoutCount == 1)
+        #expect(header.layoutCount == 1)
+
+        _ = root.sizeThatFits(proposed)
+        #expect(root.layoutCount == 1, "Same proposal answers from the cache")
+
+        screen.counter.count = 1
+        _ = ViewGraph.buildControl(from: screen, node: node)
+        let size = root.sizeThatFits(proposed)
+        #expect(root.layoutCount == 2)
+        #expect(stack.layoutCount == 2)
+        #expect(header.layoutCount == 1, "Unchanged sibling keeps its layout")
+        #expect(stack.size.width == 7)
+        #expect(size == Size(width: 80, height: 24))
+
+        _ = root.sizeThatFits(.fixed(width: 40, height: 10))
+        #expect(header.layoutCount == 2, "A new proposal reaches every child")
+    }
+
+    @Test("Children are matched by position and view type")
+    func reconcileByType() {
+        let before = VStack {
+            Text("A")
+            Spacer()
+        }
+        let node = Node(viewType: type(of: before))
+        _ = ViewGraph.buildControl(from: before, node: node)
+        let text = node.children[0]
+        let spacer = node.children[1]
+
+        let after = VStack {
+            Text("B")
+            Text("C")
+        }
+        _ = ViewGraph.buildControl(from: after, node: node)
+        #expect(node.children.count == 2)
+        #expect(node.children[0] === text)
+        #expect(node.children[1] !== spacer)
+    }
+}
+
+private struct Gauge: View {
+    static var evaluations = 0
+    let value: Int
+    var body: some View {
+        Gauge.evaluations += 1
+        return Text("\(value)")
+    }
+}
+
+private final class TitleModel {
+    var title = "A"
+}
+
+private struct Title: View {
+    let model: TitleModel
+    var body: some View {
+        Text(model.title)
+    }
 }
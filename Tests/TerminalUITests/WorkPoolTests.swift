@@ -0,0 +1,92 @@
+import Testing
+@testable import TerminalUI
+
+@Suite("Work Pool Tests")
+struct WorkPoolTests {
+    @Test("Every index of nested loops runs exactly once")
+    func nestedLoops() {
+        let pool = WorkPool(threads: 4)
+        let counts = UnsafeMutableBufferPointer<Int>.allocate(capacity: 64 * 64)
+        counts.initialize(repeating: 0)
+        defer { counts.deallocate() }
+
+        pool.run {
+            WorkPool.forEach(64, weight: { _ in 64 }) { i in
+                WorkPool.forEach(64, weight: { _ in 16 }) { j in
+                    counts[i * 64 + j] += 1
+                }
+            }
+        }
+        #expect(counts.allSatisfy { $0 == 1 })
+    }
+
+    @Test("Loops run on the calling thread outside a pool or when small")
+    func sequentialFallback() {
+        #expect(WorkPool.current == nil)
+        var order: [Int] = []
+        WorkPool.forEach(5, weight: { _ in 1000 }) { order.append($0) }
+        #expect(order == [0, 1, 2, 3, 4])
+
+        let pool = WorkPool(threads: 2)
+        pool.run {
+            #expect(WorkPool.current === pool)
+            order.removeAll()
+            WorkPool.forEach(5, weight: { _ in 1 }) { order.append($0) }
+        }
+        #expect(order == [0, 1, 2, 3, 4])
+        #expect(WorkPool.current == nil)
+    }
+
+    // Eight subtrees per level down to text leaves
+    private struct Fan: View {
+        let level: Int
+        let base: Int
+        let tick: Int
+
+        var body: some View {
+            if level == 0 {
+                Text("\(base + tick)")
+            } else {
+                HStack(spacing: 0) {
+                    AnyView(Fan(level: level - 1, base: base * 8, tick: tick))
+                    AnyView(Fan(level: level - 1, base: base * 8 + 1, tick: tick))
+                    AnyView(Fan(level: level - 1, base: base * 8 + 2, tick: tick))
+                    AnyView(Fan(level: level - 1, base: base * 8 + 3, tick: tick))
+                    AnyView(Fan(level: level - 1, base: base * 8 + 4, tick: tick))
+                    AnyView(Fan(level: level - 1, base: base * 8 + 5, tick: tick))
+                    AnyView(Fan(level: level - 1, base: base * 8 + 6, tick: tick))
+                    AnyView(Fan(level: level - 1, base: base * 8 + 7, tick: tick))
+                }
+            }
+        }
+    }
+
+    // Build and lay out two frames of the tree and flatten the second
+    private func frame(on pool: WorkPool?) -> (texts: [String], positions: [Position]) {
+        let node = Node(viewType: Fan.self)
+        let proposed = ProposedSize.fixed(width: 20_000, height: 10)
+        let arena = ControlArena()
+        for tick in 0 ..< 2 {
+            let build = {
+                let control = ViewGraph.buildControl(from: Fan(level: 4, base: 0, tick: tick), node: node)
+                control.size = control.sizeThatFits(proposed)
+                arena.build(from: control)
+            }
+            if let pool { pool.run(build) } else { build() }
+        }
+        return ((0 ..< arena.count).map { arena.text(of: $0) }, arena.positions)
+    }
+
+    @Test("Parallel build and layout give the same frame as sequential")
+    func deterministic() {
+        let sequential = frame(on: nil)
+        #expect(sequential.texts.filter { !$0.isEmpty }.count == 4096)
+
+        let pool = WorkPool(threads: 4)
+        for _ in 0 ..< 3 {
+            let parallel = frame(on: pool)
+            #expect(parallel.texts == sequential.texts)
+            #expect(parallel.positions == sequential.positions)
+        }
+    }
+}